@@ -5,11 +5,13 @@ import importlib.metadata
 
 from ._core.matrix import Matrix
 from ._core.dataframe import DataFrame
-from ._core.io import read_csv
+from ._core.sparse import SparseMatrix
+from ._core.io import read_csv, read_csv_matrix, CsvReader, read_dcol, DcolFile, load_npy, save_npy, load_npz, save_npz, read_libsvm, save_libsvm
+from ._core.sketches import KLLSketch, HyperLogLog
 
 from .daedalus_cpp import SimplexSolver, SolutionStatus, OptimizationResult
 
-__all__ = ['Matrix', 'DataFrame', 'read_csv']
+__all__ = ['Matrix', 'DataFrame', 'SparseMatrix', 'read_csv', 'read_csv_matrix', 'CsvReader', 'read_dcol', 'DcolFile', 'load_npy', 'save_npy', 'load_npz', 'save_npz', 'read_libsvm', 'save_libsvm', 'KLLSketch', 'HyperLogLog']
 
 if f"{__name__}._core" in sys.modules:
     del sys.modules[f"{__name__}._core"]
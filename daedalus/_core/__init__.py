@@ -2,6 +2,8 @@
 
 from .matrix import Matrix
 from .dataframe import DataFrame
-from .io import read_csv
+from .sparse import SparseMatrix
+from .io import read_csv, read_csv_matrix, CsvReader, read_dcol, DcolFile, load_npy, save_npy, load_npz, save_npz, read_libsvm, save_libsvm
+from .sketches import KLLSketch, HyperLogLog
 
-__all__ = ['Matrix', 'DataFrame', 'read_csv']
\ No newline at end of file
+__all__ = ['Matrix', 'DataFrame', 'SparseMatrix', 'read_csv', 'read_csv_matrix', 'CsvReader', 'read_dcol', 'DcolFile', 'load_npy', 'save_npy', 'load_npz', 'save_npz', 'read_libsvm', 'save_libsvm', 'KLLSketch', 'HyperLogLog']
\ No newline at end of file
@@ -1,6 +1,7 @@
 from __future__ import annotations
 import typing
 from ..daedalus_cpp import DataFrame as _DataFrameCpp
+from .sketches import KLLSketch, HyperLogLog
 
 class DataFrame:
     """
@@ -219,6 +220,205 @@ class DataFrame:
         result._obj = self._obj.to_matrix(target_columns)
         return result
 
+    def dtype(self, col_name: str) -> str:
+        """
+        Returns the storage type of a column.
+
+        Args:
+            col_name (str): The name of the column.
+
+        Returns:
+            One of "float64", "int32", "int64", "bool", "string", "category" or "mixed".
+
+        Raises:
+            ValueError: If the column name does not exist.
+        """
+        return self._obj.dtype(col_name)
+
+    def null_count(self, col_name: str) -> int:
+        """
+        Returns the number of null (missing) values in a column.
+
+        Null values are returned as NaN by at(), indexing and iteration.
+
+        Args:
+            col_name (str): The name of the column.
+
+        Raises:
+            ValueError: If the column name does not exist.
+        """
+        return self._obj.null_count(col_name)
+
+    def quantile_sketch(self, col_name: str, k: int = 200) -> KLLSketch:
+        """
+        Builds a mergeable KLL quantile sketch of a numeric column in one parallel pass.
+
+        Args:
+            col_name (str): The column to summarise.
+            k (int): Accuracy parameter (rank error is roughly 1.65 / k).
+
+        Returns:
+            A KLLSketch summarising the column.
+
+        Raises:
+            ValueError: If the column does not exist or holds only strings.
+
+        Example:
+            >>> df.quantile_sketch("price").quantile([0.25, 0.5, 0.75])
+        """
+        return KLLSketch._from_cpp(self._obj.quantile_sketch(col_name, k))
+
+    def distinct_sketch(self, col_name: str, precision: int = 14) -> HyperLogLog:
+        """
+        Builds a mergeable HyperLogLog distinct-count sketch of a column in one parallel pass.
+
+        Args:
+            col_name (str): The column to summarise.
+            precision (int): Precision of the sketch (4 to 18).
+
+        Returns:
+            A HyperLogLog sketch summarising the column.
+
+        Raises:
+            ValueError: If the column does not exist.
+
+        Example:
+            >>> df.distinct_sketch("user_id").estimate()
+        """
+        return HyperLogLog._from_cpp(self._obj.distinct_sketch(col_name, precision))
+
+    def unique(self, col_name: str) -> list[float | int | str]:
+        """
+        Returns the distinct values of a column in order of first appearance.
+
+        Args:
+            col_name (str): The column to deduplicate.
+
+        Returns:
+            A list of the distinct values.
+
+        Raises:
+            ValueError: If the column does not exist.
+
+        Example:
+            >>> df.unique("city")
+            ['Paris', 'Lyon', 'Nice']
+        """
+        return self._obj.unique(col_name)
+
+    def value_counts(self, col_name: str) -> DataFrame:
+        """
+        Counts how often each distinct value of a column occurs.
+
+        Args:
+            col_name (str): The column to count.
+
+        Returns:
+            A DataFrame with the distinct values (in a column named col_name) and
+            their counts (in "count"), sorted by descending count.
+
+        Raises:
+            ValueError: If the column does not exist.
+        """
+        return DataFrame._from_cpp(self._obj.value_counts(col_name))
+
+    def drop_duplicates(self, subset: list[str] | None = None) -> DataFrame:
+        """
+        Returns a new DataFrame without duplicate rows, keeping the first occurrence.
+
+        Args:
+            subset (list[str] | None): Columns to compare. Defaults to all columns.
+
+        Returns:
+            A new DataFrame with the duplicate rows removed.
+
+        Raises:
+            ValueError: If a subset column does not exist.
+        """
+        return DataFrame._from_cpp(self._obj.drop_duplicates(subset or []))
+
+    def to_csv(self, path: str, header: bool = True, delimiter: str = ",", num_threads: int = 0) -> None:
+        """
+        Writes the DataFrame to a CSV file that `read_csv` reads back.
+
+        Numbers are written in their shortest exact form, nulls as empty fields,
+        and text containing the delimiter, quotes or line breaks is quoted.
+        Blocks of rows are formatted in parallel and written in order.
+
+        Args:
+            path (str): The output path (overwritten).
+            header (bool): Whether to write the column names first. Defaults to True.
+            delimiter (str): The single-character field separator. Defaults to ",".
+            num_threads (int): Number of formatting threads. Defaults to 0 (all hardware threads).
+
+        Raises:
+            RuntimeError: If the file cannot be written.
+        """
+        self._obj.to_csv(path, header, delimiter, num_threads)
+
+    def save(self, path: str, compression: str = "lz4", chunk_rows: int = 65536) -> None:
+        """
+        Writes the DataFrame to a Daedalus columnar (.dcol) file.
+
+        The file stores typed column chunks with min/max statistics and a schema
+        footer, so it loads with `read_dcol` without any parsing. It can also be
+        inspected with the pure-Python `tools/dcol_reader.py`.
+
+        Args:
+            path (str): The output path.
+            compression (str): "lz4" (default) or "none". Uncompressed numeric
+                columns can be viewed without copying through `DcolFile.to_numpy`.
+            chunk_rows (int): Rows per chunk, the unit of statistics-based skipping.
+
+        Raises:
+            ValueError: If compression is unknown.
+            RuntimeError: If the file cannot be written.
+        """
+        self._obj.save(path, compression, chunk_rows)
+
+    def append_rows(self, batch: DataFrame) -> None:
+        """
+        Appends the rows of another DataFrame in-place.
+
+        The batch must have the same column names. Columns are widened when the
+        batch holds a wider type (int -> float, or numeric/str -> mixed) and the
+        column buffers grow geometrically, so repeated appends stay cheap.
+
+        Args:
+            batch (DataFrame): The rows to append.
+
+        Raises:
+            ValueError: If the column names do not match.
+        """
+        self._obj.append_rows(batch._obj)
+
+    @staticmethod
+    def concat(frames: list[DataFrame], axis: int = 0) -> DataFrame:
+        """
+        Concatenates DataFrames along rows (axis=0) or columns (axis=1).
+
+        For axis=0 every frame must share the same column names. Each output column
+        has the type shared by its non-empty inputs: matching types are kept (category
+        dictionaries are merged), int32 with int64 gives int64, any other mix of
+        int32, int64 and float64 gives float64, string with category gives string,
+        and every other mix (e.g. with bool, or numbers with text) gives mixed.
+        For axis=1 every frame must have the same number of rows and unique column names.
+
+        Args:
+            frames (list[DataFrame]): The DataFrames to concatenate, in order.
+            axis (int): 0 to stack rows, 1 to place columns side by side. Defaults to 0.
+
+        Returns:
+            A new DataFrame holding the concatenated data.
+
+        Raises:
+            ValueError: If shapes or column names are incompatible, or axis is invalid.
+
+        Example:
+            >>> DataFrame.concat([jan, feb, mar])
+        """
+        return DataFrame._from_cpp(_DataFrameCpp.concat([f._obj for f in frames], axis))
+
     # --------------------------------
     # Dunder Methods - Acess Functions
     # --------------------------------
@@ -1,6 +1,7 @@
 from __future__ import annotations
 import typing
 from ..daedalus_cpp import Matrix as _MatrixCpp
+from .sketches import KLLSketch, HyperLogLog
 
 try:
     import numpy as np
@@ -298,6 +299,25 @@ class Matrix:
             raise ImportError("NumPy is required for to_numpy(). Install it via 'pip install numpy'")
         return np.asarray(self._obj)
 
+    def to_csv(self, path: str, header: list[str] | None = None, delimiter: str = ",", num_threads: int = 0) -> None:
+        """
+        Writes the Matrix to a CSV file, one row per line.
+
+        Values are written in their shortest exact form and NaN as an empty field.
+        Blocks of rows are formatted in parallel and written in order.
+
+        Args:
+            path (str): The output path (overwritten).
+            header (list[str] | None): Optional column names for a header line.
+            delimiter (str): The single-character field separator. Defaults to ",".
+            num_threads (int): Number of formatting threads. Defaults to 0 (all hardware threads).
+
+        Raises:
+            ValueError: If the header does not name every column.
+            RuntimeError: If the file cannot be written.
+        """
+        self._obj.to_csv(path, header or [], delimiter, num_threads)
+
     def norm(self, type: str = "fro"):
         """
         Computes the matrix norm.
@@ -424,6 +444,33 @@ class Matrix:
     def flatten(self) -> Matrix:
         return self.reshape(1, self.rows * self.cols)
 
+    def quantile_sketches(self, k: int = 200) -> list[KLLSketch]:
+        """
+        Builds one KLL quantile sketch per column in a single parallel pass.
+
+        Args:
+            k (int): Accuracy parameter of each sketch.
+
+        Returns:
+            A list of KLLSketch objects, one per column.
+
+        Example:
+            >>> medians = [s.quantile(0.5) for s in X.quantile_sketches()]
+        """
+        return [KLLSketch._from_cpp(s) for s in self._obj.quantile_sketches(k)]
+
+    def distinct_sketches(self, precision: int = 14) -> list[HyperLogLog]:
+        """
+        Builds one HyperLogLog distinct-count sketch per column in a single parallel pass.
+
+        Args:
+            precision (int): Precision of each sketch (4 to 18).
+
+        Returns:
+            A list of HyperLogLog objects, one per column.
+        """
+        return [HyperLogLog._from_cpp(s) for s in self._obj.distinct_sketches(precision)]
+
     def transpose(self) -> Matrix:
         """Returns a new Matrix that is the transpose of the current matrix."""
         res = Matrix(0, 0)
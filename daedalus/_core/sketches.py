@@ -0,0 +1,190 @@
+from __future__ import annotations
+from ..daedalus_cpp import KLLSketch as _KLLSketchCpp
+from ..daedalus_cpp import HyperLogLog as _HyperLogLogCpp
+
+class KLLSketch:
+    """
+    A mergeable streaming quantile sketch (KLL), backed by C++.
+
+    Summarises a stream of numbers in O(k) memory. Quantile estimates have a
+    rank error of roughly 1.65 / k. Sketches built on different chunks of data
+    can be merged, and they can be serialized to bytes (or pickled).
+    """
+
+    def __init__(self, k: int = 200) -> None:
+        """
+        Initializes an empty sketch.
+
+        Args:
+            k (int): Accuracy parameter. Larger values use more memory and are more accurate.
+
+        Raises:
+            ValueError: If k is smaller than 8.
+        """
+        self._obj = _KLLSketchCpp(k)
+
+    @classmethod
+    def _from_cpp(cls, cpp_obj: _KLLSketchCpp) -> KLLSketch:
+        """Wraps an existing C++ KLLSketch object in the Python class."""
+        instance = cls.__new__(cls)
+        instance._obj = cpp_obj
+        return instance
+
+    @property
+    def k(self) -> int:
+        """The accuracy parameter of the sketch."""
+        return self._obj.k
+
+    def __len__(self) -> int:
+        """Returns the number of values added to the sketch."""
+        return self._obj.count()
+
+    def min(self) -> float:
+        """Returns the exact minimum of the added values (NaN if empty)."""
+        return self._obj.min()
+
+    def max(self) -> float:
+        """Returns the exact maximum of the added values (NaN if empty)."""
+        return self._obj.max()
+
+    def update(self, values: float | list[float]) -> KLLSketch:
+        """
+        Adds one value or a list of values. NaN values are ignored.
+
+        Returns:
+            self
+        """
+        if isinstance(values, list):
+            self._obj.update_many(values)
+        else:
+            self._obj.update(values)
+        return self
+
+    def merge(self, other: KLLSketch) -> KLLSketch:
+        """
+        Merges another sketch (built with the same k) into this one.
+
+        Raises:
+            ValueError: If the sketches use a different k.
+
+        Returns:
+            self
+        """
+        self._obj.merge(other._obj)
+        return self
+
+    def quantile(self, q: float | list[float]) -> float | list[float]:
+        """
+        Returns the approximate value at quantile q (or at each quantile in a list).
+
+        Args:
+            q (float | list[float]): Quantile(s) in [0, 1]. 0.5 is the median.
+
+        Raises:
+            ValueError: If a quantile is outside [0, 1].
+        """
+        if isinstance(q, list):
+            return self._obj.quantiles(q)
+        return self._obj.quantile(q)
+
+    def rank(self, value: float) -> float:
+        """Returns the approximate fraction of values less than or equal to value."""
+        return self._obj.rank(value)
+
+    def to_bytes(self) -> bytes:
+        """Serializes the sketch to bytes."""
+        return self._obj.serialize()
+
+    @staticmethod
+    def from_bytes(data: bytes) -> KLLSketch:
+        """
+        Restores a sketch from bytes produced by to_bytes().
+
+        Raises:
+            ValueError: If data is not a serialized KLL sketch.
+        """
+        return KLLSketch._from_cpp(_KLLSketchCpp.deserialize(data))
+
+    def __reduce__(self):
+        return (KLLSketch.from_bytes, (self.to_bytes(),))
+
+
+class HyperLogLog:
+    """
+    A mergeable distinct-count sketch (HyperLogLog), backed by C++.
+
+    Uses 2**precision bytes of memory. The relative standard error is
+    about 1.04 / sqrt(2**precision), so precision=14 gives roughly 0.8%.
+    """
+
+    def __init__(self, precision: int = 14) -> None:
+        """
+        Initializes an empty sketch.
+
+        Args:
+            precision (int): Number of index bits, between 4 and 18.
+
+        Raises:
+            ValueError: If precision is out of range.
+        """
+        self._obj = _HyperLogLogCpp(precision)
+
+    @classmethod
+    def _from_cpp(cls, cpp_obj: _HyperLogLogCpp) -> HyperLogLog:
+        """Wraps an existing C++ HyperLogLog object in the Python class."""
+        instance = cls.__new__(cls)
+        instance._obj = cpp_obj
+        return instance
+
+    @property
+    def precision(self) -> int:
+        """The precision (number of index bits) of the sketch."""
+        return self._obj.precision
+
+    def update(self, values: float | int | str | list[float | int | str]) -> HyperLogLog:
+        """
+        Adds one value or a list of values. Numbers of equal value count once.
+
+        Returns:
+            self
+        """
+        if isinstance(values, list):
+            for v in values:
+                self._obj.update(v)
+        else:
+            self._obj.update(values)
+        return self
+
+    def merge(self, other: HyperLogLog) -> HyperLogLog:
+        """
+        Merges another sketch (with the same precision) into this one.
+
+        Raises:
+            ValueError: If the precisions differ.
+
+        Returns:
+            self
+        """
+        self._obj.merge(other._obj)
+        return self
+
+    def estimate(self) -> float:
+        """Returns the estimated number of distinct values."""
+        return self._obj.estimate()
+
+    def to_bytes(self) -> bytes:
+        """Serializes the sketch to bytes."""
+        return self._obj.serialize()
+
+    @staticmethod
+    def from_bytes(data: bytes) -> HyperLogLog:
+        """
+        Restores a sketch from bytes produced by to_bytes().
+
+        Raises:
+            ValueError: If data is not a serialized HyperLogLog sketch.
+        """
+        return HyperLogLog._from_cpp(_HyperLogLogCpp.deserialize(data))
+
+    def __reduce__(self):
+        return (HyperLogLog.from_bytes, (self.to_bytes(),))
@@ -0,0 +1,82 @@
+from __future__ import annotations
+from ..daedalus_cpp import SparseMatrix as _SparseMatrixCpp
+from .matrix import Matrix
+
+
+class SparseMatrix:
+    """
+    A Compressed Sparse Row (CSR) matrix backed by C++.
+
+    Only non-zero entries are stored, which makes high-dimensional sparse
+    features (text, one-hot encodings, LIBSVM datasets) practical. The linear
+    models accept a SparseMatrix directly and never densify it.
+    """
+
+    def __init__(self, rows: int, cols: int, indptr: list[int] | None = None,
+                 indices: list[int] | None = None, values: list[float] | None = None) -> None:
+        """
+        Initialize the SparseMatrix.
+
+        Args:
+            rows (int): Number of rows.
+            cols (int): Number of columns.
+            indptr (list[int] | None): Row offsets (rows + 1 values). If None, the matrix is all zeros.
+            indices (list[int] | None): Column index of every stored entry.
+            values (list[float] | None): Value of every stored entry.
+
+        Raises:
+            ValueError: If the CSR arrays are inconsistent or an index is out of range.
+        """
+        if indptr is None:
+            self._obj = _SparseMatrixCpp(rows, cols)
+        else:
+            self._obj = _SparseMatrixCpp(rows, cols, list(indptr), list(indices or []), list(values or []))
+
+    @classmethod
+    def _from_cpp(cls, cpp_obj) -> SparseMatrix:
+        result = cls.__new__(cls)
+        result._obj = cpp_obj
+        return result
+
+    @classmethod
+    def from_dense(cls, dense: Matrix) -> SparseMatrix:
+        """Builds a SparseMatrix from the non-zero entries of a Matrix."""
+        return cls._from_cpp(_SparseMatrixCpp.from_dense(dense._obj))
+
+    def to_dense(self) -> Matrix:
+        """Returns the equivalent dense Matrix."""
+        result = Matrix(0, 0)
+        result._obj = self._obj.to_dense()
+        return result
+
+    @property
+    def rows(self) -> int:
+        return self._obj.rows
+
+    @property
+    def cols(self) -> int:
+        return self._obj.cols
+
+    @property
+    def shape(self) -> tuple[int, int]:
+        return (self._obj.rows, self._obj.cols)
+
+    @property
+    def nnz(self) -> int:
+        """Number of stored entries."""
+        return self._obj.nnz
+
+    @property
+    def indptr(self):
+        return self._obj.indptr
+
+    @property
+    def indices(self):
+        return self._obj.indices
+
+    @property
+    def values(self):
+        return self._obj.values
+
+    def __repr__(self) -> str:
+        return f"SparseMatrix(shape={self.shape}, nnz={self.nnz})"
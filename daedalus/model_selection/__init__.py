@@ -1,7 +1,13 @@
 # daedalus/model_selection/__init__.py
 
 from .model_selection import (
-    train_test_split
+    train_test_split,
+    train_test_split_indices,
+    take_rows,
+    MatrixView,
+    kfold_indices,
+    cross_validate
 )
 
-__all__ = ["train_test_split"]
\ No newline at end of file
+__all__ = ["train_test_split", "train_test_split_indices", "take_rows", "MatrixView", "kfold_indices",
+           "cross_validate"]
\ No newline at end of file
@@ -1,37 +1,180 @@
 # daedalus/model_selection/model_selection.py
 
 from __future__ import annotations
+from typing import Callable
 from ..daedalus_cpp import (
-    train_test_split as _tts_cpp
+    train_test_split as _tts_cpp,
+    train_test_split_views as _tts_views_cpp,
+    train_test_split_indices as _tts_indices_cpp,
+    stratified_split_indices as _stratified_indices_cpp,
+    take_rows as _take_rows_cpp,
+    kfold_indices as _kfold_indices_cpp,
+    cross_validate as _cross_validate_cpp
 )
 from .._core import Matrix
 
-def train_test_split(X: Matrix, y: Matrix, test_size: float = 0.2, seed: int = 42) -> tuple[Matrix, Matrix, Matrix, Matrix]:
+def _wrap(cpp_obj) -> Matrix:
+    result = Matrix(0, 0)
+    result._obj = cpp_obj
+    return result
+
+class MatrixView:
+    """
+    A read-only selection of rows of a Matrix, returned by
+    `train_test_split(..., copy=False)`.
+
+    The view stores only row indices and refers to the original Matrix, which
+    it keeps alive. Call `to_matrix` to gather the rows into a new Matrix.
+    """
+
+    def __init__(self, cpp_obj, base: Matrix) -> None:
+        self._obj = cpp_obj
+        self._base = base
+
+    @property
+    def rows(self) -> int:
+        return self._obj.rows
+
+    @property
+    def cols(self) -> int:
+        return self._obj.cols
+
+    @property
+    def shape(self) -> tuple[int, int]:
+        return (self.rows, self.cols)
+
+    @property
+    def indices(self) -> list[int]:
+        """The row of the original Matrix behind each row of the view"""
+        return self._obj.indices
+
+    @property
+    def base(self) -> Matrix:
+        """The Matrix the view refers to"""
+        return self._base
+
+    def __len__(self) -> int:
+        return self.rows
+
+    def __getitem__(self, index: tuple[int, int]) -> float:
+        return self._obj[index]
+
+    def to_matrix(self) -> Matrix:
+        """Copies the viewed rows into a new Matrix, in parallel."""
+        return _wrap(self._obj.materialize())
+
+def train_test_split(X: Matrix, y: Matrix, test_size: float = 0.2, seed: int = 42, stratify: bool = False,
+                     copy: bool = True) -> tuple[Matrix, Matrix, Matrix, Matrix] | tuple[MatrixView, MatrixView, MatrixView, MatrixView]:
     """
     Splits matrices into random train and test subsets.
-    
-    This function shuffles the dataset indices and partitions the features (X) 
+
+    This function shuffles the dataset indices and partitions the features (X)
         and targets (y) into two sets based on the @p test_size ratio.
 
-    Args: 
+    Args:
         X: Feature matrix.
         y: Target matrix.
         test_size: The proportion of the dataset to include in the test split (0.0 to 1.0).
         seed: The seed for the random number generator to ensure reproducibility.
+        stratify: Keep the class proportions of the first column of y in both subsets.
+        copy: If False, return MatrixViews over X and y instead of copying the rows.
 
     Returns:
         A tuple of 4 matrices (train_X, test_X, train_y, test_y)
+
+    Raises:
+        ValueError: If X and y have different row counts or test_size is outside [0, 1].
+    """
+    if not copy:
+        X_tr, X_te, y_tr, y_te = _tts_views_cpp(X._obj, y._obj, test_size, seed, stratify)
+        return (MatrixView(X_tr, X), MatrixView(X_te, X), MatrixView(y_tr, y), MatrixView(y_te, y))
+
+    X_tr_obj, X_te_obj, y_tr_obj, y_te_obj = _tts_cpp(X._obj, y._obj, test_size, seed, stratify)
+    return (_wrap(X_tr_obj), _wrap(X_te_obj), _wrap(y_tr_obj), _wrap(y_te_obj))
+
+def train_test_split_indices(n_rows: int, test_size: float = 0.2, seed: int = 42,
+                             y: Matrix | None = None) -> tuple[list[int], list[int]]:
+    """
+    Returns the row indices of a train/test split without touching any data.
+
+    Uses the same shuffle as `train_test_split`, so the indices select the
+    same rows for the same seed.
+
+    Args:
+        n_rows: Number of rows to split.
+        test_size: The proportion of rows in the test set (0.0 to 1.0).
+        seed: The seed for the random number generator.
+        y: If given, split stratified by the class labels in its first column.
+
+    Returns:
+        A tuple (train_indices, test_indices).
+
+    Raises:
+        ValueError: If test_size is outside [0, 1], or y does not have n_rows rows.
+    """
+    if y is None:
+        return _tts_indices_cpp(n_rows, test_size, seed)
+    if y.rows != n_rows:
+        raise ValueError(f"y has {y.rows} rows, expected {n_rows}.")
+    return _stratified_indices_cpp(y._obj, test_size, seed)
+
+def take_rows(X: Matrix, rows: list[int]) -> Matrix:
+    """
+    Gathers the given rows of X, in order, into a new Matrix using all threads.
+
+    Raises:
+        IndexError: If an index is not a row of X.
+    """
+    return _wrap(_take_rows_cpp(X._obj, list(rows)))
+
+def kfold_indices(n_rows: int, folds: int = 5, shuffle: bool = True, seed: int = 42) -> list[tuple[list[int], list[int]]]:
+    """
+    Splits the rows 0..n_rows-1 into folds for cross-validation.
+
+    Args:
+        n_rows: Number of rows.
+        folds: Number of folds; test fold sizes differ by at most one.
+        shuffle: Shuffle the rows before cutting the folds.
+        seed: The seed for the random number generator.
+
+    Returns:
+        One (train_indices, test_indices) tuple per fold.
+
+    Raises:
+        ValueError: If folds < 2 or folds > n_rows.
+    """
+    return _kfold_indices_cpp(n_rows, folds, shuffle, seed)
+
+def cross_validate(model_factory: Callable[[], object], X: Matrix, y: Matrix, folds: int = 5,
+                   metrics: list[str] | tuple[str, ...] = ("r2_score",), stratify: bool = False, seed: int = 42,
+                   n_jobs: int = 0) -> dict[str, list[float]]:
+    """
+    Evaluates a model with k-fold cross-validation, training the folds in parallel.
+
+    `model_factory` is called once per fold to build a fresh, unfitted model
+    (any daedalus model, e.g. `lambda: LinearRegression(0.1)`, or a Python
+    subclass of `daedalus_cpp.Model`, whose fit and predict then run under the
+    GIL). The folds are
+    then fitted and scored concurrently in C++ with the GIL released; each fold
+    only copies its own rows out of X and y while it trains.
+
+    Args:
+        model_factory: Callable returning a new model.
+        X: Feature matrix.
+        y: Target matrix.
+        folds: Number of folds.
+        metrics: Names of functions in daedalus.metrics computed on each test
+            fold ("mean_squared_error", "r2_score", "accuracy_score",
+            "precision_score", "recall_score", "f1_score", "mcc_score").
+        stratify: Keep the class proportions of the first column of y in every fold.
+        seed: The seed used to shuffle the rows.
+        n_jobs: Maximum number of folds trained at once (0 = all cores).
+
+    Returns:
+        A dict with "fit_time" and "score_time" (seconds) and "test_<metric>"
+        for every metric, each holding one value per fold.
+
+    Raises:
+        ValueError: If folds is out of range, X and y differ in rows, or a metric is unknown.
     """
-    X_tr_obj, X_te_obj, y_tr_obj, y_te_obj = _tts_cpp(X._obj, y._obj, test_size, seed)
-    
-    X_train = Matrix(X_tr_obj.rows, X_tr_obj.cols)
-    X_test = Matrix(X_te_obj.rows, X_te_obj.cols)
-    y_train = Matrix(y_tr_obj.rows, y_tr_obj.cols)
-    y_test = Matrix(y_te_obj.rows, y_te_obj.cols)
-    
-    X_train._obj = X_tr_obj
-    X_test._obj = X_te_obj
-    y_train._obj = y_tr_obj
-    y_test._obj = y_te_obj
-    
-    return (X_train, X_test, y_train, y_test)
\ No newline at end of file
+    return _cross_validate_cpp(model_factory, X._obj, y._obj, folds, list(metrics), stratify, seed, n_jobs)
@@ -5,5 +5,6 @@ from .linear_regression import LinearRegression
 from .logistic_regression import LogisticRegression
 from .knn import KNN
 from .neural_network import NeuralNetwork
+from .pipeline import Pipeline
 
-__all__ = ['Model', 'LinearRegression', 'LogisticRegression', 'KNN', 'NeuralNetwork']
\ No newline at end of file
+__all__ = ['Model', 'LinearRegression', 'LogisticRegression', 'KNN', 'NeuralNetwork', 'Pipeline']
\ No newline at end of file
@@ -1,7 +1,8 @@
 from __future__ import annotations
 from .model import Model
 from ..daedalus_cpp import LinearRegression as _LinearRegressionCpp
-from .._core import Matrix
+from .._core import Matrix, SparseMatrix
+from ..preprocessing.polynomial_features import PolynomialExpansion
 
 class LinearRegression(Model):
     """
@@ -21,12 +22,13 @@ class LinearRegression(Model):
         """
         self._obj = _LinearRegressionCpp(learning_rate, reg_lambda, penalty)
 
-    def fit(self, X: Matrix, y: Matrix, epochs: int | None = None) -> None:
+    def fit(self, X: Matrix | SparseMatrix | PolynomialExpansion, y: Matrix, epochs: int | None = None) -> None:
         """
         Trains the model on the provided dataset.
 
         Args:
-            X: Feature matrix of shape (n_samples, n_features).
+            X: Feature matrix of shape (n_samples, n_features): dense, CSR, or a
+               PolynomialExpansion that is expanded batch by batch.
             y: Target matrix of shape (n_samples, n_targets).
             epochs: Optional number of gradient descent iterations. If None, 
                     uses the C++ default convergence logic.
@@ -36,7 +38,7 @@ class LinearRegression(Model):
         else:
             self._obj.fit(X._obj, y._obj)
 
-    def predict(self, X: Matrix) -> Matrix:
+    def predict(self, X: Matrix | SparseMatrix | PolynomialExpansion) -> Matrix:
         """
         Makes continuous predictions using the trained model parameters.
 
@@ -1,7 +1,8 @@
 from __future__ import annotations
 from .model import Model
 from ..daedalus_cpp import LogisticRegression as _LogisticRegressionCpp
-from .._core import Matrix
+from .._core import Matrix, SparseMatrix
+from ..preprocessing.polynomial_features import PolynomialExpansion
 
 class LogisticRegression(Model):
     """
@@ -21,12 +22,13 @@ class LogisticRegression(Model):
         """
         self._obj = _LogisticRegressionCpp(learning_rate, reg_lambda, penalty)
 
-    def fit(self, X: Matrix, y: Matrix, epochs: int | None = None) -> None:
+    def fit(self, X: Matrix | SparseMatrix | PolynomialExpansion, y: Matrix, epochs: int | None = None) -> None:
         """
         Trains the classifier using Log-Loss gradient descent.
 
         Args:
-            X: Feature matrix of shape (n_samples, n_features).
+            X: Feature matrix of shape (n_samples, n_features): dense, CSR, or a
+               PolynomialExpansion that is expanded batch by batch.
             y: Target matrix of shape (n_samples, n_targets).
             epochs: Optional number of iterations. If None, uses default logic.
         """
@@ -35,7 +37,7 @@ class LogisticRegression(Model):
         else:
             self._obj.fit(X._obj, y._obj)
 
-    def predict(self, X: Matrix) -> Matrix:
+    def predict(self, X: Matrix | SparseMatrix | PolynomialExpansion) -> Matrix:
         """
         Predicts binary labels (0.0 or 1.0) based on a 0.5 threshold.
 
@@ -49,7 +51,7 @@ class LogisticRegression(Model):
         res = Matrix(res_obj.rows, res_obj.cols)
         res._obj = res_obj
         return res
-    def predict_proba(self, X: Matrix) -> Matrix:
+    def predict_proba(self, X: Matrix | SparseMatrix | PolynomialExpansion) -> Matrix:
         """
         Returns the raw probability of the positive class (range [0, 1]).
 
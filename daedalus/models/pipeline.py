@@ -0,0 +1,80 @@
+from __future__ import annotations
+from .model import Model
+from ..daedalus_cpp import Pipeline as _PipelineCpp
+from .._core import Matrix
+from ..preprocessing.transformer import Transformer
+
+class Pipeline(Model):
+    """
+    A sequence of transformers followed by a model, used as a single model.
+
+    When every transformer is affine (the scalers and PCA) and the model is a
+    LinearRegression or LogisticRegression, the transformers are folded into
+    the model's weights at fit time, so `predict` is a single pass over the
+    input with no intermediate matrices. Otherwise the stages are applied one
+    block of rows at a time, so intermediates stay small.
+
+    The steps and the model are shared with the pipeline, not copied: fitting
+    the pipeline fits them. Call `fuse()` after refitting a step separately.
+    """
+
+    def __init__(self, steps: list[Transformer], model: Model) -> None:
+        """
+        Initializes the Pipeline.
+
+        Args:
+            steps: Transformers applied in order. May be empty.
+            model: The model applied to the output of the last step.
+        """
+        self.steps = list(steps)
+        self.model = model
+        self._obj = _PipelineCpp([step._obj for step in self.steps], model._obj)
+
+    @property
+    def is_fused(self) -> bool:
+        """True if the steps are folded into the model and predict is a single pass"""
+        return self._obj.get_is_fused()
+
+    def fit(self, X: Matrix, y: Matrix) -> None:
+        """
+        Fits each step on the output of the previous one, then the model.
+
+        Args:
+            X: Feature matrix of shape (n_samples, n_features).
+            y: Target matrix of shape (n_samples, 1).
+        """
+        self._obj.fit(X._obj, y._obj)
+
+    def predict(self, X: Matrix) -> Matrix:
+        """
+        Applies every step and the model to X.
+
+        Args:
+            X: Feature matrix with the fitted number of features.
+
+        Returns:
+            A Matrix containing the model's predictions.
+        """
+        res = Matrix(0, 0)
+        res._obj = self._obj.predict(X._obj)
+        return res
+
+    def predict_proba(self, X: Matrix) -> Matrix:
+        """
+        Returns the positive-class probabilities of a LogisticRegression pipeline.
+
+        Raises:
+            RuntimeError: If the model is not a LogisticRegression.
+        """
+        res = Matrix(0, 0)
+        res._obj = self._obj.predict_proba(X._obj)
+        return res
+
+    def fuse(self) -> bool:
+        """
+        Folds the fitted steps into the model's weights, if they are all affine.
+
+        Returns:
+            True if predict now runs as a single pass.
+        """
+        return self._obj.fuse()
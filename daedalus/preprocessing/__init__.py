@@ -1,5 +1,13 @@
 # daedalus/preprocessing/__init__.py
 
+from .transformer import Transformer
 from .standard_scaler import StandardScaler
+from .min_max_scaler import MinMaxScaler
+from .max_abs_scaler import MaxAbsScaler
+from .robust_scaler import RobustScaler
+from .pca import PCA
+from .polynomial_features import PolynomialFeatures, PolynomialExpansion
+from .feature_hasher import FeatureHasher
 
-__all__ = ["StandardScaler"]
\ No newline at end of file
+__all__ = ["Transformer", "StandardScaler", "MinMaxScaler", "MaxAbsScaler", "RobustScaler", "PCA",
+           "PolynomialFeatures", "PolynomialExpansion", "FeatureHasher"]
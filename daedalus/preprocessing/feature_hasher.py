@@ -0,0 +1,60 @@
+# daedalus/preprocessing/feature_hasher.py
+
+from __future__ import annotations
+from .._core import DataFrame, SparseMatrix
+from ..daedalus_cpp import FeatureHasher as _FeatureHasherCpp
+
+class FeatureHasher:
+    """
+    Maps DataFrame columns to a fixed number of sparse features with the
+    hashing trick.
+
+    Every string or categorical value becomes the feature "column=value" and
+    every numeric value the feature "column" weighted by the value; the
+    feature's column is its MurmurHash modulo n_features. No vocabulary is
+    learned or stored, so there is nothing to fit, unseen values need no
+    special handling, and rows are hashed in parallel. Text columns are split
+    into lower-cased alphanumeric tokens, each counted as "column=token".
+    """
+
+    def __init__(self, n_features: int = 2**20, alternate_sign: bool = True, seed: int = 0) -> None:
+        """
+        Initializes the FeatureHasher.
+
+        Args:
+            n_features: Number of output columns. Defaults to 2**20.
+            alternate_sign: Whether to give each feature a hash-derived sign, so
+                colliding features cancel out on average. Defaults to True.
+            seed: Selects an independent hash function. Defaults to 0.
+
+        Raises:
+            ValueError: If n_features is 0 or does not fit in 32 bits.
+        """
+        self._obj = _FeatureHasherCpp(n_features, alternate_sign, seed)
+
+    @property
+    def n_features(self) -> int:
+        """The number of output columns"""
+        return self._obj.get_n_features()
+
+    def transform(self, df: DataFrame, columns: list[str] | None = None,
+                  text_columns: list[str] | None = None) -> SparseMatrix:
+        """
+        Hashes the rows of a DataFrame into a (rows, n_features) SparseMatrix.
+
+        Args:
+            df: The data.
+            columns: Columns hashed as one value per cell. Defaults to every
+                column not listed in text_columns.
+            text_columns: String columns tokenized into words. Defaults to none.
+
+        Returns:
+            SparseMatrix: The hashed features. Null cells and zeros produce no entry.
+
+        Raises:
+            ValueError: If a column does not exist.
+        """
+        text_columns = list(text_columns or [])
+        if columns is None:
+            columns = [name for name in df.columns if name not in text_columns]
+        return SparseMatrix._from_cpp(self._obj.transform(df._obj, list(columns), text_columns))
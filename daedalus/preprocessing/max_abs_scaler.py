@@ -0,0 +1,23 @@
+# daedalus/preprocessing/max_abs_scaler.py
+
+from __future__ import annotations
+from ..daedalus_cpp import MaxAbsScaler as _MaxAbsScalerCpp
+from .transformer import Transformer
+
+class MaxAbsScaler(Transformer):
+    """
+    Scale each feature by its maximum absolute value, mapping it into [-1, 1].
+
+    Values are not shifted, so zeros stay zero. NaN values are ignored when fitting.
+    """
+
+    @property
+    def max_abs(self) -> list[float]:
+        """The per-feature maximum absolute value seen during fit"""
+        return self._obj.get_max_abs()
+
+    def __init__(self) -> None:
+        """
+        Initializes the MaxAbsScaler.
+        """
+        self._obj = _MaxAbsScalerCpp()
@@ -0,0 +1,36 @@
+# daedalus/preprocessing/min_max_scaler.py
+
+from __future__ import annotations
+from ..daedalus_cpp import MinMaxScaler as _MinMaxScalerCpp
+from .transformer import Transformer
+
+class MinMaxScaler(Transformer):
+    """
+    Scale each feature linearly so the training minimum and maximum map to a target range.
+
+        z = (x - min) / (max - min) * (b - a) + a
+
+    Constant features map to `a`. NaN values are ignored when fitting.
+    """
+
+    @property
+    def data_min(self) -> list[float]:
+        """The per-feature minimum seen during fit"""
+        return self._obj.get_data_min()
+
+    @property
+    def data_max(self) -> list[float]:
+        """The per-feature maximum seen during fit"""
+        return self._obj.get_data_max()
+
+    def __init__(self, feature_range: tuple[float, float] = (0.0, 1.0)) -> None:
+        """
+        Initializes the MinMaxScaler.
+
+        Args:
+            feature_range: The target range (a, b). Defaults to (0, 1).
+
+        Raises:
+            ValueError: If a is not less than b.
+        """
+        self._obj = _MinMaxScalerCpp(feature_range[0], feature_range[1])
@@ -0,0 +1,69 @@
+# daedalus/preprocessing/pca.py
+
+from __future__ import annotations
+from .._core import Matrix
+from ..daedalus_cpp import PCA as _PCACpp
+from .transformer import Transformer
+
+class PCA(Transformer):
+    """
+    Principal component analysis: a linear projection onto the directions of
+    largest variance in the data.
+
+    The "full" solver eigendecomposes the centered covariance matrix. The
+    "randomized" solver (Halko et al.) only needs a few passes of blocked
+    matrix products over the data, which is much faster when n_components is
+    small compared to the number of features; "auto" chooses between them.
+    `partial_fit` performs incremental PCA over batches, and `transform` is a
+    single matrix product. `transform` returns n_components columns, so
+    `transform_inplace` replaces the contents of X instead of overwriting them.
+    """
+
+    @property
+    def n_components(self) -> int:
+        """The number of components kept"""
+        return self._obj.get_n_components()
+
+    @property
+    def components(self) -> Matrix:
+        """The principal axes, one unit-length component per row (n_components, n_features)"""
+        result = Matrix(0, 0)
+        result._obj = self._obj.get_components()
+        return result
+
+    @property
+    def mean(self) -> list[float]:
+        """The per-feature mean subtracted before projecting"""
+        return self._obj.get_mean()
+
+    @property
+    def singular_values(self) -> list[float]:
+        """The singular values of the centered data for each component"""
+        return self._obj.get_singular_values()
+
+    @property
+    def explained_variance(self) -> list[float]:
+        """The variance of the data along each component"""
+        return self._obj.get_explained_variance()
+
+    @property
+    def explained_variance_ratio(self) -> list[float]:
+        """The fraction of the total variance explained by each component"""
+        return self._obj.get_explained_variance_ratio()
+
+    def __init__(self, n_components: int, svd_solver: str = "auto", n_oversamples: int = 10,
+                 n_power_iterations: int = 4, random_state: int = 42) -> None:
+        """
+        Initializes the PCA transformer.
+
+        Args:
+            n_components: Number of components to keep.
+            svd_solver: "auto", "full" or "randomized". Defaults to "auto".
+            n_oversamples: Extra random directions used by the randomized solver. Defaults to 10.
+            n_power_iterations: Power iterations used by the randomized solver. Defaults to 4.
+            random_state: Seed of the randomized solver. Defaults to 42.
+
+        Raises:
+            ValueError: If n_components is 0 or svd_solver is unknown.
+        """
+        self._obj = _PCACpp(n_components, svd_solver, n_oversamples, n_power_iterations, random_state)
@@ -0,0 +1,98 @@
+# daedalus/preprocessing/polynomial_features.py
+
+from __future__ import annotations
+from .._core import Matrix
+from ..daedalus_cpp import PolynomialFeatures as _PolynomialFeaturesCpp
+from .transformer import Transformer
+
+class PolynomialExpansion:
+    """
+    A lazily expanded polynomial feature matrix, returned by `PolynomialFeatures.expand`.
+
+    Nothing is expanded up front: LinearRegression and LogisticRegression
+    accept the expansion in `fit` and `predict` and generate the expanded
+    features one cache-sized batch of rows at a time, so the full expanded
+    matrix is never held in memory. The expansion keeps its source Matrix alive.
+    """
+
+    def __init__(self, cpp_obj) -> None:
+        self._obj = cpp_obj
+
+    @property
+    def rows(self) -> int:
+        return self._obj.rows
+
+    @property
+    def cols(self) -> int:
+        return self._obj.cols
+
+    @property
+    def shape(self) -> tuple[int, int]:
+        return (self._obj.rows, self._obj.cols)
+
+    def to_dense(self) -> Matrix:
+        """Returns the expanded features as a Matrix."""
+        result = Matrix(0, 0)
+        result._obj = self._obj.to_dense()
+        return result
+
+    def __repr__(self) -> str:
+        return f"PolynomialExpansion(shape={self.shape})"
+
+class PolynomialFeatures(Transformer):
+    """
+    Generate polynomial and interaction features.
+
+    For features [a, b] and degree 2 the output is [1, a, b, a^2, ab, b^2],
+    in the same column order as scikit-learn. `transform` writes every
+    expanded row directly into one pre-sized Matrix in a single parallel pass.
+    To train a linear model on a large expansion without materializing it,
+    pass `expand(X)` to the model's `fit` instead.
+    """
+
+    @property
+    def n_input_features(self) -> int:
+        """The number of features of the fitted data"""
+        return self._obj.get_n_input_features()
+
+    @property
+    def n_output_features(self) -> int:
+        """The number of generated features"""
+        return self._obj.get_n_output_features()
+
+    @property
+    def powers(self) -> Matrix:
+        """The exponent of each input feature (column) in each output feature (row)"""
+        result = Matrix(0, 0)
+        result._obj = self._obj.get_powers()
+        return result
+
+    def __init__(self, degree: int = 2, interaction_only: bool = False, include_bias: bool = True) -> None:
+        """
+        Initializes the PolynomialFeatures transformer.
+
+        Args:
+            degree: The highest total degree of the generated features. Defaults to 2.
+            interaction_only: Only generate products of distinct features (no powers). Defaults to False.
+            include_bias: Whether to include a leading column of ones. Defaults to True.
+
+        Raises:
+            ValueError: If degree is 0.
+        """
+        self._obj = _PolynomialFeaturesCpp(degree, interaction_only, include_bias)
+
+    def expand(self, X: Matrix) -> PolynomialExpansion:
+        """
+        Returns a lazy view of the expansion of X for streaming model training.
+
+        Args:
+            X: Feature matrix with the fitted number of features.
+
+        Returns:
+            PolynomialExpansion: A view accepted by the linear models' `fit` and `predict`.
+
+        Raises:
+            RuntimeError: If the transformer has not been fitted.
+            ValueError: If X does not have the fitted number of features.
+        """
+        return PolynomialExpansion(self._obj.expand(X._obj))
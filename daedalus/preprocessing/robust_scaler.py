@@ -0,0 +1,43 @@
+# daedalus/preprocessing/robust_scaler.py
+
+from __future__ import annotations
+from ..daedalus_cpp import RobustScaler as _RobustScalerCpp
+from .transformer import Transformer
+
+class RobustScaler(Transformer):
+    """
+    Center features on the median and scale them by an interquantile range.
+
+        z = (x - median) / (q_hi - q_lo)
+
+    This is insensitive to outliers in heavy-tailed features. Instead of
+    sorting each feature, the quantiles come from mergeable KLL sketches built
+    in one parallel pass, so they are approximate (rank error about 1.65 / k)
+    and `partial_fit` only merges more sketches. NaN values are ignored when fitting.
+    """
+
+    @property
+    def centers(self) -> list[float]:
+        """The (approximate) per-feature medians"""
+        return self._obj.get_centers()
+
+    @property
+    def scales(self) -> list[float]:
+        """The (approximate) per-feature interquantile ranges"""
+        return self._obj.get_scales()
+
+    def __init__(self, quantile_range: tuple[float, float] = (25.0, 75.0), with_centering: bool = True,
+                 with_scaling: bool = True, k: int = 200) -> None:
+        """
+        Initializes the RobustScaler.
+
+        Args:
+            quantile_range: The (low, high) quantiles in percent. Defaults to (25, 75).
+            with_centering: Whether to subtract the median. Defaults to True.
+            with_scaling: Whether to divide by the interquantile range. Defaults to True.
+            k: Accuracy parameter of the quantile sketches. Defaults to 200.
+
+        Raises:
+            ValueError: If the quantile range is invalid or k is smaller than 8.
+        """
+        self._obj = _RobustScalerCpp(quantile_range[0], quantile_range[1], with_centering, with_scaling, k)
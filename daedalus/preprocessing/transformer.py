@@ -0,0 +1,119 @@
+# daedalus/preprocessing/transformer.py
+
+from __future__ import annotations
+from .._core import Matrix
+
+class Transformer:
+    """
+    Base class of the Daedalus feature transformers.
+
+    A transformer learns parameters from data with `fit` (or incrementally
+    with `partial_fit`) and then applies them with `transform`. Subclasses
+    set `self._obj` to the C++ transformer.
+    """
+
+    @property
+    def is_fitted(self) -> bool:
+        """A boolean flag for determined if fit has been called on the transformer"""
+        return self._obj.get_is_fitted()
+
+    @property
+    def n_samples_seen(self) -> int:
+        """The number of samples the statistics were computed from"""
+        return self._obj.get_n_samples_seen()
+
+    def fit(self, X: Matrix) -> Transformer:
+        """
+        Computes the transformation parameters from X, discarding earlier statistics.
+
+        Args:
+            X: Feature matrix of shape (n_samples, n_features).
+
+        Returns:
+            self: The fitted transformer instance.
+        """
+        self._obj.fit(X._obj)
+        return self
+
+    def partial_fit(self, X: Matrix) -> Transformer:
+        """
+        Updates the transformation parameters with a batch of samples.
+
+        The batch statistics are merged into the running ones, so the
+        transformer can be fitted on data that does not fit in memory, e.g.
+        the Matrix batches of a `CsvReader` created with `matrix_columns`.
+
+        Args:
+            X: A batch of shape (n_samples, n_features); every batch must have
+               the same number of features.
+
+        Returns:
+            self: The updated transformer instance.
+
+        Raises:
+            ValueError: If the number of features differs from earlier batches.
+        """
+        self._obj.partial_fit(X._obj)
+        return self
+
+    def transform(self, X: Matrix) -> Matrix:
+        """
+        Applies the fitted transformation to X.
+
+        Args:
+            X: Feature matrix of shape (n_samples, n_features) to be transformed.
+
+        Returns:
+            Matrix: A new Matrix containing the transformed features.
+
+        Raises:
+            RuntimeError: If the transformer has not been fitted.
+            ValueError: If X does not have the fitted number of features.
+        """
+        result = Matrix(0, 0)
+        result._obj = self._obj.transform(X._obj)
+        return result
+
+    def transform_inplace(self, X: Matrix) -> None:
+        """
+        Applies the fitted transformation to X in place, without allocating a second matrix.
+
+        Args:
+            X: Feature matrix of shape (n_samples, n_features); overwritten
+               with the transformed features.
+        """
+        self._obj.transform_inplace(X._obj)
+
+    def inverse_transform(self, X: Matrix) -> Matrix:
+        """
+        Maps transformed features back to the original feature space.
+
+        Args:
+            X: Transformed feature matrix of shape (n_samples, n_features).
+
+        Returns:
+            Matrix: A new Matrix on the scale of the fitted data.
+        """
+        result = Matrix(0, 0)
+        result._obj = self._obj.inverse_transform(X._obj)
+        return result
+
+    def fit_transform(self, X: Matrix, inplace: bool = False) -> Matrix:
+        """
+        Fits the transformer to the data X and returns a transformed version of X.
+        This is a convenience method that combines fit() and transform().
+
+        Args:
+            X: Feature matrix of shape (n_samples, n_features).
+            inplace: If True, X itself is transformed and returned, so no
+                     second matrix is allocated. Defaults to False.
+
+        Returns:
+            Matrix: The transformed features (X itself when inplace is True).
+        """
+        if inplace:
+            self._obj.fit_transform_inplace(X._obj)
+            return X
+        result = Matrix(0, 0)
+        result._obj = self._obj.fit_transform(X._obj)
+        return result
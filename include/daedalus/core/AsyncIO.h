@@ -0,0 +1,581 @@
+/**
+ * @file AsyncIO.h
+ * @brief Asynchronous whole-file reads for multi-file ingestion, and glob expansion.
+ * * A FileReader keeps several large reads in flight across a list of files
+ * and hands each file back, in order, as soon as all of its blocks have
+ * arrived. On Linux the reads are submitted through io_uring (raw system
+ * calls, no liburing needed); where io_uring is unavailable (older kernels,
+ * seccomp-restricted containers, other platforms) a small pool of threads
+ * issues positional reads instead. Either way the caller can parse one file
+ * while the following ones are still being read.
+ */
+
+// include/daedalus/core/AsyncIO.h
+
+#ifndef ASYNCIO_H
+#define ASYNCIO_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define DAEDALUS_HAVE_IO_URING 1
+#endif
+#endif
+
+/**
+ * @namespace AsyncIO
+ * @brief Overlapped file reads (io_uring or a pread thread pool) and glob patterns.
+ */
+namespace AsyncIO {
+    /** @brief Size of a single read request. */
+    constexpr size_t READ_BLOCK_BYTES = size_t(4) << 20;
+
+    /** @brief Default number of read requests kept in flight. */
+    constexpr size_t DEFAULT_QUEUE_DEPTH = 8;
+
+    /** @brief How a FileReader issues its reads. */
+    enum class Backend { AUTO, IO_URING, THREADS };
+
+    /**
+     * @struct Buffer
+     * @brief The contents of one file.
+     */
+    struct Buffer {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+    };
+
+    /** @brief Returns true if a path contains the glob characters '*', '?' or '['. */
+    inline bool has_wildcards(const std::string& path) {
+        return path.find_first_of("*?[") != std::string::npos;
+    }
+
+    /**
+     * @brief Matches a file name against a shell wildcard pattern.
+     * * Supports '*', '?' and bracket expressions ("[abc]", "[a-z]", "[!0-9]").
+     */
+    inline bool match_wildcard(const char* pattern, const char* name) {
+        const char* star = nullptr;
+        const char* resume = nullptr;
+        while (*name) {
+            if (*pattern == '*') {
+                star = pattern++;
+                resume = name;
+                continue;
+            }
+            bool matched = false;
+            const char* after = pattern + 1;
+            if (*pattern == '?') {
+                matched = true;
+            } else if (*pattern == '[') {
+                const char* p = pattern + 1;
+                bool negate = *p == '!' || *p == '^';
+                if (negate) ++p;
+                bool in_set = false;
+                const char* first = p;
+                while (*p && (*p != ']' || p == first)) {
+                    if (p[1] == '-' && p[2] && p[2] != ']') {
+                        in_set |= *name >= p[0] && *name <= p[2];
+                        p += 3;
+                    } else {
+                        in_set |= *name == *p++;
+                    }
+                }
+                if (*p == ']') {
+                    matched = in_set != negate;
+                    after = p + 1;
+                } else {
+                    matched = *name == '[';  // Unterminated: a literal '['
+                }
+            } else {
+                matched = *pattern && *pattern == *name;
+            }
+            if (matched) {
+                pattern = after;
+                ++name;
+            } else if (star) {
+                pattern = star + 1;
+                name = ++resume;
+            } else {
+                return false;
+            }
+        }
+        while (*pattern == '*') ++pattern;
+        return *pattern == '\0';
+    }
+
+    /**
+     * @brief Expands a glob pattern into the sorted list of matching regular files.
+     * * Only the final path component may contain wildcards. As in the shell,
+     * leading-dot files only match a pattern that starts with '.'.
+     * A path without wildcards is returned unchanged.
+     * @throws std::invalid_argument If a directory component contains wildcards.
+     */
+    inline std::vector<std::string> expand_glob(const std::string& pattern) {
+        if (!has_wildcards(pattern)) return {pattern};
+        namespace fs = std::filesystem;
+        fs::path path(pattern);
+        fs::path dir = path.parent_path();
+        std::string name_pattern = path.filename().string();
+        if (has_wildcards(dir.string())) {
+            throw std::invalid_argument("Wildcards are only supported in the file name: " + pattern);
+        }
+
+        std::vector<std::string> matches;
+        std::error_code ec;
+        fs::directory_iterator it(dir.empty() ? fs::path(".") : dir, ec);
+        if (ec) return matches;
+        for (const auto& entry : it) {
+            std::string name = entry.path().filename().string();
+            if (name[0] == '.' && name_pattern[0] != '.') continue;
+            if (!entry.is_regular_file(ec) || !match_wildcard(name_pattern.c_str(), name.c_str())) continue;
+            matches.push_back((dir / name).string());
+        }
+        std::sort(matches.begin(), matches.end());
+        return matches;
+    }
+
+#ifdef DAEDALUS_HAVE_IO_URING
+    /**
+     * @class Ring
+     * @brief A minimal io_uring instance driven through the raw system calls.
+     */
+    class Ring {
+        int fd = -1;
+        void* sq_ring = nullptr;
+        void* cq_ring = nullptr;
+        size_t sq_ring_size = 0, cq_ring_size = 0;
+        io_uring_sqe* sqes = nullptr;
+        size_t sqes_size = 0;
+        unsigned *sq_tail = nullptr, *sq_mask = nullptr, *sq_array = nullptr;
+        unsigned *cq_head = nullptr, *cq_tail = nullptr, *cq_mask = nullptr;
+        io_uring_cqe* cqes = nullptr;
+        unsigned to_submit = 0;
+
+        void release() {
+            if (sqes) munmap(sqes, sqes_size);
+            if (cq_ring && cq_ring != sq_ring) munmap(cq_ring, cq_ring_size);
+            if (sq_ring) munmap(sq_ring, sq_ring_size);
+            if (fd >= 0) close(fd);
+            sqes = nullptr;
+            sq_ring = cq_ring = nullptr;
+            fd = -1;
+        }
+
+    public:
+        /** @brief Creates a ring with room for @p entries requests; check ok() afterwards. */
+        explicit Ring(unsigned entries) {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0) return;
+
+            sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (single_mmap) sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+            void* sq = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            if (sq == MAP_FAILED) { release(); return; }
+            sq_ring = sq;
+            void* cq = single_mmap ? sq : mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cq == MAP_FAILED) { release(); return; }
+            cq_ring = cq;
+            sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            void* s = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+            if (s == MAP_FAILED) { release(); return; }
+            sqes = static_cast<io_uring_sqe*>(s);
+
+            char* sqp = static_cast<char*>(sq_ring);
+            char* cqp = static_cast<char*>(cq_ring);
+            sq_tail = reinterpret_cast<unsigned*>(sqp + params.sq_off.tail);
+            sq_mask = reinterpret_cast<unsigned*>(sqp + params.sq_off.ring_mask);
+            sq_array = reinterpret_cast<unsigned*>(sqp + params.sq_off.array);
+            cq_head = reinterpret_cast<unsigned*>(cqp + params.cq_off.head);
+            cq_tail = reinterpret_cast<unsigned*>(cqp + params.cq_off.tail);
+            cq_mask = reinterpret_cast<unsigned*>(cqp + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cqp + params.cq_off.cqes);
+        }
+
+        Ring(const Ring&) = delete;
+        Ring& operator=(const Ring&) = delete;
+        ~Ring() { release(); }
+
+        /** @brief Returns true if the ring was set up successfully. */
+        bool ok() const { return sqes != nullptr; }
+
+        /** @brief Queues a vectored read of @p iov at @p offset of @p file. */
+        void push_read(int file, const iovec* iov, uint64_t offset, uint64_t user_data) {
+            unsigned tail = *sq_tail;
+            unsigned index = tail & *sq_mask;
+            io_uring_sqe& sqe = sqes[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READV;
+            sqe.fd = file;
+            sqe.addr = reinterpret_cast<uint64_t>(iov);
+            sqe.len = 1;
+            sqe.off = offset;
+            sqe.user_data = user_data;
+            sq_array[index] = index;
+            __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+            ++to_submit;
+        }
+
+        /**
+         * @brief Submits the queued reads and waits for at least @p min_complete completions.
+         * @throws std::runtime_error If io_uring_enter fails.
+         */
+        void submit_and_wait(unsigned min_complete) {
+            while (true) {
+                long submitted = syscall(__NR_io_uring_enter, fd, to_submit, min_complete, IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (submitted >= 0) {
+                    to_submit -= static_cast<unsigned>(submitted);
+                    return;
+                }
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                    throw std::runtime_error("io_uring_enter failed: " + std::string(std::strerror(errno)));
+                }
+            }
+        }
+
+        /** @brief Calls f(user_data, result) for every available completion. */
+        template <typename F>
+        void reap(F&& f) {
+            unsigned head = *cq_head;
+            unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head) {
+                const io_uring_cqe& cqe = cqes[head & *cq_mask];
+                f(cqe.user_data, cqe.res);
+            }
+            __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+        }
+    };
+#endif
+
+    /**
+     * @class FileReader
+     * @brief Reads a list of files with several block reads in flight and returns them in order.
+     * * Reads run ahead of the consumer by at most @p depth requests and
+     * @p depth files, so memory stays bounded however many files are read.
+     */
+    class FileReader {
+        struct FileState {
+            std::string path;
+#ifdef _WIN32
+            HANDLE handle = INVALID_HANDLE_VALUE;
+#else
+            int fd = -1;
+#endif
+            Buffer buffer;
+            size_t scheduled = 0;   // Bytes handed out to read requests
+            size_t pending = 0;     // Requests issued but not yet finished
+            bool opened = false;
+            bool complete = false;
+            std::string error;
+        };
+
+        struct Request {
+            size_t file = 0;
+            size_t offset = 0;
+            size_t length = 0;
+        };
+
+        std::vector<FileState> files;
+        size_t depth;
+        size_t consumed = 0;  // Files already returned by next()
+        size_t cursor = 0;    // First file that may still have unscheduled blocks
+
+        std::mutex mutex;
+        std::condition_variable file_done, work_available;
+        std::vector<std::thread> workers;
+        bool stopping = false;
+
+#ifdef DAEDALUS_HAVE_IO_URING
+        std::unique_ptr<Ring> ring;
+        std::vector<Request> slots;
+        std::vector<iovec> slot_iov;
+        std::vector<size_t> free_slots;
+#endif
+
+        /** @brief Closes a file once all of its reads have finished. */
+        void close_file(FileState& f) {
+#ifdef _WIN32
+            if (f.handle != INVALID_HANDLE_VALUE) CloseHandle(f.handle);
+            f.handle = INVALID_HANDLE_VALUE;
+#else
+            if (f.fd >= 0) ::close(f.fd);
+            f.fd = -1;
+#endif
+        }
+
+        /**
+         * @brief Closes a file and marks it complete, waking a consumer waiting for it.
+         * * Every completion goes through here: files can complete inside schedule()
+         * (empty, missing or unreadable files) as well as when their last read finishes.
+         */
+        void complete_file(FileState& f) {
+            close_file(f);
+            f.complete = true;
+            file_done.notify_all();
+        }
+
+        /** @brief Records a failure; the file completes once its outstanding reads have returned. */
+        void fail(FileState& f, const std::string& message) {
+            if (f.error.empty()) f.error = message;
+            f.scheduled = f.buffer.size;
+            if (f.pending == 0) complete_file(f);
+        }
+
+        /** @brief Opens a file and allocates its buffer. */
+        void open_file(FileState& f) {
+            f.opened = true;
+#ifdef _WIN32
+            f.handle = CreateFileA(f.path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            LARGE_INTEGER size;
+            if (f.handle == INVALID_HANDLE_VALUE) return fail(f, "Could not open file: " + f.path);
+            if (!GetFileSizeEx(f.handle, &size)) return fail(f, "Could not read size of file: " + f.path);
+            f.buffer.size = static_cast<size_t>(size.QuadPart);
+#else
+            f.fd = ::open(f.path.c_str(), O_RDONLY);
+            struct stat st;
+            if (f.fd < 0) return fail(f, "Could not open file: " + f.path);
+            if (fstat(f.fd, &st) != 0) return fail(f, "Could not read size of file: " + f.path);
+            f.buffer.size = static_cast<size_t>(st.st_size);
+#ifdef POSIX_FADV_SEQUENTIAL
+            posix_fadvise(f.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#endif
+            f.buffer.data.reset(new char[std::max<size_t>(f.buffer.size, 1)]);
+            if (f.buffer.size == 0) complete_file(f);
+        }
+
+        /**
+         * @brief Hands out the next block to read, opening files as the cursor reaches them.
+         * @return False if no block may be scheduled until the consumer catches up (or all are).
+         */
+        bool schedule(Request& request) {
+            while (cursor < files.size() && cursor < consumed + depth) {
+                FileState& f = files[cursor];
+                if (!f.opened) open_file(f);
+                if (f.scheduled < f.buffer.size) {
+                    request = {cursor, f.scheduled, std::min(READ_BLOCK_BYTES, f.buffer.size - f.scheduled)};
+                    f.scheduled += request.length;
+                    ++f.pending;
+                    return true;
+                }
+                ++cursor;
+            }
+            return false;
+        }
+
+        /** @brief Accounts for a finished request (called with the lock held, or from the ring owner). */
+        void finish(const Request& request, const std::string& error) {
+            FileState& f = files[request.file];
+            --f.pending;
+            if (!error.empty()) fail(f, error);
+            if (f.pending == 0 && f.scheduled == f.buffer.size) complete_file(f);
+        }
+
+        /** @brief Reads one block with positional reads, retrying short reads. */
+        std::string read_block(const Request& request) {
+            FileState& f = files[request.file];
+            char* out = f.buffer.data.get() + request.offset;
+            size_t done = 0;
+            while (done < request.length) {
+#ifdef _WIN32
+                OVERLAPPED overlapped{};
+                uint64_t offset = request.offset + done;
+                overlapped.Offset = static_cast<DWORD>(offset);
+                overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+                DWORD got = 0;
+                DWORD want = static_cast<DWORD>(std::min<size_t>(request.length - done, 1u << 30));
+                if (!ReadFile(f.handle, out + done, want, &got, &overlapped)) return "Could not read file: " + f.path;
+                long n = static_cast<long>(got);
+#else
+                ssize_t n = pread(f.fd, out + done, request.length - done, static_cast<off_t>(request.offset + done));
+                if (n < 0 && errno == EINTR) continue;
+                if (n < 0) return "Could not read file: " + f.path + " (" + std::strerror(errno) + ")";
+#endif
+                if (n == 0) return "File was truncated while reading: " + f.path;
+                done += static_cast<size_t>(n);
+            }
+            return {};
+        }
+
+        /** @brief Thread-pool backend: each worker keeps one read in flight. */
+        void worker() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                Request request;
+                while (!stopping && !schedule(request)) {
+                    if (cursor == files.size()) return;
+                    work_available.wait(lock);
+                }
+                if (stopping) return;
+                lock.unlock();
+                std::string error = read_block(request);
+                lock.lock();
+                finish(request, error);
+            }
+        }
+
+#ifdef DAEDALUS_HAVE_IO_URING
+        /** @brief io_uring backend: fills free slots with reads, then waits for one completion. */
+        void pump() {
+            Request request;
+            while (!free_slots.empty() && schedule(request)) {
+                size_t slot = free_slots.back();
+                free_slots.pop_back();
+                slots[slot] = request;
+                submit_slot(slot);
+            }
+            if (free_slots.size() == slots.size()) return;
+            ring->submit_and_wait(1);
+            ring->reap([&](uint64_t slot, int res) { complete_slot(static_cast<size_t>(slot), res); });
+        }
+
+        /** @brief Queues the remaining bytes of the request held by a slot. */
+        void submit_slot(size_t slot) {
+            const Request& r = slots[slot];
+            slot_iov[slot].iov_base = files[r.file].buffer.data.get() + r.offset;
+            slot_iov[slot].iov_len = r.length;
+            ring->push_read(files[r.file].fd, &slot_iov[slot], r.offset, slot);
+        }
+
+        /** @brief Handles one completion, resubmitting the remainder of short reads. */
+        void complete_slot(size_t slot, int res) {
+            Request& r = slots[slot];
+            if (res == -EINTR || res == -EAGAIN) return submit_slot(slot);
+            if (res > 0 && static_cast<size_t>(res) < r.length) {
+                r.offset += static_cast<size_t>(res);
+                r.length -= static_cast<size_t>(res);
+                return submit_slot(slot);
+            }
+            std::string error;
+            if (res < 0) error = "Could not read file: " + files[r.file].path + " (" + std::strerror(-res) + ")";
+            else if (res == 0) error = "File was truncated while reading: " + files[r.file].path;
+            finish(r, error);
+            free_slots.push_back(slot);
+        }
+#endif
+
+    public:
+        /**
+         * @brief Starts reading files in the background.
+         * @param paths The files to read, in the order next() returns them.
+         * @param queue_depth Maximum number of reads in flight (and of files read ahead).
+         * @param backend io_uring, the thread pool, or AUTO to use io_uring when the kernel allows it.
+         * @throws std::runtime_error If IO_URING is requested but unavailable.
+         */
+        explicit FileReader(const std::vector<std::string>& paths, size_t queue_depth = DEFAULT_QUEUE_DEPTH,
+                            Backend backend = Backend::AUTO)
+            : files(paths.size()), depth(std::max<size_t>(queue_depth, 1)) {
+            for (size_t i = 0; i < paths.size(); ++i) files[i].path = paths[i];
+#ifdef DAEDALUS_HAVE_IO_URING
+            if (backend != Backend::THREADS) {
+                ring = std::make_unique<Ring>(static_cast<unsigned>(depth));
+                if (ring->ok()) {
+                    slots.resize(depth);
+                    slot_iov.resize(depth);
+                    for (size_t s = depth; s-- > 0;) free_slots.push_back(s);
+                    return;
+                }
+                ring.reset();
+            }
+#endif
+            if (backend == Backend::IO_URING) throw std::runtime_error("io_uring is not available.");
+            size_t n_workers = std::min(depth, paths.size());
+            for (size_t t = 0; t < n_workers; ++t) workers.emplace_back([this] { worker(); });
+        }
+
+        FileReader(const FileReader&) = delete;
+        FileReader& operator=(const FileReader&) = delete;
+
+        /** @brief Stops the readers; reads already submitted are waited for before buffers are freed. */
+        ~FileReader() {
+#ifdef DAEDALUS_HAVE_IO_URING
+            if (ring) {
+                try {
+                    while (free_slots.size() < slots.size()) {
+                        ring->submit_and_wait(1);
+                        ring->reap([&](uint64_t slot, int) { free_slots.push_back(static_cast<size_t>(slot)); });
+                    }
+                } catch (...) {
+                    // Leak the buffers of reads that can no longer be waited for
+                    for (auto& f : files) f.buffer.data.release();
+                }
+            }
+#endif
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            work_available.notify_all();
+            for (auto& t : workers) t.join();
+            for (auto& f : files) close_file(f);
+        }
+
+        /** @brief Returns true if reads go through io_uring rather than the thread pool. */
+        bool uses_io_uring() const {
+#ifdef DAEDALUS_HAVE_IO_URING
+            return ring != nullptr;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Waits for the next file and returns its contents.
+         * @return The buffer, or nullopt after the last file.
+         * @throws std::runtime_error If the file could not be opened or read.
+         */
+        std::optional<Buffer> next() {
+            if (consumed == files.size()) return std::nullopt;
+            FileState& f = files[consumed];
+#ifdef DAEDALUS_HAVE_IO_URING
+            if (ring) {
+                while (!f.complete) pump();
+                ++consumed;
+                if (!f.error.empty()) throw std::runtime_error(f.error);
+                return std::move(f.buffer);
+            }
+#endif
+            std::unique_lock<std::mutex> lock(mutex);
+            file_done.wait(lock, [&] { return f.complete; });
+            ++consumed;
+            work_available.notify_all();
+            if (!f.error.empty()) throw std::runtime_error(f.error);
+            return std::move(f.buffer);
+        }
+    };
+}
+
+#endif // ASYNCIO_H
@@ -0,0 +1,553 @@
+/**
+ * @file Column.h
+ * @brief Typed column storage used by the DataFrame.
+ * * A Column keeps its values in a single contiguous buffer of the narrowest
+ * physical type that can represent them. Columns that mix types fall back to
+ * a buffer of variants so that no information is lost.
+ */
+
+// include/daedalus/core/Column.h
+
+#ifndef COLUMN_H
+#define COLUMN_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <variant>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+/** @brief Type alias for the value held in a single DataFrame cell. */
+using Cell = std::variant<double, int, std::string>;
+
+/**
+ * @enum DType
+ * @brief Physical storage type of a Column.
+ */
+enum class DType {
+    FLOAT64,    ///< Contiguous buffer of double.
+    INT32,      ///< Contiguous buffer of int.
+    STRING,     ///< Contiguous buffer of std::string.
+    MIXED,      ///< Buffer of Cell variants (heterogeneous column).
+    INT64,      ///< Contiguous buffer of int64_t.
+    BOOL,       ///< Contiguous buffer of bytes holding 0 or 1.
+    CATEGORY    ///< int32 codes into a dictionary of distinct strings.
+};
+
+/**
+ * @brief Returns a printable name for a DType.
+ * @param dtype The storage type.
+ * @return The lower-case name of the type (e.g. "float64").
+ */
+inline std::string dtype_name(DType dtype) {
+    switch (dtype) {
+        case DType::FLOAT64: return "float64";
+        case DType::INT32: return "int32";
+        case DType::STRING: return "string";
+        case DType::INT64: return "int64";
+        case DType::BOOL: return "bool";
+        case DType::CATEGORY: return "category";
+        default: return "mixed";
+    }
+}
+
+/**
+ * @brief Parses a type name as accepted by dtype_name (plus a few common aliases).
+ * @param name The type name, e.g. "int64", "float", "str" or "category".
+ * @return The matching DType.
+ * @throws std::invalid_argument If the name is not recognised.
+ */
+inline DType parse_dtype(const std::string& name) {
+    if (name == "float64" || name == "float" || name == "double") return DType::FLOAT64;
+    if (name == "int32" || name == "int") return DType::INT32;
+    if (name == "int64") return DType::INT64;
+    if (name == "bool") return DType::BOOL;
+    if (name == "string" || name == "str") return DType::STRING;
+    if (name == "category") return DType::CATEGORY;
+    if (name == "mixed") return DType::MIXED;
+    throw std::invalid_argument("Unknown dtype: " + name);
+}
+
+/**
+ * @class Column
+ * @brief A single typed DataFrame column.
+ * * Exactly one of the internal buffers is active at a time, selected by the
+ * column's DType. Whole-column operations (copy, gather, promotion) dispatch
+ * on the DType once and then run a tight loop over the typed buffer.
+ * * Missing values are tracked in an optional null bitmap (one bit per row,
+ * allocated on the first null). A null slot in a float64 buffer holds NaN,
+ * and null cells are reported as NaN by get() and as_double().
+ */
+class Column {
+    DType dtype = DType::FLOAT64;
+    std::vector<double> f64;
+    std::vector<int> i32;
+    std::vector<std::string> str;
+    std::vector<Cell> mixed;
+    std::vector<int64_t> i64;
+    std::vector<uint8_t> b8;
+    std::vector<std::string> dictionary;
+    std::vector<uint64_t> nulls;
+
+    /** @brief Returns the index of each dictionary entry, keyed by value. */
+    std::unordered_map<std::string, int> dictionary_index() const {
+        std::unordered_map<std::string, int> index;
+        index.reserve(dictionary.size());
+        for (size_t c = 0; c < dictionary.size(); ++c) index.emplace(dictionary[c], static_cast<int>(c));
+        return index;
+    }
+
+public:
+    /** @brief Default constructor creating an empty float64 Column. */
+    Column() = default;
+
+    /** @brief Creates an empty Column of the given type. */
+    explicit Column(DType type) : dtype(type) {}
+
+    /** @brief Creates a float64 Column that takes ownership of the values. */
+    explicit Column(std::vector<double> values) : dtype(DType::FLOAT64), f64(std::move(values)) {}
+
+    /** @brief Creates an int32 Column that takes ownership of the values. */
+    explicit Column(std::vector<int> values) : dtype(DType::INT32), i32(std::move(values)) {}
+
+    /** @brief Creates a string Column that takes ownership of the values. */
+    explicit Column(std::vector<std::string> values) : dtype(DType::STRING), str(std::move(values)) {}
+
+    /** @brief Creates an int64 Column that takes ownership of the values. */
+    explicit Column(std::vector<int64_t> values) : dtype(DType::INT64), i64(std::move(values)) {}
+
+    /**
+     * @brief Builds a Column from a vector of cells, choosing the narrowest storage.
+     * * If every cell holds the same alternative the matching typed buffer is
+     * used, otherwise the cells are kept as variants.
+     * @param cells The cell values.
+     * @return The resulting Column.
+     */
+    static Column from_cells(const std::vector<Cell>& cells) {
+        if (cells.empty()) return Column();
+
+        size_t first = cells[0].index();
+        bool uniform = true;
+        for (const auto& cell : cells) {
+            if (cell.index() != first) { uniform = false; break; }
+        }
+
+        Column result;
+        if (!uniform) {
+            result.dtype = DType::MIXED;
+            result.mixed = cells;
+            return result;
+        }
+
+        if (first == 0) {
+            result.dtype = DType::FLOAT64;
+            result.f64.reserve(cells.size());
+            for (const auto& cell : cells) result.f64.push_back(std::get<double>(cell));
+        } else if (first == 1) {
+            result.dtype = DType::INT32;
+            result.i32.reserve(cells.size());
+            for (const auto& cell : cells) result.i32.push_back(std::get<int>(cell));
+        } else {
+            result.dtype = DType::STRING;
+            result.str.reserve(cells.size());
+            for (const auto& cell : cells) result.str.push_back(std::get<std::string>(cell));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the type two columns must share to be stored together.
+     * * Identical types are kept. int32 and int64 widen to int64, any other pair
+     * of int32, int64 and float64 widens to float64, category and string widen
+     * to string, and every other combination falls back to MIXED.
+     */
+    static DType promote(DType a, DType b) {
+        if (a == b) return a;
+        auto is_int = [](DType t) { return t == DType::INT32 || t == DType::INT64; };
+        auto is_num = [&](DType t) { return is_int(t) || t == DType::FLOAT64; };
+        auto is_text = [](DType t) { return t == DType::STRING || t == DType::CATEGORY; };
+        if (is_int(a) && is_int(b)) return DType::INT64;
+        if (is_num(a) && is_num(b)) return DType::FLOAT64;
+        if (is_text(a) && is_text(b)) return DType::STRING;
+        return DType::MIXED;
+    }
+
+    /** @brief Returns the storage type of the Column. */
+    DType type() const { return dtype; }
+
+    /** @brief Returns the number of values in the Column. */
+    size_t size() const {
+        switch (dtype) {
+            case DType::FLOAT64: return f64.size();
+            case DType::INT32: case DType::CATEGORY: return i32.size();
+            case DType::STRING: return str.size();
+            case DType::INT64: return i64.size();
+            case DType::BOOL: return b8.size();
+            default: return mixed.size();
+        }
+    }
+
+    /** @brief Returns the number of values the active buffer can hold without reallocating. */
+    size_t capacity() const {
+        switch (dtype) {
+            case DType::FLOAT64: return f64.capacity();
+            case DType::INT32: case DType::CATEGORY: return i32.capacity();
+            case DType::STRING: return str.capacity();
+            case DType::INT64: return i64.capacity();
+            case DType::BOOL: return b8.capacity();
+            default: return mixed.capacity();
+        }
+    }
+
+    /** @brief Reserves room for n values in the active buffer. */
+    void reserve(size_t n) {
+        switch (dtype) {
+            case DType::FLOAT64: f64.reserve(n); break;
+            case DType::INT32: case DType::CATEGORY: i32.reserve(n); break;
+            case DType::STRING: str.reserve(n); break;
+            case DType::INT64: i64.reserve(n); break;
+            case DType::BOOL: b8.reserve(n); break;
+            default: mixed.reserve(n); break;
+        }
+    }
+
+    /** @brief Resizes the active buffer to n values. */
+    void resize(size_t n) {
+        switch (dtype) {
+            case DType::FLOAT64: f64.resize(n); break;
+            case DType::INT32: case DType::CATEGORY: i32.resize(n); break;
+            case DType::STRING: str.resize(n); break;
+            case DType::INT64: i64.resize(n); break;
+            case DType::BOOL: b8.resize(n); break;
+            default: mixed.resize(n); break;
+        }
+        if (nulls.size() > (n + 63) / 64) {
+            nulls.resize((n + 63) / 64);
+            if (n % 64 != 0 && !nulls.empty()) nulls.back() &= (uint64_t(1) << (n % 64)) - 1;
+        }
+    }
+
+    /** @brief Read-only access to the float64 buffer. */
+    const std::vector<double>& doubles() const { return f64; }
+    /** @brief Read-only access to the int32 buffer (the codes of a category column). */
+    const std::vector<int>& ints() const { return i32; }
+    /** @brief Read-only access to the string buffer. */
+    const std::vector<std::string>& strings() const { return str; }
+    /** @brief Read-only access to the variant buffer of a MIXED column. */
+    const std::vector<Cell>& cells() const { return mixed; }
+    /** @brief Read-only access to the int64 buffer. */
+    const std::vector<int64_t>& int64s() const { return i64; }
+    /** @brief Read-only access to the bool buffer (one byte per value). */
+    const std::vector<uint8_t>& bools() const { return b8; }
+    /** @brief Read-only access to the dictionary of a category column. */
+    const std::vector<std::string>& categories() const { return dictionary; }
+
+    /** @brief Mutable access to the float64 buffer. */
+    std::vector<double>& doubles() { return f64; }
+    /** @brief Mutable access to the int32 buffer (the codes of a category column). */
+    std::vector<int>& ints() { return i32; }
+    /** @brief Mutable access to the string buffer. */
+    std::vector<std::string>& strings() { return str; }
+    /** @brief Mutable access to the variant buffer of a MIXED column. */
+    std::vector<Cell>& cells() { return mixed; }
+    /** @brief Mutable access to the int64 buffer. */
+    std::vector<int64_t>& int64s() { return i64; }
+    /** @brief Mutable access to the bool buffer (one byte per value). */
+    std::vector<uint8_t>& bools() { return b8; }
+    /** @brief Mutable access to the dictionary of a category column. */
+    std::vector<std::string>& categories() { return dictionary; }
+
+    /** @brief Read-only access to the null bitmap (bit i set = row i is null; may be shorter than the column). */
+    const std::vector<uint64_t>& null_mask() const { return nulls; }
+    /** @brief Mutable access to the null bitmap; it must not hold more than (size() + 63) / 64 words. */
+    std::vector<uint64_t>& null_mask() { return nulls; }
+
+    /** @brief Returns true if row i is null. */
+    bool is_null(size_t i) const {
+        size_t word = i >> 6;
+        return word < nulls.size() && ((nulls[word] >> (i & 63)) & 1);
+    }
+
+    /** @brief Returns true if the Column holds at least one null. */
+    bool has_nulls() const {
+        for (uint64_t word : nulls) {
+            if (word) return true;
+        }
+        return false;
+    }
+
+    /** @brief Returns the number of null rows. */
+    size_t null_count() const {
+        size_t count = 0;
+        for (uint64_t word : nulls) {
+            for (; word; word &= word - 1) ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Marks row i as null (or valid), allocating the bitmap on first use.
+     * * Only the bitmap is changed; callers store a placeholder value in the buffer.
+     */
+    void set_null(size_t i, bool null = true) {
+        size_t word = i >> 6;
+        if (word >= nulls.size()) {
+            if (!null) return;
+            nulls.resize(std::max(word + 1, (size() + 63) / 64), 0);
+        }
+        if (null) nulls[word] |= uint64_t(1) << (i & 63);
+        else nulls[word] &= ~(uint64_t(1) << (i & 63));
+    }
+
+    /**
+     * @brief Appends a null value with a type-appropriate placeholder (NaN, 0, "" or code 0).
+     */
+    void push_null() {
+        size_t i = size();
+        switch (dtype) {
+            case DType::FLOAT64: f64.push_back(std::numeric_limits<double>::quiet_NaN()); break;
+            case DType::INT32: case DType::CATEGORY: i32.push_back(0); break;
+            case DType::STRING: str.emplace_back(); break;
+            case DType::INT64: i64.push_back(0); break;
+            case DType::BOOL: b8.push_back(0); break;
+            default: mixed.emplace_back(std::numeric_limits<double>::quiet_NaN()); break;
+        }
+        set_null(i);
+    }
+
+    /**
+     * @brief Returns the value at index i as a Cell.
+     * * int64 values that fit in an int are returned as int (as double otherwise),
+     * bools as 0 or 1, categories as their string and nulls as NaN.
+     * @param i The row index (unchecked).
+     */
+    Cell get(size_t i) const {
+        if (is_null(i)) return std::numeric_limits<double>::quiet_NaN();
+        switch (dtype) {
+            case DType::FLOAT64: return f64[i];
+            case DType::INT32: return i32[i];
+            case DType::STRING: return str[i];
+            case DType::INT64:
+                if (i64[i] >= std::numeric_limits<int>::min() && i64[i] <= std::numeric_limits<int>::max()) {
+                    return static_cast<int>(i64[i]);
+                }
+                return static_cast<double>(i64[i]);
+            case DType::BOOL: return static_cast<int>(b8[i]);
+            case DType::CATEGORY: return dictionary[i32[i]];
+            default: return mixed[i];
+        }
+    }
+
+    /**
+     * @brief Returns the value at index i as a double.
+     * * Strings and categories are converted to 0.0, matching DataFrame::to_matrix.
+     * Nulls are returned as NaN.
+     * @param i The row index (unchecked).
+     */
+    double as_double(size_t i) const {
+        if (is_null(i)) return std::numeric_limits<double>::quiet_NaN();
+        switch (dtype) {
+            case DType::FLOAT64: return f64[i];
+            case DType::INT32: return static_cast<double>(i32[i]);
+            case DType::INT64: return static_cast<double>(i64[i]);
+            case DType::BOOL: return static_cast<double>(b8[i]);
+            case DType::STRING: case DType::CATEGORY: return 0.0;
+            default:
+                return std::visit([](auto&& arg) -> double {
+                    using T = std::decay_t<decltype(arg)>;
+                    if constexpr (std::is_arithmetic_v<T>) return static_cast<double>(arg);
+                    return 0.0;
+                }, mixed[i]);
+        }
+    }
+
+    /** @brief Returns all values as a vector of cells. */
+    std::vector<Cell> to_cells() const {
+        std::vector<Cell> result;
+        result.reserve(size());
+        for (size_t i = 0; i < size(); ++i) result.push_back(get(i));
+        return result;
+    }
+
+    /**
+     * @brief Returns a copy of the Column converted to another storage type.
+     * * Only widening conversions are supported: int32 to int64, integers and
+     * bools to float64, string to category and back, and any type to MIXED.
+     * @param target The storage type to convert to.
+     * @throws std::invalid_argument If the conversion would lose information.
+     */
+    Column cast(DType target) const {
+        if (target == dtype) return *this;
+        Column result(target);
+        if (target == DType::CATEGORY) result.merge_categories(*this);
+        result.resize(size());
+        result.copy_from(*this, 0);
+        result.copy_nulls_from(*this, 0);
+        return result;
+    }
+
+    /**
+     * @brief Adds the distinct values of another string or category Column to the dictionary.
+     * * Must be called on a category Column before copy_from() with a source
+     * whose values are not yet in the dictionary. Existing codes are unchanged.
+     * @param src The string or category Column whose values are added.
+     */
+    void merge_categories(const Column& src) {
+        if (dtype != DType::CATEGORY) return;
+        std::unordered_map<std::string, int> index = dictionary_index();
+        auto add = [&](const std::string& value) {
+            if (index.emplace(value, static_cast<int>(dictionary.size())).second) dictionary.push_back(value);
+        };
+        if (src.dtype == DType::CATEGORY) {
+            for (const auto& value : src.dictionary) add(value);
+        } else if (src.dtype == DType::STRING) {
+            for (size_t i = 0; i < src.str.size(); ++i) {
+                if (!src.is_null(i)) add(src.str[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Copies every value of src into this Column starting at offset.
+     * * The Column must already be sized to hold the copied range. When the
+     * types differ, src is widened on the fly (see cast). Only values are
+     * copied; use copy_nulls_from for the null bitmap. Different calls may
+     * therefore write disjoint ranges in parallel.
+     * @param src The Column to copy from.
+     * @param offset The index of the first value to overwrite.
+     * @throws std::invalid_argument If src cannot be widened to this Column's type.
+     */
+    void copy_from(const Column& src, size_t offset) {
+        size_t n = src.size();
+        if (n == 0) return;
+        if (offset + n > size()) throw std::out_of_range("Column copy exceeds destination size.");
+
+        if (src.dtype == dtype && dtype != DType::CATEGORY) {
+            switch (dtype) {
+                case DType::FLOAT64: std::copy(src.f64.begin(), src.f64.end(), f64.begin() + offset); break;
+                case DType::INT32: std::copy(src.i32.begin(), src.i32.end(), i32.begin() + offset); break;
+                case DType::STRING: std::copy(src.str.begin(), src.str.end(), str.begin() + offset); break;
+                case DType::INT64: std::copy(src.i64.begin(), src.i64.end(), i64.begin() + offset); break;
+                case DType::BOOL: std::copy(src.b8.begin(), src.b8.end(), b8.begin() + offset); break;
+                default: std::copy(src.mixed.begin(), src.mixed.end(), mixed.begin() + offset); break;
+            }
+            return;
+        }
+
+        bool src_int = (src.dtype == DType::INT32 || src.dtype == DType::INT64 || src.dtype == DType::BOOL);
+        if (dtype == DType::MIXED) {
+            for (size_t i = 0; i < n; ++i) mixed[offset + i] = src.get(i);
+        } else if (dtype == DType::FLOAT64 && src_int) {
+            for (size_t i = 0; i < n; ++i) f64[offset + i] = src.as_double(i);
+        } else if (dtype == DType::INT64 && src.dtype == DType::INT32) {
+            for (size_t i = 0; i < n; ++i) i64[offset + i] = src.i32[i];
+        } else if (dtype == DType::STRING && src.dtype == DType::CATEGORY) {
+            for (size_t i = 0; i < n; ++i) str[offset + i] = src.is_null(i) ? std::string() : src.dictionary[src.i32[i]];
+        } else if (dtype == DType::CATEGORY && (src.dtype == DType::CATEGORY || src.dtype == DType::STRING)) {
+            std::unordered_map<std::string, int> index = dictionary_index();
+            auto code_of = [&](const std::string& value) {
+                auto it = index.find(value);
+                if (it == index.end()) throw std::invalid_argument("Category not in dictionary: " + value);
+                return it->second;
+            };
+            if (src.dtype == DType::CATEGORY) {
+                std::vector<int> remap(src.dictionary.size());
+                for (size_t c = 0; c < remap.size(); ++c) remap[c] = code_of(src.dictionary[c]);
+                for (size_t i = 0; i < n; ++i) i32[offset + i] = src.is_null(i) ? 0 : remap[src.i32[i]];
+            } else {
+                for (size_t i = 0; i < n; ++i) i32[offset + i] = src.is_null(i) ? 0 : code_of(src.str[i]);
+            }
+        } else {
+            throw std::invalid_argument("Cannot convert " + dtype_name(src.dtype) + " column to " + dtype_name(dtype) + ".");
+        }
+    }
+
+    /**
+     * @brief Copies the null bitmap of src into this Column starting at offset.
+     * * Not safe to call concurrently on the same Column, since neighbouring
+     * ranges can share a bitmap word.
+     * @param src The Column whose nulls are copied.
+     * @param offset The index of the first row of the copied range.
+     */
+    void copy_nulls_from(const Column& src, size_t offset) {
+        for (size_t word = 0; word < src.nulls.size(); ++word) {
+            uint64_t bits = src.nulls[word];
+            for (size_t bit = 0; bits; ++bit, bits >>= 1) {
+                if (bits & 1) set_null(offset + word * 64 + bit);
+            }
+        }
+    }
+
+    /**
+     * @brief Appends every value of src, widening this Column first if required.
+     * * Capacity grows geometrically so that repeated appends are amortized O(1) per row.
+     * @param src The Column to append.
+     */
+    void append(const Column& src) {
+        DType target = promote(dtype, src.dtype);
+        if (size() == 0) target = src.dtype;
+        if (target != dtype) *this = cast(target);
+        merge_categories(src);
+
+        size_t old_size = size();
+        size_t new_size = old_size + src.size();
+        if (new_size > capacity()) reserve(std::max(new_size, capacity() * 2));
+        resize(new_size);
+        copy_from(src, old_size);
+        copy_nulls_from(src, old_size);
+    }
+
+    /**
+     * @brief Creates a new Column containing the values at the given indices.
+     * @param indices Row indices to gather, in output order (unchecked).
+     */
+    Column take(const std::vector<size_t>& indices) const {
+        Column result(dtype);
+        result.dictionary = dictionary;
+        result.reserve(indices.size());
+        switch (dtype) {
+            case DType::FLOAT64: for (size_t idx : indices) result.f64.push_back(f64[idx]); break;
+            case DType::INT32: case DType::CATEGORY: for (size_t idx : indices) result.i32.push_back(i32[idx]); break;
+            case DType::STRING: for (size_t idx : indices) result.str.push_back(str[idx]); break;
+            case DType::INT64: for (size_t idx : indices) result.i64.push_back(i64[idx]); break;
+            case DType::BOOL: for (size_t idx : indices) result.b8.push_back(b8[idx]); break;
+            default: for (size_t idx : indices) result.mixed.push_back(mixed[idx]); break;
+        }
+        if (!nulls.empty()) {
+            for (size_t k = 0; k < indices.size(); ++k) {
+                if (is_null(indices[k])) result.set_null(k);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Creates a new Column with the values in [begin, end).
+     * @param begin The first row index.
+     * @param end One past the last row index.
+     */
+    Column slice(size_t begin, size_t end) const {
+        Column result(dtype);
+        result.dictionary = dictionary;
+        switch (dtype) {
+            case DType::FLOAT64: result.f64.assign(f64.begin() + begin, f64.begin() + end); break;
+            case DType::INT32: case DType::CATEGORY: result.i32.assign(i32.begin() + begin, i32.begin() + end); break;
+            case DType::STRING: result.str.assign(str.begin() + begin, str.begin() + end); break;
+            case DType::INT64: result.i64.assign(i64.begin() + begin, i64.begin() + end); break;
+            case DType::BOOL: result.b8.assign(b8.begin() + begin, b8.begin() + end); break;
+            default: result.mixed.assign(mixed.begin() + begin, mixed.begin() + end); break;
+        }
+        if (!nulls.empty()) {
+            for (size_t i = begin; i < end; ++i) {
+                if (is_null(i)) result.set_null(i - begin);
+            }
+        }
+        return result;
+    }
+};
+
+#endif // COLUMN_H
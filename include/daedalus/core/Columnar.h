@@ -0,0 +1,922 @@
+/**
+ * @file Columnar.h
+ * @brief The Daedalus columnar file format (.dcol): chunked, typed columns with a schema footer.
+ * * @section dcol_layout File Layout:
+ * All integers and floats are little-endian.
+ * @code
+ *   "DCOL0001"                      8-byte magic
+ *   column data                     the buffers of every column chunk (see below)
+ *   footer                          schema, chunk locations and statistics
+ *   uint64 footer_size
+ *   "DCOL0001"
+ * @endcode
+ * Each column is split into chunks of @c chunk_rows rows (a multiple of 64).
+ * A chunk has a values buffer and, if it contains nulls, a null bitmap of
+ * ceil(rows / 64) uint64 words (bit i set = row i is null). Values are stored
+ * as float64, int32 (also category codes), int64 or one byte per bool. String
+ * values are uint64 offsets[rows + 1] followed by the concatenated bytes, and
+ * mixed values use the same layout where each entry is a tag byte (0 = float64,
+ * 1 = int32, 2 = string) followed by its payload.
+ *
+ * Every buffer records its codec: 0 = stored, 1 = LZ4 block, 2 = byte shuffle
+ * then LZ4 block (fixed-width values only). The values of a column start on a
+ * 64-byte boundary, and the stored chunks of a fixed-width column follow each
+ * other without gaps, so an uncompressed numeric column is one contiguous
+ * array inside the file that can be used in place from the memory mapping.
+ *
+ * The footer is a flat sequence of fields (strings are uint32 length + bytes):
+ * @code
+ *   uint32 version, uint64 rows, uint64 chunk_rows, uint32 n_columns
+ *   per column:  string name, uint8 dtype (DType value), uint32 n_dictionary, strings,
+ *                uint32 n_chunks
+ *   per chunk:   uint64 rows, buffer values, buffer nulls,
+ *                uint64 null_count, uint8 has_range, float64 min, float64 max
+ *   buffer:      uint8 codec, uint64 offset, uint64 stored_size, uint64 raw_size
+ * @endcode
+ * A null buffer with raw_size 0 means the chunk has no nulls. min and max are
+ * taken over the non-null, non-NaN values of numeric columns, and let readers
+ * skip chunks that cannot satisfy a predicate. tools/dcol_reader.py is a
+ * dependency-free Python reader of this layout.
+ */
+
+// include/daedalus/core/Columnar.h
+
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include <stdexcept>
+#include "Column.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+
+/**
+ * @namespace Dcol
+ * @brief Writer and memory-mapped reader of the .dcol columnar format.
+ */
+namespace Dcol {
+    constexpr char MAGIC[8] = {'D', 'C', 'O', 'L', '0', '0', '0', '1'};
+    constexpr uint32_t VERSION = 1;
+    constexpr size_t ALIGNMENT = 64;
+
+    /** @brief How a buffer is stored in the file. */
+    enum class Codec : uint8_t {
+        NONE = 0,           ///< Raw bytes.
+        LZ4 = 1,            ///< LZ4 block format.
+        SHUFFLE_LZ4 = 2     ///< Bytes grouped by significance (byte shuffle), then LZ4.
+    };
+
+    /**
+     * @namespace Dcol::Lz4
+     * @brief A self-contained LZ4 block-format codec.
+     * * The compressor is a single-pass greedy matcher over a 64K-entry hash
+     * table of 4-byte sequences; its output is a standard LZ4 block, so files
+     * can also be decoded with any LZ4 library.
+     */
+    namespace Lz4 {
+        /** @brief Returns an upper bound of the compressed size of n bytes. */
+        inline size_t max_compressed_size(size_t n) { return n + n / 255 + 16; }
+
+        /** @brief Appends an LZ4 length continuation (runs of 255 then the remainder). */
+        inline uint8_t* write_length(uint8_t* op, size_t len) {
+            while (len >= 255) {
+                *op++ = 255;
+                len -= 255;
+            }
+            *op++ = static_cast<uint8_t>(len);
+            return op;
+        }
+
+        /**
+         * @brief Compresses [src, src + n) into dst.
+         * @param dst Output buffer of at least max_compressed_size(n) bytes.
+         * @return The number of bytes written.
+         */
+        inline size_t compress(const uint8_t* src, size_t n, uint8_t* dst) {
+            constexpr size_t MIN_MATCH = 4, LAST_LITERALS = 5, MATCH_FIND_LIMIT = 12;
+            uint8_t* op = dst;
+            const uint8_t* anchor = src;
+            const uint8_t* src_end = src + n;
+
+            auto read32 = [](const uint8_t* p) {
+                uint32_t v;
+                std::memcpy(&v, p, sizeof(v));
+                return v;
+            };
+            auto emit_literals = [&](size_t literals, size_t match_extra) {
+                uint8_t* token = op++;
+                *token = static_cast<uint8_t>((std::min<size_t>(literals, 15) << 4) | std::min<size_t>(match_extra, 15));
+                if (literals >= 15) op = write_length(op, literals - 15);
+                std::memcpy(op, anchor, literals);
+                op += literals;
+            };
+
+            if (n > MATCH_FIND_LIMIT) {
+                std::vector<uint32_t> table(size_t(1) << 16, 0);
+                const uint8_t* ip = src + 1;
+                const uint8_t* match_limit = src_end - MATCH_FIND_LIMIT;
+                const uint8_t* match_end_limit = src_end - LAST_LITERALS;
+                size_t misses = 0;
+                while (ip < match_limit) {
+                    uint32_t sequence = read32(ip);
+                    size_t h = (sequence * 2654435761u) >> 16;
+                    const uint8_t* ref = src + table[h];
+                    table[h] = static_cast<uint32_t>(ip - src);
+                    if (ref >= ip || ip - ref > 65535 || read32(ref) != sequence) {
+                        ip += 1 + (misses++ >> 6);
+                        continue;
+                    }
+                    misses = 0;
+
+                    while (ip > anchor && ref > src && ip[-1] == ref[-1]) { --ip; --ref; }
+                    const uint8_t* mp = ip + MIN_MATCH;
+                    const uint8_t* rp = ref + MIN_MATCH;
+                    while (mp < match_end_limit && *mp == *rp) { ++mp; ++rp; }
+
+                    size_t match_extra = static_cast<size_t>(mp - ip) - MIN_MATCH;
+                    emit_literals(static_cast<size_t>(ip - anchor), match_extra);
+                    uint16_t offset = static_cast<uint16_t>(ip - ref);
+                    *op++ = static_cast<uint8_t>(offset & 0xFF);
+                    *op++ = static_cast<uint8_t>(offset >> 8);
+                    if (match_extra >= 15) op = write_length(op, match_extra - 15);
+                    ip = anchor = mp;
+                }
+            }
+            emit_literals(static_cast<size_t>(src_end - anchor), 0);
+            return static_cast<size_t>(op - dst);
+        }
+
+        /**
+         * @brief Decompresses an LZ4 block that expands to exactly raw_size bytes.
+         * @throws std::runtime_error If the block is corrupt.
+         */
+        inline void decompress(const uint8_t* src, size_t n, uint8_t* dst, size_t raw_size) {
+            const uint8_t* ip = src;
+            const uint8_t* ip_end = src + n;
+            uint8_t* op = dst;
+            uint8_t* op_end = dst + raw_size;
+            auto corrupt = [] { throw std::runtime_error("Corrupt LZ4 block in .dcol file."); };
+            auto read_length = [&](size_t len) {
+                if (len != 15) return len;
+                uint8_t b;
+                do {
+                    if (ip >= ip_end) corrupt();
+                    b = *ip++;
+                    len += b;
+                } while (b == 255);
+                return len;
+            };
+
+            while (ip < ip_end) {
+                uint8_t token = *ip++;
+                size_t literals = read_length(token >> 4);
+                if (literals > static_cast<size_t>(ip_end - ip) || literals > static_cast<size_t>(op_end - op)) corrupt();
+                std::memcpy(op, ip, literals);
+                ip += literals;
+                op += literals;
+                if (ip == ip_end) break;
+
+                if (ip_end - ip < 2) corrupt();
+                size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+                ip += 2;
+                size_t length = read_length(token & 15) + 4;
+                if (offset == 0 || offset > static_cast<size_t>(op - dst) || length > static_cast<size_t>(op_end - op)) corrupt();
+                const uint8_t* match = op - offset;
+                for (size_t i = 0; i < length; ++i) op[i] = match[i];
+                op += length;
+            }
+            if (op != op_end) corrupt();
+        }
+    }
+
+    /** @brief Groups the bytes of n_bytes / width elements by byte position (byte k of every element, then k + 1). */
+    inline void shuffle(const uint8_t* src, size_t n_bytes, size_t width, uint8_t* dst) {
+        size_t n = n_bytes / width;
+        for (size_t b = 0; b < width; ++b) {
+            for (size_t i = 0; i < n; ++i) dst[b * n + i] = src[i * width + b];
+        }
+    }
+
+    /** @brief Inverse of shuffle. */
+    inline void unshuffle(const uint8_t* src, size_t n_bytes, size_t width, uint8_t* dst) {
+        size_t n = n_bytes / width;
+        for (size_t b = 0; b < width; ++b) {
+            for (size_t i = 0; i < n; ++i) dst[i * width + b] = src[b * n + i];
+        }
+    }
+
+    /** @brief Location and encoding of one buffer in the file. */
+    struct Buffer {
+        Codec codec = Codec::NONE;
+        uint64_t offset = 0;
+        uint64_t stored_size = 0;
+        uint64_t raw_size = 0;
+    };
+
+    /** @brief Per-chunk statistics used to skip chunks. */
+    struct ChunkStats {
+        uint64_t null_count = 0;
+        bool has_range = false;     ///< False for non-numeric columns or chunks without numeric values.
+        double min = 0.0;
+        double max = 0.0;
+    };
+
+    /** @brief One chunk of one column. */
+    struct Chunk {
+        uint64_t rows = 0;
+        Buffer values;
+        Buffer nulls;
+        ChunkStats stats;
+    };
+
+    /** @brief Schema and chunk directory of one column. */
+    struct ColumnMeta {
+        std::string name;
+        DType type = DType::FLOAT64;
+        std::vector<std::string> dictionary;
+        std::vector<Chunk> chunks;
+    };
+
+    /** @brief The decoded footer of a file. */
+    struct Footer {
+        uint64_t rows = 0;
+        uint64_t chunk_rows = 0;
+        std::vector<ColumnMeta> columns;
+    };
+
+    /** @brief Returns the element size of a fixed-width type, or 0 for string and mixed. */
+    inline size_t fixed_width(DType type) {
+        switch (type) {
+            case DType::FLOAT64: case DType::INT64: return 8;
+            case DType::INT32: case DType::CATEGORY: return 4;
+            case DType::BOOL: return 1;
+            default: return 0;
+        }
+    }
+
+    /**
+     * @struct Predicate
+     * @brief A comparison of a numeric column against a constant, e.g. {"age", ">=", 18}.
+     * * Null and NaN values never satisfy a predicate.
+     */
+    struct Predicate {
+        std::string column;
+        std::string op;     ///< One of "<", "<=", ">", ">=", "==" or "!=".
+        double value = 0.0;
+
+        /** @brief Throws std::invalid_argument if op is not a supported comparison. */
+        void validate() const {
+            static const char* ops[] = {"<", "<=", ">", ">=", "==", "!="};
+            for (const char* o : ops) {
+                if (op == o) return;
+            }
+            throw std::invalid_argument("Unsupported predicate operator: " + op);
+        }
+
+        /** @brief Returns true if x satisfies the predicate. */
+        bool matches(double x) const {
+            if (std::isnan(x)) return false;
+            if (op == "<") return x < value;
+            if (op == "<=") return x <= value;
+            if (op == ">") return x > value;
+            if (op == ">=") return x >= value;
+            if (op == "==") return x == value;
+            return x != value;
+        }
+
+        /** @brief Returns false only if no row of a chunk with these statistics can satisfy the predicate. */
+        bool may_match(const Chunk& chunk) const {
+            const ChunkStats& s = chunk.stats;
+            if (s.null_count == chunk.rows) return false;
+            if (!s.has_range) return true;
+            if (op == "<") return s.min < value;
+            if (op == "<=") return s.min <= value;
+            if (op == ">") return s.max > value;
+            if (op == ">=") return s.max >= value;
+            if (op == "==") return s.min <= value && value <= s.max;
+            return !(s.min == value && s.max == value);
+        }
+    };
+
+    /** @brief Little-endian serializer for the footer. */
+    class FooterWriter {
+        std::vector<uint8_t> bytes;
+
+    public:
+        template <typename T>
+        void put(T value) {
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+            bytes.insert(bytes.end(), p, p + sizeof(T));
+        }
+
+        void put_string(const std::string& s) {
+            put<uint32_t>(static_cast<uint32_t>(s.size()));
+            bytes.insert(bytes.end(), s.begin(), s.end());
+        }
+
+        void put_buffer(const Buffer& b) {
+            put<uint8_t>(static_cast<uint8_t>(b.codec));
+            put<uint64_t>(b.offset);
+            put<uint64_t>(b.stored_size);
+            put<uint64_t>(b.raw_size);
+        }
+
+        const std::vector<uint8_t>& data() const { return bytes; }
+    };
+
+    /** @brief Bounds-checked deserializer for the footer. */
+    class FooterReader {
+        const uint8_t* p;
+        const uint8_t* end;
+
+    public:
+        FooterReader(const uint8_t* begin, size_t size) : p(begin), end(begin + size) {}
+
+        template <typename T>
+        T get() {
+            if (static_cast<size_t>(end - p) < sizeof(T)) throw std::runtime_error("Truncated .dcol footer.");
+            T value;
+            std::memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return value;
+        }
+
+        std::string get_string() {
+            uint32_t n = get<uint32_t>();
+            if (static_cast<size_t>(end - p) < n) throw std::runtime_error("Truncated .dcol footer.");
+            std::string s(reinterpret_cast<const char*>(p), n);
+            p += n;
+            return s;
+        }
+
+        Buffer get_buffer() {
+            Buffer b;
+            uint8_t codec = get<uint8_t>();
+            if (codec > static_cast<uint8_t>(Codec::SHUFFLE_LZ4)) throw std::runtime_error("Unknown .dcol codec.");
+            b.codec = static_cast<Codec>(codec);
+            b.offset = get<uint64_t>();
+            b.stored_size = get<uint64_t>();
+            b.raw_size = get<uint64_t>();
+            return b;
+        }
+    };
+
+    /** @brief An encoded buffer: either a view of column memory or owned bytes. */
+    struct EncodedBuffer {
+        Codec codec = Codec::NONE;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t raw_size = 0;
+        std::vector<uint8_t> owned;
+
+        /** @brief Stores raw bytes, compressing them when that makes them smaller. */
+        void assign(const uint8_t* raw, size_t n, bool compress, size_t width) {
+            raw_size = n;
+            codec = Codec::NONE;
+            data = raw;
+            size = n;
+            if (!compress || n == 0) return;
+
+            std::vector<uint8_t> shuffled;
+            const uint8_t* input = raw;
+            if (width > 1) {
+                shuffled.resize(n);
+                shuffle(raw, n, width, shuffled.data());
+                input = shuffled.data();
+            }
+            std::vector<uint8_t> packed(Lz4::max_compressed_size(n));
+            packed.resize(Lz4::compress(input, n, packed.data()));
+            if (packed.size() >= n) return;
+            owned = std::move(packed);
+            codec = width > 1 ? Codec::SHUFFLE_LZ4 : Codec::LZ4;
+            data = owned.data();
+            size = owned.size();
+        }
+
+        /** @brief Takes ownership of raw bytes, compressing them when that makes them smaller. */
+        void assign(std::vector<uint8_t> raw, bool compress) {
+            assign(raw.data(), raw.size(), compress, 1);
+            if (codec == Codec::NONE) {
+                owned = std::move(raw);
+                data = owned.data();
+            }
+        }
+    };
+
+    /** @brief Serializes rows [lo, hi) of a string or mixed column as offsets followed by payload bytes. */
+    inline std::vector<uint8_t> encode_variable(const Column& col, size_t lo, size_t hi) {
+        size_t n = hi - lo;
+        std::vector<uint64_t> offsets(n + 1, 0);
+        std::vector<uint8_t> payload;
+        for (size_t i = lo; i < hi; ++i) {
+            if (col.type() == DType::STRING) {
+                const std::string& s = col.strings()[i];
+                payload.insert(payload.end(), s.begin(), s.end());
+            } else {
+                const Cell& cell = col.cells()[i];
+                payload.push_back(static_cast<uint8_t>(cell.index()));
+                if (const auto* d = std::get_if<double>(&cell)) {
+                    const uint8_t* p = reinterpret_cast<const uint8_t*>(d);
+                    payload.insert(payload.end(), p, p + sizeof(double));
+                } else if (const auto* v = std::get_if<int>(&cell)) {
+                    int32_t x = *v;
+                    const uint8_t* p = reinterpret_cast<const uint8_t*>(&x);
+                    payload.insert(payload.end(), p, p + sizeof(int32_t));
+                } else {
+                    const std::string& s = std::get<std::string>(cell);
+                    payload.insert(payload.end(), s.begin(), s.end());
+                }
+            }
+            offsets[i - lo + 1] = payload.size();
+        }
+        std::vector<uint8_t> bytes(offsets.size() * sizeof(uint64_t) + payload.size());
+        std::memcpy(bytes.data(), offsets.data(), offsets.size() * sizeof(uint64_t));
+        if (!payload.empty()) std::memcpy(bytes.data() + offsets.size() * sizeof(uint64_t), payload.data(), payload.size());
+        return bytes;
+    }
+
+    /** @brief Computes the null count and numeric range of rows [lo, hi) of a column. */
+    inline ChunkStats chunk_stats(const Column& col, size_t lo, size_t hi) {
+        ChunkStats stats;
+        for (size_t i = lo; i < hi; ++i) stats.null_count += col.is_null(i) ? 1 : 0;
+        if (fixed_width(col.type()) == 0 || col.type() == DType::CATEGORY) return stats;
+
+        double lo_value = std::numeric_limits<double>::infinity();
+        double hi_value = -std::numeric_limits<double>::infinity();
+        for (size_t i = lo; i < hi; ++i) {
+            double x = col.as_double(i);
+            if (std::isnan(x)) continue;
+            lo_value = std::min(lo_value, x);
+            hi_value = std::max(hi_value, x);
+        }
+        if (lo_value > hi_value) return stats;
+        if (col.type() == DType::INT64) {
+            // int64 values beyond 2^53 may round when converted, so widen the range by one ulp
+            const double exact = 9007199254740992.0;
+            if (std::fabs(lo_value) >= exact) lo_value = std::nextafter(lo_value, -std::numeric_limits<double>::infinity());
+            if (std::fabs(hi_value) >= exact) hi_value = std::nextafter(hi_value, std::numeric_limits<double>::infinity());
+        }
+        stats.has_range = true;
+        stats.min = lo_value;
+        stats.max = hi_value;
+        return stats;
+    }
+
+    /**
+     * @brief Writes columns to a .dcol file.
+     * * Chunks are encoded and compressed in parallel and then written in
+     * column order. Uncompressed fixed-width chunks are written straight from
+     * the column buffers.
+     * @param path The output path.
+     * @param names The column names.
+     * @param columns The columns (all of the same length).
+     * @param compression "lz4" (default) or "none".
+     * @param chunk_rows Rows per chunk (rounded up to a multiple of 64).
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     * @throws std::invalid_argument If the arguments are inconsistent or compression is unknown.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    inline void write(const std::string& path, const std::vector<std::string>& names,
+                      const std::vector<const Column*>& columns, const std::string& compression = "lz4",
+                      size_t chunk_rows = 65536, size_t num_threads = 0) {
+        if (names.size() != columns.size()) throw std::invalid_argument("Every column needs a name.");
+        if (compression != "lz4" && compression != "none") {
+            throw std::invalid_argument("Unknown compression: " + compression + " (expected \"lz4\" or \"none\").");
+        }
+        bool compress = compression == "lz4";
+        chunk_rows = std::max<size_t>((chunk_rows + 63) / 64 * 64, 64);
+        size_t rows = columns.empty() ? 0 : columns[0]->size();
+        for (const Column* col : columns) {
+            if (col->size() != rows) throw std::invalid_argument("All columns must have the same length.");
+        }
+
+        size_t n_chunks = (rows + chunk_rows - 1) / chunk_rows;
+        struct Encoded {
+            EncodedBuffer values, nulls;
+            ChunkStats stats;
+        };
+        std::vector<Encoded> encoded(columns.size() * n_chunks);
+
+        Parallel::parallel_for(0, encoded.size(), [&](size_t task) {
+            const Column& col = *columns[task / n_chunks];
+            size_t chunk = task % n_chunks;
+            size_t lo = chunk * chunk_rows, hi = std::min(rows, lo + chunk_rows);
+            Encoded& e = encoded[task];
+            e.stats = chunk_stats(col, lo, hi);
+
+            size_t width = fixed_width(col.type());
+            const uint8_t* raw = nullptr;
+            switch (col.type()) {
+                case DType::FLOAT64: raw = reinterpret_cast<const uint8_t*>(col.doubles().data() + lo); break;
+                case DType::INT32: case DType::CATEGORY: raw = reinterpret_cast<const uint8_t*>(col.ints().data() + lo); break;
+                case DType::INT64: raw = reinterpret_cast<const uint8_t*>(col.int64s().data() + lo); break;
+                case DType::BOOL: raw = col.bools().data() + lo; break;
+                default: break;
+            }
+            if (width > 0) e.values.assign(raw, (hi - lo) * width, compress, width);
+            else e.values.assign(encode_variable(col, lo, hi), compress);
+
+            if (e.stats.null_count > 0) {
+                const std::vector<uint64_t>& mask = col.null_mask();
+                std::vector<uint8_t> words(((hi - lo + 63) / 64) * sizeof(uint64_t), 0);
+                size_t first = lo / 64;
+                size_t available = std::min(words.size() / sizeof(uint64_t), mask.size() - std::min(mask.size(), first));
+                std::memcpy(words.data(), mask.data() + first, available * sizeof(uint64_t));
+                // Clear bits past the end of the last chunk
+                if ((hi - lo) % 64 != 0 && !words.empty()) {
+                    uint64_t last;
+                    std::memcpy(&last, words.data() + words.size() - 8, 8);
+                    last &= (uint64_t(1) << ((hi - lo) % 64)) - 1;
+                    std::memcpy(words.data() + words.size() - 8, &last, 8);
+                }
+                e.nulls.assign(std::move(words), compress);
+            }
+        }, num_threads);
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Could not open file for writing: " + path);
+        uint64_t position = 0;
+        auto write_bytes = [&](const void* p, size_t n) {
+            out.write(static_cast<const char*>(p), static_cast<std::streamsize>(n));
+            position += n;
+        };
+        auto pad_to = [&](size_t alignment) {
+            static const char zeros[ALIGNMENT] = {};
+            size_t pad = (alignment - position % alignment) % alignment;
+            write_bytes(zeros, pad);
+        };
+        auto write_buffer = [&](const EncodedBuffer& e, Buffer& b) {
+            b.codec = e.codec;
+            b.offset = position;
+            b.stored_size = e.size;
+            b.raw_size = e.raw_size;
+            if (e.size > 0) write_bytes(e.data, e.size);
+        };
+
+        Footer footer;
+        footer.rows = rows;
+        footer.chunk_rows = chunk_rows;
+        write_bytes(MAGIC, sizeof(MAGIC));
+        for (size_t c = 0; c < columns.size(); ++c) {
+            ColumnMeta meta;
+            meta.name = names[c];
+            meta.type = columns[c]->type();
+            if (meta.type == DType::CATEGORY) meta.dictionary = columns[c]->categories();
+            meta.chunks.resize(n_chunks);
+
+            // Values first (contiguous when stored raw), then the null bitmaps
+            pad_to(ALIGNMENT);
+            for (size_t k = 0; k < n_chunks; ++k) {
+                const Encoded& e = encoded[c * n_chunks + k];
+                if (e.values.codec != Codec::NONE || fixed_width(meta.type) == 0) pad_to(8);
+                meta.chunks[k].rows = std::min(rows - k * chunk_rows, chunk_rows);
+                meta.chunks[k].stats = e.stats;
+                write_buffer(e.values, meta.chunks[k].values);
+            }
+            for (size_t k = 0; k < n_chunks; ++k) {
+                const Encoded& e = encoded[c * n_chunks + k];
+                if (e.nulls.raw_size == 0) continue;
+                pad_to(8);
+                write_buffer(e.nulls, meta.chunks[k].nulls);
+            }
+            footer.columns.push_back(std::move(meta));
+        }
+
+        FooterWriter fw;
+        fw.put<uint32_t>(VERSION);
+        fw.put<uint64_t>(footer.rows);
+        fw.put<uint64_t>(footer.chunk_rows);
+        fw.put<uint32_t>(static_cast<uint32_t>(footer.columns.size()));
+        for (const auto& meta : footer.columns) {
+            fw.put_string(meta.name);
+            fw.put<uint8_t>(static_cast<uint8_t>(meta.type));
+            fw.put<uint32_t>(static_cast<uint32_t>(meta.dictionary.size()));
+            for (const auto& s : meta.dictionary) fw.put_string(s);
+            fw.put<uint32_t>(static_cast<uint32_t>(meta.chunks.size()));
+            for (const auto& chunk : meta.chunks) {
+                fw.put<uint64_t>(chunk.rows);
+                fw.put_buffer(chunk.values);
+                fw.put_buffer(chunk.nulls);
+                fw.put<uint64_t>(chunk.stats.null_count);
+                fw.put<uint8_t>(chunk.stats.has_range ? 1 : 0);
+                fw.put<double>(chunk.stats.min);
+                fw.put<double>(chunk.stats.max);
+            }
+        }
+        uint64_t footer_size = fw.data().size();
+        write_bytes(fw.data().data(), fw.data().size());
+        write_bytes(&footer_size, sizeof(footer_size));
+        write_bytes(MAGIC, sizeof(MAGIC));
+        if (!out) throw std::runtime_error("Could not write file: " + path);
+    }
+
+    /**
+     * @class File
+     * @brief A memory-mapped .dcol file.
+     * * Opening a file only reads its footer. Uncompressed fixed-width columns
+     * can be used in place through values(); read_columns() decodes chunks
+     * into Column objects in parallel, optionally skipping chunks whose
+     * statistics rule out a set of predicates.
+     */
+    class File {
+        MappedFile file;
+        Footer footer;
+        std::unordered_map<std::string, size_t> index;
+
+        /** @brief Returns a pointer to the stored bytes of a buffer, checking that it lies inside the file. */
+        const uint8_t* stored(const Buffer& b) const {
+            if (b.offset > file.size() || b.stored_size > file.size() - b.offset) {
+                throw std::runtime_error("Corrupt .dcol file: buffer out of bounds.");
+            }
+            return reinterpret_cast<const uint8_t*>(file.data()) + b.offset;
+        }
+
+        /** @brief Decodes a buffer into dst, which holds raw_size bytes. */
+        void decode(const Buffer& b, uint8_t* dst, size_t width) const {
+            const uint8_t* src = stored(b);
+            switch (b.codec) {
+                case Codec::NONE:
+                    if (b.stored_size != b.raw_size) throw std::runtime_error("Corrupt .dcol file: size mismatch.");
+                    if (b.raw_size > 0) std::memcpy(dst, src, b.raw_size);
+                    break;
+                case Codec::LZ4:
+                    Lz4::decompress(src, b.stored_size, dst, b.raw_size);
+                    break;
+                case Codec::SHUFFLE_LZ4: {
+                    std::vector<uint8_t> shuffled(b.raw_size);
+                    Lz4::decompress(src, b.stored_size, shuffled.data(), b.raw_size);
+                    unshuffle(shuffled.data(), b.raw_size, std::max<size_t>(width, 1), dst);
+                    break;
+                }
+            }
+        }
+
+        /** @brief Decodes chunk k of a column into rows [offset, offset + rows) of out. */
+        void decode_chunk(const ColumnMeta& meta, const Chunk& chunk, Column& out, size_t offset) const {
+            size_t width = fixed_width(meta.type);
+            if (width > 0 && chunk.values.raw_size != chunk.rows * width) {
+                throw std::runtime_error("Corrupt .dcol file: unexpected buffer size in column " + meta.name);
+            }
+            switch (meta.type) {
+                case DType::FLOAT64: decode(chunk.values, reinterpret_cast<uint8_t*>(out.doubles().data() + offset), width); break;
+                case DType::INT32: case DType::CATEGORY: decode(chunk.values, reinterpret_cast<uint8_t*>(out.ints().data() + offset), width); break;
+                case DType::INT64: decode(chunk.values, reinterpret_cast<uint8_t*>(out.int64s().data() + offset), width); break;
+                case DType::BOOL: decode(chunk.values, out.bools().data() + offset, width); break;
+                default: {
+                    std::vector<uint8_t> bytes(chunk.values.raw_size);
+                    decode(chunk.values, bytes.data(), 1);
+                    size_t header = (chunk.rows + 1) * sizeof(uint64_t);
+                    if (bytes.size() < header) throw std::runtime_error("Corrupt .dcol file: short string buffer.");
+                    std::vector<uint64_t> offsets(chunk.rows + 1);
+                    std::memcpy(offsets.data(), bytes.data(), header);
+                    const char* payload = reinterpret_cast<const char*>(bytes.data() + header);
+                    size_t payload_size = bytes.size() - header;
+                    for (size_t i = 0; i < chunk.rows; ++i) {
+                        if (offsets[i] > offsets[i + 1] || offsets[i + 1] > payload_size) {
+                            throw std::runtime_error("Corrupt .dcol file: bad string offsets.");
+                        }
+                        const char* p = payload + offsets[i];
+                        size_t n = static_cast<size_t>(offsets[i + 1] - offsets[i]);
+                        if (meta.type == DType::STRING) {
+                            out.strings()[offset + i].assign(p, n);
+                            continue;
+                        }
+                        if (n == 0) throw std::runtime_error("Corrupt .dcol file: empty mixed value.");
+                        uint8_t tag = static_cast<uint8_t>(p[0]);
+                        if (tag == 0 && n == 1 + sizeof(double)) {
+                            double d;
+                            std::memcpy(&d, p + 1, sizeof(d));
+                            out.cells()[offset + i] = d;
+                        } else if (tag == 1 && n == 1 + sizeof(int32_t)) {
+                            int32_t v;
+                            std::memcpy(&v, p + 1, sizeof(v));
+                            out.cells()[offset + i] = static_cast<int>(v);
+                        } else if (tag == 2) {
+                            out.cells()[offset + i] = std::string(p + 1, n - 1);
+                        } else {
+                            throw std::runtime_error("Corrupt .dcol file: bad mixed value.");
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Maps a .dcol file and reads its footer.
+         * @throws std::runtime_error If the file cannot be opened or is not a valid .dcol file,
+         * including when its columns are not split into the same chunks.
+         */
+        explicit File(const std::string& path) : file(path) {
+            const size_t trailer = sizeof(uint64_t) + sizeof(MAGIC);
+            const char* data = file.data();
+            if (file.size() < sizeof(MAGIC) + trailer || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0
+                || std::memcmp(data + file.size() - sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0) {
+                throw std::runtime_error("Not a .dcol file: " + path);
+            }
+            uint64_t footer_size;
+            std::memcpy(&footer_size, data + file.size() - trailer, sizeof(footer_size));
+            if (footer_size > file.size() - sizeof(MAGIC) - trailer) throw std::runtime_error("Corrupt .dcol footer: " + path);
+
+            FooterReader reader(reinterpret_cast<const uint8_t*>(data + file.size() - trailer - footer_size),
+                                static_cast<size_t>(footer_size));
+            uint32_t version = reader.get<uint32_t>();
+            if (version != VERSION) throw std::runtime_error("Unsupported .dcol version " + std::to_string(version));
+            footer.rows = reader.get<uint64_t>();
+            footer.chunk_rows = reader.get<uint64_t>();
+            uint32_t n_columns = reader.get<uint32_t>();
+            for (uint32_t c = 0; c < n_columns; ++c) {
+                ColumnMeta meta;
+                meta.name = reader.get_string();
+                uint8_t type = reader.get<uint8_t>();
+                if (type > static_cast<uint8_t>(DType::CATEGORY)) throw std::runtime_error("Unknown dtype in .dcol file.");
+                meta.type = static_cast<DType>(type);
+                uint32_t n_dictionary = reader.get<uint32_t>();
+                for (uint32_t i = 0; i < n_dictionary; ++i) meta.dictionary.push_back(reader.get_string());
+                uint32_t n_chunks = reader.get<uint32_t>();
+                uint64_t total = 0;
+                for (uint32_t k = 0; k < n_chunks; ++k) {
+                    Chunk chunk;
+                    chunk.rows = reader.get<uint64_t>();
+                    chunk.values = reader.get_buffer();
+                    chunk.nulls = reader.get_buffer();
+                    chunk.stats.null_count = reader.get<uint64_t>();
+                    chunk.stats.has_range = reader.get<uint8_t>() != 0;
+                    chunk.stats.min = reader.get<double>();
+                    chunk.stats.max = reader.get<double>();
+                    total += chunk.rows;
+                    meta.chunks.push_back(chunk);
+                }
+                if (total != footer.rows) throw std::runtime_error("Corrupt .dcol file: chunk rows do not add up.");
+                if (!footer.columns.empty()) {
+                    // Chunk k of every column must cover the same rows: select_chunks() and
+                    // read_columns() lay chunks out using the first column's directory.
+                    const auto& first = footer.columns[0].chunks;
+                    bool aligned = first.size() == meta.chunks.size();
+                    for (size_t k = 0; aligned && k < first.size(); ++k) aligned = first[k].rows == meta.chunks[k].rows;
+                    if (!aligned) throw std::runtime_error("Corrupt .dcol file: column " + meta.name + " is chunked differently.");
+                }
+                index[meta.name] = footer.columns.size();
+                footer.columns.push_back(std::move(meta));
+            }
+        }
+
+        /** @brief Returns the number of rows. */
+        size_t rows() const { return static_cast<size_t>(footer.rows); }
+
+        /** @brief Returns the column names in file order. */
+        std::vector<std::string> column_names() const {
+            std::vector<std::string> names;
+            for (const auto& meta : footer.columns) names.push_back(meta.name);
+            return names;
+        }
+
+        /**
+         * @brief Returns the schema and chunk directory of a column.
+         * @throws std::invalid_argument If the column does not exist.
+         */
+        const ColumnMeta& column(const std::string& name) const {
+            auto it = index.find(name);
+            if (it == index.end()) throw std::invalid_argument("Column not found: " + name);
+            return footer.columns[it->second];
+        }
+
+        /**
+         * @brief Returns true if a column is stored uncompressed, fixed-width and without nulls,
+         * so values() can expose it in place.
+         */
+        bool is_zero_copy(const std::string& name) const {
+            const ColumnMeta& meta = column(name);
+            size_t width = fixed_width(meta.type);
+            if (width == 0 || meta.chunks.empty()) return width > 0;
+            uint64_t expected = meta.chunks[0].values.offset;
+            for (const auto& chunk : meta.chunks) {
+                if (chunk.values.codec != Codec::NONE || chunk.stats.null_count > 0 || chunk.values.offset != expected) return false;
+                expected += chunk.values.stored_size;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns a pointer to the values of a column inside the mapping (no copy).
+         * * Valid while the File is alive. Element i is the value of row i, typed
+         * as the column's fixed-width storage type.
+         * @throws std::invalid_argument If the column is compressed, has nulls or is not fixed-width.
+         */
+        const void* values(const std::string& name) const {
+            if (!is_zero_copy(name)) {
+                throw std::invalid_argument("Column " + name + " is compressed, has nulls or is not numeric; "
+                                            "it cannot be viewed in place.");
+            }
+            const ColumnMeta& meta = column(name);
+            if (meta.chunks.empty()) return nullptr;
+            return stored(meta.chunks[0].values);
+        }
+
+        /**
+         * @brief Returns the indices of the chunks whose statistics allow every predicate to match.
+         * @throws std::invalid_argument If a predicate names an unknown or non-numeric column.
+         */
+        std::vector<size_t> select_chunks(const std::vector<Predicate>& predicates) const {
+            size_t n_chunks = footer.columns.empty() ? 0 : footer.columns[0].chunks.size();
+            std::vector<size_t> selected;
+            for (const auto& p : predicates) {
+                p.validate();
+                DType type = column(p.column).type;
+                if (fixed_width(type) == 0 || type == DType::CATEGORY) {
+                    throw std::invalid_argument("Predicates require a numeric column: " + p.column);
+                }
+            }
+            for (size_t k = 0; k < n_chunks; ++k) {
+                bool keep = true;
+                for (const auto& p : predicates) {
+                    if (!p.may_match(column(p.column).chunks[k])) { keep = false; break; }
+                }
+                if (keep) selected.push_back(k);
+            }
+            return selected;
+        }
+
+        /**
+         * @brief Decodes the given chunks of a set of columns.
+         * @param names The columns to decode.
+         * @param chunks Indices of the chunks to decode, in increasing order.
+         * @param num_threads Number of threads (0 means use all hardware threads).
+         * @return One Column per name holding the rows of the selected chunks.
+         */
+        std::vector<Column> read_columns(const std::vector<std::string>& names, const std::vector<size_t>& chunks,
+                                         size_t num_threads = 0) const {
+            std::vector<const ColumnMeta*> metas;
+            for (const auto& name : names) metas.push_back(&column(name));
+
+            std::vector<size_t> offsets(chunks.size() + 1, 0);
+            if (!metas.empty()) {
+                for (size_t j = 0; j < chunks.size(); ++j) {
+                    if (chunks[j] >= metas[0]->chunks.size()) throw std::invalid_argument("Chunk index out of range.");
+                    offsets[j + 1] = offsets[j] + static_cast<size_t>(metas[0]->chunks[chunks[j]].rows);
+                }
+            }
+            size_t total = offsets.back();
+
+            std::vector<Column> out;
+            out.reserve(metas.size());
+            for (const ColumnMeta* meta : metas) {
+                Column col(meta->type);
+                col.resize(total);
+                if (meta->type == DType::CATEGORY) col.categories() = meta->dictionary;
+                out.push_back(std::move(col));
+            }
+
+            // Decode every (column, chunk) pair independently into its final position
+            std::vector<std::vector<uint64_t>> null_words(metas.size() * chunks.size());
+            Parallel::parallel_for(0, metas.size() * chunks.size(), [&](size_t task) {
+                size_t c = task / chunks.size(), j = task % chunks.size();
+                const ColumnMeta& meta = *metas[c];
+                const Chunk& chunk = meta.chunks[chunks[j]];
+                decode_chunk(meta, chunk, out[c], offsets[j]);
+                std::vector<uint64_t>& words = null_words[task];
+                if (chunk.nulls.raw_size > 0) {
+                    words.resize((chunk.nulls.raw_size + 7) / 8, 0);
+                    decode(chunk.nulls, reinterpret_cast<uint8_t*>(words.data()), 1);
+                }
+                if (meta.type == DType::CATEGORY) {
+                    // Codes index the dictionary, so they are checked like string offsets
+                    const int* codes = out[c].ints().data() + offsets[j];
+                    for (size_t i = 0; i < chunk.rows; ++i) {
+                        bool null = (i >> 6) < words.size() && ((words[i >> 6] >> (i & 63)) & 1);
+                        if (!null && (codes[i] < 0 || static_cast<size_t>(codes[i]) >= meta.dictionary.size())) {
+                            throw std::runtime_error("Corrupt .dcol file: bad category code in column " + meta.name);
+                        }
+                    }
+                }
+            }, num_threads);
+
+            // Null bitmaps are shared per column, so they are merged serially
+            for (size_t c = 0; c < metas.size(); ++c) {
+                for (size_t j = 0; j < chunks.size(); ++j) {
+                    const std::vector<uint64_t>& words = null_words[c * chunks.size() + j];
+                    size_t rows = offsets[j + 1] - offsets[j];
+                    for (size_t w = 0; w < words.size(); ++w) {
+                        if (words[w] == 0) continue;
+                        for (size_t bit = 0; bit < 64 && w * 64 + bit < rows; ++bit) {
+                            if ((words[w] >> bit) & 1) out[c].set_null(offsets[j] + w * 64 + bit);
+                        }
+                    }
+                }
+            }
+            return out;
+        }
+    };
+}
+
+#endif // COLUMNAR_H
@@ -0,0 +1,470 @@
+/**
+ * @file Compression.h
+ * @brief Transparent decompression of gzip and zstd input files.
+ * * Compressed files are recognised by their magic bytes, not their names.
+ * Files made of independently compressed pieces whose boundaries and sizes
+ * are known without decoding (BGZF files written by bgzip, and zstd files
+ * with several frames, as written by pzstd or by concatenating .zst files)
+ * are decompressed in parallel. Other gzip streams, including pigz output, are one deflate
+ * stream and are decompressed serially.
+ * * gzip support requires zlib (DAEDALUS_HAVE_ZLIB) and zstd support requires
+ * libzstd (DAEDALUS_HAVE_ZSTD); both are detected by the build.
+ */
+
+// include/daedalus/core/Compression.h
+
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include "MappedFile.h"
+#include "Parallel.h"
+
+#ifdef DAEDALUS_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef DAEDALUS_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+/**
+ * @namespace Compression
+ * @brief Format detection, parallel and streaming decompression of input files.
+ */
+namespace Compression {
+    /** @brief Size of the blocks produced by the streaming decoder. */
+    constexpr size_t STREAM_BLOCK_BYTES = size_t(4) << 20;
+
+    /** @brief The compression formats recognised in input files. */
+    enum class Format { NONE, GZIP, ZSTD };
+
+    /** @brief Returns the compression format of data from its magic bytes. */
+    inline Format detect(const char* data, size_t size) {
+        const auto* p = reinterpret_cast<const uint8_t*>(data);
+        if (size >= 2 && p[0] == 0x1f && p[1] == 0x8b) return Format::GZIP;
+        if (size >= 4 && p[0] == 0x28 && p[1] == 0xb5 && p[2] == 0x2f && p[3] == 0xfd) return Format::ZSTD;
+        return Format::NONE;
+    }
+
+    /** @brief Throws std::runtime_error if the build cannot decode the format. */
+    inline void require_support(Format format) {
+#ifndef DAEDALUS_HAVE_ZLIB
+        if (format == Format::GZIP) throw std::runtime_error("Daedalus was built without gzip (zlib) support.");
+#endif
+#ifndef DAEDALUS_HAVE_ZSTD
+        if (format == Format::ZSTD) throw std::runtime_error("Daedalus was built without zstd support.");
+#endif
+        (void)format;
+    }
+
+    /**
+     * @struct Member
+     * @brief An independently decodable piece of a compressed file.
+     */
+    struct Member {
+        size_t offset = 0;      ///< Position of the piece in the compressed data.
+        size_t size = 0;        ///< Compressed size in bytes.
+        size_t raw_size = 0;    ///< Decompressed size in bytes.
+    };
+
+    /** @brief Reads a little-endian integer of n bytes. */
+    inline uint64_t read_le(const uint8_t* p, size_t n) {
+        uint64_t v = 0;
+        for (size_t i = 0; i < n; ++i) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+    /**
+     * @brief Locates the members of a BGZF file.
+     * * Every BGZF member is a complete gzip member whose extra field holds a
+     * "BC" subfield with its compressed size, and whose trailer holds its
+     * decompressed size, so all members can be found by hopping from header
+     * to header.
+     * @return The members, or an empty vector if the data is not BGZF.
+     */
+    inline std::vector<Member> bgzf_members(const char* data, size_t size) {
+        const auto* p = reinterpret_cast<const uint8_t*>(data);
+        std::vector<Member> members;
+        size_t pos = 0;
+        while (pos < size) {
+            if (size - pos < 18 || p[pos] != 0x1f || p[pos + 1] != 0x8b || p[pos + 2] != 8 || !(p[pos + 3] & 4)) return {};
+            size_t xlen = static_cast<size_t>(read_le(p + pos + 10, 2));
+            size_t block_size = 0;
+            for (size_t x = pos + 12; x + 4 <= pos + 12 + xlen && x + 4 <= size; ) {
+                size_t slen = static_cast<size_t>(read_le(p + x + 2, 2));
+                if (p[x] == 'B' && p[x + 1] == 'C' && slen == 2 && x + 6 <= size) {
+                    block_size = static_cast<size_t>(read_le(p + x + 4, 2)) + 1;
+                }
+                x += 4 + slen;
+            }
+            if (block_size < 18 + xlen || block_size > size - pos) return {};
+            members.push_back({pos, block_size, static_cast<size_t>(read_le(p + pos + block_size - 4, 4))});
+            pos += block_size;
+        }
+        return members;
+    }
+
+    /**
+     * @brief Locates the frames of a zstd file.
+     * @return The frames, or an empty vector if a frame does not record its decompressed size.
+     */
+    inline std::vector<Member> zstd_frames(const char* data, size_t size) {
+        std::vector<Member> frames;
+#ifdef DAEDALUS_HAVE_ZSTD
+        size_t pos = 0;
+        while (pos < size) {
+            size_t frame_size = ZSTD_findFrameCompressedSize(data + pos, size - pos);
+            if (ZSTD_isError(frame_size)) return {};
+            unsigned long long raw_size = ZSTD_getFrameContentSize(data + pos, size - pos);
+            if (raw_size == ZSTD_CONTENTSIZE_UNKNOWN || raw_size == ZSTD_CONTENTSIZE_ERROR) return {};
+            frames.push_back({pos, frame_size, static_cast<size_t>(raw_size)});
+            pos += frame_size;
+        }
+#else
+        (void)data;
+        (void)size;
+#endif
+        return frames;
+    }
+
+    /**
+     * @brief Returns the independently decodable members of compressed data.
+     * @return At least two members, or an empty vector if the data must be decoded serially.
+     */
+    inline std::vector<Member> members(Format format, const char* data, size_t size) {
+        std::vector<Member> result;
+        if (format == Format::GZIP) result = bgzf_members(data, size);
+        else if (format == Format::ZSTD) result = zstd_frames(data, size);
+        if (result.size() < 2) result.clear();
+        return result;
+    }
+
+    /**
+     * @brief Decompresses one member into a buffer of exactly member.raw_size bytes.
+     * @throws std::runtime_error If the member is corrupt.
+     */
+    inline void decode_member(Format format, const char* data, const Member& member, char* out) {
+        const char* src = data + member.offset;
+#ifdef DAEDALUS_HAVE_ZLIB
+        if (format == Format::GZIP) {
+            z_stream zs{};
+            if (inflateInit2(&zs, 15 + 16) != Z_OK) throw std::runtime_error("Could not initialise gzip decoder.");
+            zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(src));
+            zs.avail_in = static_cast<uInt>(member.size);
+            zs.next_out = reinterpret_cast<Bytef*>(out);
+            zs.avail_out = static_cast<uInt>(member.raw_size);
+            int status = inflate(&zs, Z_FINISH);
+            size_t produced = zs.total_out;
+            inflateEnd(&zs);
+            if (status != Z_STREAM_END || produced != member.raw_size) throw std::runtime_error("Corrupt gzip block.");
+            return;
+        }
+#endif
+#ifdef DAEDALUS_HAVE_ZSTD
+        if (format == Format::ZSTD) {
+            size_t produced = ZSTD_decompress(out, member.raw_size, src, member.size);
+            if (ZSTD_isError(produced) || produced != member.raw_size) {
+                throw std::runtime_error("Corrupt zstd frame.");
+            }
+            return;
+        }
+#endif
+        (void)src;
+        (void)out;
+        require_support(format);
+        throw std::runtime_error("Unsupported compression format.");
+    }
+
+    /**
+     * @class Decoder
+     * @brief Pull-based decoder producing the decompressed data in blocks.
+     * * Data with independent members is decoded a wave at a time: the members
+     * of a wave (about STREAM_BLOCK_BYTES per thread) are decompressed in
+     * parallel into one block. Other data is decoded serially into blocks of
+     * STREAM_BLOCK_BYTES; concatenated gzip members and zstd frames are
+     * decoded one after another. The compressed data must outlive the decoder.
+     */
+    class Decoder {
+        Format format;
+        const char* data;
+        size_t size;
+        size_t threads;
+        std::vector<Member> parts;
+        size_t next_part = 0;
+        size_t position = 0;
+        bool done = false;
+#ifdef DAEDALUS_HAVE_ZLIB
+        std::unique_ptr<z_stream, void (*)(z_stream*)> gz{nullptr, [](z_stream* zs) { inflateEnd(zs); delete zs; }};
+#endif
+#ifdef DAEDALUS_HAVE_ZSTD
+        std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> zctx{nullptr, &ZSTD_freeDCtx};
+#endif
+
+        bool next_wave(std::string& block) {
+            size_t budget = threads * STREAM_BLOCK_BYTES;
+            size_t first = next_part, total = 0;
+            while (next_part < parts.size() && (next_part == first || total + parts[next_part].raw_size <= budget)) {
+                total += parts[next_part++].raw_size;
+            }
+            std::vector<size_t> offsets(next_part - first + 1, 0);
+            for (size_t i = first; i < next_part; ++i) offsets[i - first + 1] = offsets[i - first] + parts[i].raw_size;
+            block.resize(total);
+            Parallel::parallel_for(first, next_part, [&](size_t i) {
+                decode_member(format, data, parts[i], &block[offsets[i - first]]);
+            }, threads);
+            done = next_part == parts.size();
+            return true;
+        }
+
+        bool next_serial(std::string& block) {
+            block.resize(STREAM_BLOCK_BYTES);
+            size_t produced = 0;
+#ifdef DAEDALUS_HAVE_ZLIB
+            if (format == Format::GZIP) {
+                if (!gz) {
+                    std::unique_ptr<z_stream> fresh(new z_stream{});
+                    if (inflateInit2(fresh.get(), 15 + 16) != Z_OK) throw std::runtime_error("Could not initialise gzip decoder.");
+                    fresh->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+                    gz.reset(fresh.release());
+                }
+                z_stream* zs = gz.get();
+                while (produced < block.size()) {
+                    size_t consumed = static_cast<size_t>(reinterpret_cast<const char*>(zs->next_in) - data);
+                    zs->avail_in = static_cast<uInt>(std::min<size_t>(size - consumed, size_t(1) << 30));
+                    zs->next_out = reinterpret_cast<Bytef*>(&block[produced]);
+                    zs->avail_out = static_cast<uInt>(block.size() - produced);
+                    int status = inflate(zs, Z_NO_FLUSH);
+                    produced = block.size() - zs->avail_out;
+                    consumed = static_cast<size_t>(reinterpret_cast<const char*>(zs->next_in) - data);
+                    if (status == Z_STREAM_END) {
+                        // Continue with a following gzip member, if any
+                        if (size - consumed < 2 || detect(data + consumed, size - consumed) != Format::GZIP) {
+                            done = true;
+                            break;
+                        }
+                        inflateReset(zs);
+                    } else if (status == Z_BUF_ERROR && consumed == size) {
+                        throw std::runtime_error("Truncated gzip stream.");
+                    } else if (status != Z_OK && status != Z_BUF_ERROR) {
+                        throw std::runtime_error("Corrupt gzip stream.");
+                    }
+                }
+            }
+#endif
+#ifdef DAEDALUS_HAVE_ZSTD
+            if (format == Format::ZSTD) {
+                if (!zctx) {
+                    zctx.reset(ZSTD_createDCtx());
+                    if (!zctx) throw std::runtime_error("Could not initialise zstd decoder.");
+                }
+                while (produced < block.size() && !done) {
+                    ZSTD_inBuffer in{data, size, position};
+                    ZSTD_outBuffer out{&block[0], block.size(), produced};
+                    size_t status = ZSTD_decompressStream(zctx.get(), &out, &in);
+                    if (ZSTD_isError(status)) throw std::runtime_error(std::string("Corrupt zstd stream: ") + ZSTD_getErrorName(status));
+                    bool stalled = in.pos == position && out.pos == produced;
+                    position = in.pos;
+                    produced = out.pos;
+                    if (position == size && out.pos < out.size) {
+                        // Everything is flushed; a non-zero hint means the last frame is incomplete
+                        if (status != 0) throw std::runtime_error("Truncated zstd stream.");
+                        done = true;
+                    } else if (stalled) {
+                        throw std::runtime_error("Corrupt zstd stream.");
+                    }
+                }
+            }
+#endif
+            if (format == Format::NONE) {
+                produced = std::min(block.size(), size - position);
+                std::memcpy(&block[0], data + position, produced);
+                position += produced;
+                done = position == size;
+            }
+            block.resize(produced);
+            return produced > 0 || !done;
+        }
+
+    public:
+        /**
+         * @brief Creates a decoder over compressed data.
+         * @param data The compressed data (it must outlive the decoder).
+         * @param size Size of the compressed data in bytes.
+         * @param num_threads Number of threads for parallel members (0 means use all hardware threads).
+         * @throws std::runtime_error If the build cannot decode the format.
+         */
+        Decoder(const char* data, size_t size, size_t num_threads = 0)
+            : format(detect(data, size)), data(data), size(size), threads(Parallel::resolve_threads(num_threads)) {
+            require_support(format);
+            parts = members(format, data, size);
+            done = size == 0;
+        }
+
+        /**
+         * @brief Decodes the next block.
+         * @param block Receives the decompressed bytes (replacing its contents).
+         * @return False once all data has been returned.
+         * @throws std::runtime_error If the data is corrupt or truncated.
+         */
+        bool next(std::string& block) {
+            block.clear();
+            while (!done) {
+                bool more = parts.empty() ? next_serial(block) : next_wave(block);
+                if (!block.empty() || !more) return !block.empty();
+            }
+            return false;
+        }
+    };
+
+    /**
+     * @class Stream
+     * @brief Runs a Decoder on a background thread, a few blocks ahead of the consumer.
+     * * The decoder thread pushes blocks into a bounded queue, so decompression
+     * overlaps with the consumer's parsing while memory stays bounded by
+     * the queue capacity. Decoding errors are rethrown by next().
+     */
+    class Stream {
+        Decoder decoder;
+        size_t capacity;
+        std::deque<std::string> queue;
+        bool finished = false;
+        bool stopping = false;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::thread worker;
+
+        void run() {
+            try {
+                std::string block;
+                while (decoder.next(block)) {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [this] { return stopping || queue.size() < capacity; });
+                    if (stopping) return;
+                    queue.push_back(std::move(block));
+                    block = std::string();
+                    changed.notify_all();
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = true;
+            changed.notify_all();
+        }
+
+    public:
+        /**
+         * @brief Starts decoding data on a background thread.
+         * @param data The compressed data (it must outlive the stream).
+         * @param size Size of the compressed data in bytes.
+         * @param num_threads Number of threads for parallel members (0 means use all hardware threads).
+         * @param capacity Maximum number of decoded blocks held ahead of the consumer.
+         */
+        Stream(const char* data, size_t size, size_t num_threads = 0, size_t capacity = 2)
+            : decoder(data, size, num_threads), capacity(std::max<size_t>(capacity, 1)), worker([this] { run(); }) {}
+
+        Stream(const Stream&) = delete;
+        Stream& operator=(const Stream&) = delete;
+
+        /** @brief Stops the decoder thread. */
+        ~Stream() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            changed.notify_all();
+            worker.join();
+        }
+
+        /**
+         * @brief Waits for the next decoded block.
+         * @return False once all data has been returned.
+         * @throws std::runtime_error If the data is corrupt or truncated.
+         */
+        bool next(std::string& block) {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return !queue.empty() || finished; });
+            if (!queue.empty()) {
+                block = std::move(queue.front());
+                queue.pop_front();
+                changed.notify_all();
+                return true;
+            }
+            if (error) std::rethrow_exception(error);
+            return false;
+        }
+    };
+
+    /**
+     * @brief Decompresses a whole buffer.
+     * * Independent members are decompressed in parallel straight into the
+     * output; other data is decoded serially.
+     * @param data The compressed data.
+     * @param size Size of the compressed data in bytes.
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     * @throws std::runtime_error If the build cannot decode the format or the data is corrupt.
+     */
+    inline std::string decompress(const char* data, size_t size, size_t num_threads = 0) {
+        Format format = detect(data, size);
+        require_support(format);
+        std::vector<Member> parts = members(format, data, size);
+        std::string result;
+        if (!parts.empty()) {
+            std::vector<size_t> offsets(parts.size() + 1, 0);
+            for (size_t i = 0; i < parts.size(); ++i) offsets[i + 1] = offsets[i] + parts[i].raw_size;
+            result.resize(offsets.back());
+            Parallel::parallel_for(0, parts.size(), [&](size_t i) {
+                decode_member(format, data, parts[i], &result[offsets[i]]);
+            }, num_threads);
+            return result;
+        }
+        Decoder decoder(data, size, num_threads);
+        std::string block;
+        while (decoder.next(block)) result += block;
+        return result;
+    }
+
+    /**
+     * @class DecodedFile
+     * @brief The contents of a file, memory-mapped if plain and decompressed into memory otherwise.
+     */
+    class DecodedFile {
+        MappedFile file;
+        std::string decoded;
+        bool compressed = false;
+
+    public:
+        /**
+         * @brief Opens a file and decompresses it if it is gzip or zstd compressed.
+         * @param path The path of the file.
+         * @param num_threads Number of decompression threads (0 means use all hardware threads).
+         * @throws std::runtime_error If the file cannot be opened or decompressed.
+         */
+        explicit DecodedFile(const std::string& path, size_t num_threads = 0) : file(path) {
+            if (detect(file.data(), file.size()) == Format::NONE) return;
+            decoded = decompress(file.data(), file.size(), num_threads);
+            compressed = true;
+        }
+
+        /** @brief Returns the first byte of the (decompressed) contents. */
+        const char* data() const { return compressed ? decoded.data() : file.data(); }
+
+        /** @brief Returns the size in bytes of the (decompressed) contents. */
+        size_t size() const { return compressed ? decoded.size() : file.size(); }
+    };
+}
+
+#endif // COMPRESSION_H
@@ -0,0 +1,923 @@
+/**
+ * @file Csv.h
+ * @brief SIMD structural scanning, tokenizing and typed column building for CSV data.
+ * * The tokenizer classifies the input 64 bytes at a time: each block is
+ * compared against the delimiter, quote and newline characters with SSE2 or
+ * NEON (or a portable scalar loop) to produce one bitmap per character. A
+ * prefix-XOR of the quote bitmap marks the bytes inside quoted fields, which
+ * are masked out of the delimiter and newline bitmaps. The remaining set bits
+ * are visited with count-trailing-zeros, so the per-byte work is a handful of
+ * vector compares instead of a branch per byte. Blocks without quotes skip
+ * the masking entirely.
+ */
+
+// include/daedalus/core/Csv.h
+
+#ifndef CSV_H
+#define CSV_H
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <unordered_map>
+#include "Column.h"
+#include "Hash.h"
+#include "Parallel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DAEDALUS_CSV_SSE2 1
+#include <emmintrin.h>
+#if defined(__PCLMUL__) && defined(__x86_64__)
+#define DAEDALUS_CSV_CLMUL 1
+#include <wmmintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DAEDALUS_CSV_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @namespace Csv
+ * @brief Building blocks of the CSV reader.
+ */
+namespace Csv {
+    /** @brief Returns the index of the lowest set bit of a non-zero mask. */
+    inline unsigned trailing_zeros(uint64_t mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+    }
+
+    /**
+     * @class Block64
+     * @brief A 64-byte block of input loaded into vector registers.
+     * * eq(c) returns a bitmap whose bit i is set if byte i of the block equals c.
+     */
+    class Block64 {
+#if defined(DAEDALUS_CSV_SSE2)
+        __m128i v[4];
+    public:
+        explicit Block64(const char* p) {
+            for (int i = 0; i < 4; ++i) v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        }
+
+        uint64_t eq(char c) const {
+            const __m128i splat = _mm_set1_epi8(c);
+            uint64_t mask = 0;
+            for (int i = 0; i < 4; ++i) {
+                uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v[i], splat)));
+                mask |= static_cast<uint64_t>(bits) << (16 * i);
+            }
+            return mask;
+        }
+#elif defined(DAEDALUS_CSV_NEON)
+        uint8x16_t v[4];
+    public:
+        explicit Block64(const char* p) {
+            for (int i = 0; i < 4; ++i) v[i] = vld1q_u8(reinterpret_cast<const uint8_t*>(p + 16 * i));
+        }
+
+        uint64_t eq(char c) const {
+            static const uint8_t bit_values[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+            const uint8x16_t splat = vdupq_n_u8(static_cast<uint8_t>(c));
+            const uint8x16_t weights = vld1q_u8(bit_values);
+            uint64_t mask = 0;
+            for (int i = 0; i < 4; ++i) {
+                uint8x16_t hits = vandq_u8(vceqq_u8(v[i], splat), weights);
+                uint64_t lo = vaddv_u8(vget_low_u8(hits));
+                uint64_t hi = vaddv_u8(vget_high_u8(hits));
+                mask |= (lo | (hi << 8)) << (16 * i);
+            }
+            return mask;
+        }
+#else
+        const char* p;
+    public:
+        explicit Block64(const char* data) : p(data) {}
+
+        uint64_t eq(char c) const {
+            uint64_t mask = 0;
+            for (int i = 0; i < 64; ++i) mask |= static_cast<uint64_t>(p[i] == c) << i;
+            return mask;
+        }
+#endif
+    };
+
+    /**
+     * @struct Dialect
+     * @brief The special characters of a CSV file.
+     */
+    struct Dialect {
+        char delimiter = ',';   ///< Field separator.
+        char quote = '"';       ///< Quote character (RFC 4180); doubled inside a quoted field to escape it.
+        char comment = '\0';    ///< Lines starting with this character are skipped ('\0' disables comments).
+
+        /** @brief Throws std::invalid_argument if the characters cannot be used together. */
+        void validate() const {
+            auto reserved = [](char c) { return c == '\n' || c == '\r' || c == '\0'; };
+            if (reserved(delimiter) || reserved(quote)) {
+                throw std::invalid_argument("Delimiter and quote must not be a newline or NUL character.");
+            }
+            if (delimiter == quote || (comment != '\0' && (comment == delimiter || comment == quote))) {
+                throw std::invalid_argument("Delimiter, quote and comment characters must differ.");
+            }
+        }
+    };
+
+    /**
+     * @brief Returns the prefix XOR of a bitmap: bit i is the XOR of bits 0..i.
+     * * Applied to a quote bitmap this sets every bit from an opening quote up to
+     * (but excluding) its closing quote. Uses a carry-less multiply when PCLMUL
+     * is enabled and a shift cascade otherwise.
+     */
+    inline uint64_t prefix_xor(uint64_t mask) {
+#if defined(DAEDALUS_CSV_CLMUL)
+        __m128i product = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<long long>(mask)), _mm_set1_epi8(-1), 0);
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(product));
+#else
+        mask ^= mask << 1;
+        mask ^= mask << 2;
+        mask ^= mask << 4;
+        mask ^= mask << 8;
+        mask ^= mask << 16;
+        mask ^= mask << 32;
+        return mask;
+#endif
+    }
+
+    /** @brief Returns the number of set bits in a mask. */
+    inline unsigned popcount(uint64_t mask) {
+#ifdef _MSC_VER
+        return static_cast<unsigned>(__popcnt64(mask));
+#else
+        return static_cast<unsigned>(__builtin_popcountll(mask));
+#endif
+    }
+
+    /** @brief Counts the occurrences of c in [begin, end) 64 bytes at a time. */
+    inline size_t count_char(const char* begin, const char* end, char c) {
+        size_t total = static_cast<size_t>(end - begin);
+        size_t count = 0;
+        size_t offset = 0;
+        for (; offset + 64 <= total; offset += 64) count += popcount(Block64(begin + offset).eq(c));
+        for (; offset < total; ++offset) count += (begin[offset] == c);
+        return count;
+    }
+
+    /**
+     * @brief Returns the position just after the next newline outside quotes, or end.
+     * @param p Position to scan from.
+     * @param end One past the last byte of the input.
+     * @param quote The quote character.
+     * @param in_quotes Whether p lies inside a quoted field.
+     */
+    inline const char* seek_record(const char* p, const char* end, char quote, bool in_quotes) {
+        while (p < end) {
+            char c = *p++;
+            if (c == quote) in_quotes = !in_quotes;
+            else if (c == '\n' && !in_quotes) break;
+        }
+        return p;
+    }
+
+    /**
+     * @brief Returns the first record boundary at or after p within [begin, end).
+     * * A record starts at begin or just after a newline that is outside quotes;
+     * the quote state at p is recovered by counting the quotes from begin.
+     * @param begin First byte of the input, which must be at a record boundary.
+     * @param p Any position; values outside [begin, end] are clamped.
+     * @param end One past the last byte of the input.
+     * @param quote The quote character.
+     */
+    inline const char* align_to_record(const char* begin, const char* p, const char* end, char quote) {
+        if (p <= begin) return begin;
+        if (p >= end) return end;
+        return seek_record(p - 1, end, quote, (count_char(begin, p - 1, quote) % 2) == 1);
+    }
+
+    /**
+     * @brief Returns the position just after the last newline outside quotes in [begin, end), or begin.
+     * * Scans backwards from end, so only the trailing partial record is read
+     * byte by byte; the quote state is recovered from the parity of the quotes
+     * counted from begin, which must be at a record boundary.
+     */
+    inline const char* last_record_end(const char* begin, const char* end, char quote) {
+        bool odd = (count_char(begin, end, quote) % 2) == 1;
+        for (const char* p = end; p > begin; --p) {
+            char c = p[-1];
+            if (c == quote) odd = !odd;
+            else if (c == '\n' && !odd) return p;
+        }
+        return begin;
+    }
+
+    /**
+     * @brief Splits [begin, end) into byte ranges that each start at a record boundary.
+     * * The range is first cut into equal nominal pieces. The quote characters
+     * of every piece are counted in parallel, so the running parity tells
+     * whether each nominal cut lies inside a quoted field. Each cut is then
+     * moved forward to just after the next newline that is outside quotes,
+     * so a quoted field containing newlines is never split. Quote characters
+     * inside comment lines are assumed to be balanced.
+     * @param begin First byte of the input.
+     * @param end One past the last byte of the input.
+     * @param n_chunks The number of ranges wanted.
+     * @param quote The quote character.
+     * @return n_chunks + 1 boundaries; range i is [bounds[i], bounds[i + 1]) and may be empty.
+     */
+    inline std::vector<const char*> split_chunks(const char* begin, const char* end, size_t n_chunks, char quote = '"') {
+        n_chunks = std::max<size_t>(n_chunks, 1);
+        size_t total = static_cast<size_t>(end - begin);
+        std::vector<const char*> nominal(n_chunks + 1);
+        for (size_t k = 0; k <= n_chunks; ++k) nominal[k] = begin + (total * k) / n_chunks;
+
+        std::vector<size_t> quotes(n_chunks, 0);
+        Parallel::parallel_for(0, n_chunks, [&](size_t k) {
+            quotes[k] = count_char(nominal[k], nominal[k + 1], quote);
+        }, n_chunks);
+
+        std::vector<const char*> bounds(n_chunks + 1);
+        bounds[0] = begin;
+        bounds[n_chunks] = end;
+        size_t quotes_before = 0;
+        for (size_t k = 1; k < n_chunks; ++k) {
+            quotes_before += quotes[k - 1];
+            bool in_quotes = (quotes_before % 2) == 1;
+            const char* p = std::max(nominal[k], bounds[k - 1]);
+            if (p != nominal[k]) {
+                // The previous boundary overshot this cut, so the quote state must be recomputed
+                in_quotes = (count_char(begin, p, quote) % 2) == 1;
+            }
+            bounds[k] = seek_record(p, end, quote, in_quotes);
+        }
+        return bounds;
+    }
+
+    /** @brief Returns true if c is a space or a tab. */
+    inline bool is_space(char c) { return c == ' ' || c == '\t'; }
+
+    /** @brief Narrows [p, p + n) by removing leading and trailing spaces and tabs. */
+    inline void trim(const char*& p, size_t& n) {
+        while (n > 0 && is_space(*p)) { ++p; --n; }
+        while (n > 0 && is_space(p[n - 1])) --n;
+    }
+
+    /**
+     * @brief Parses a whole field as a double.
+     * * Surrounding spaces are ignored and a leading '+' is accepted. Uses
+     * std::from_chars where the standard library provides it for floating
+     * point, and strtod otherwise.
+     * @param p Pointer to the field.
+     * @param n Length of the field.
+     * @param out Receives the value on success.
+     * @return True if the entire (trimmed) field is a number.
+     */
+    inline bool parse_double(const char* p, size_t n, double& out) {
+        trim(p, n);
+        if (n > 1 && *p == '+' && p[1] != '-') { ++p; --n; }
+        if (n == 0) return false;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto result = std::from_chars(p, p + n, out);
+        return result.ec == std::errc() && result.ptr == p + n;
+#else
+        char buffer[64];
+        std::string long_field;
+        const char* text = buffer;
+        if (n < sizeof(buffer)) {
+            std::memcpy(buffer, p, n);
+            buffer[n] = '\0';
+        } else {
+            long_field.assign(p, n);
+            text = long_field.c_str();
+        }
+        char* end = nullptr;
+        out = std::strtod(text, &end);
+        return end == text + n;
+#endif
+    }
+
+    /**
+     * @brief Parses a whole field as a 64-bit integer.
+     * * Surrounding spaces are ignored and a leading '+' is accepted.
+     * @return True if the entire (trimmed) field is an integer that fits in int64.
+     */
+    inline bool parse_int64(const char* p, size_t n, int64_t& out) {
+        trim(p, n);
+        if (n > 1 && *p == '+' && p[1] != '-') { ++p; --n; }
+        if (n == 0) return false;
+        auto result = std::from_chars(p, p + n, out);
+        return result.ec == std::errc() && result.ptr == p + n;
+    }
+
+    /**
+     * @brief Parses a whole field as a boolean ("true" or "false" in any case).
+     * @param allow_digits Also accept "1" and "0".
+     * @return True if the (trimmed) field is a boolean.
+     */
+    inline bool parse_bool(const char* p, size_t n, bool& out, bool allow_digits = false) {
+        trim(p, n);
+        auto equals = [&](const char* word) {
+            size_t len = std::strlen(word);
+            if (n != len) return false;
+            for (size_t i = 0; i < len; ++i) {
+                char c = p[i];
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+                if (c != word[i]) return false;
+            }
+            return true;
+        };
+        if (equals("true") || (allow_digits && equals("1"))) { out = true; return true; }
+        if (equals("false") || (allow_digits && equals("0"))) { out = false; return true; }
+        return false;
+    }
+
+    /** @brief Returns true if the field is empty or only holds spaces. */
+    inline bool is_blank(const char* p, size_t n) {
+        trim(p, n);
+        return n == 0;
+    }
+
+    /**
+     * @brief Splits [begin, end) into fields and records.
+     * * Calls sink.field(ptr, len) for every field and sink.end_record() after
+     * the last field of every record; parsing stops early when end_record()
+     * returns false. Quoted fields (RFC 4180) may contain delimiters, newlines
+     * and doubled quotes; the sink receives their unquoted value, which points
+     * into the input unless it contained an escaped quote. A trailing '\r' is
+     * removed from every record, blank lines and comment lines are skipped, and
+     * a final record without a terminating newline is still emitted.
+     * * When a field selection is given, only fields whose position is marked
+     * in it reach the sink; the others (including any beyond its size) are
+     * skipped as soon as their end is found, without being unquoted or copied.
+     * @param begin First byte of the input, which must be at a record boundary.
+     * @param end One past the last byte of the input.
+     * @param dialect The delimiter, quote and comment characters.
+     * @param sink Receiver of fields and record ends.
+     * @param selected Optional per-position flags of the fields to emit (null emits every field).
+     * @return One past the last byte consumed (end unless the sink stopped early).
+     */
+    template <typename Sink>
+    const char* tokenize(const char* begin, const char* end, const Dialect& dialect, Sink& sink,
+                         const std::vector<uint8_t>* selected = nullptr) {
+        const char delimiter = dialect.delimiter;
+        const char quote = dialect.quote;
+        const char comment = dialect.comment;
+        bool in_record = false;
+        size_t field_index = 0;
+        std::string unescaped;
+
+        // Strips the quotes of a quoted field and collapses doubled quotes
+        auto emit = [&](const char* p, size_t n) {
+            if (n >= 2 && p[0] == quote && p[n - 1] == quote) {
+                ++p;
+                n -= 2;
+                if (std::memchr(p, quote, n)) {
+                    unescaped.clear();
+                    for (size_t i = 0; i < n; ++i) {
+                        unescaped.push_back(p[i]);
+                        if (p[i] == quote && i + 1 < n && p[i + 1] == quote) ++i;
+                    }
+                    sink.field(unescaped.data(), unescaped.size());
+                    return;
+                }
+            }
+            sink.field(p, n);
+        };
+
+        auto emit_selected = [&](const char* p, size_t n) {
+            if (!selected || (field_index < selected->size() && (*selected)[field_index])) emit(p, n);
+            ++field_index;
+        };
+
+        auto skip_comments = [&](const char* p) {
+            while (comment != '\0' && p < end && *p == comment) {
+                const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+                p = newline ? newline + 1 : end;
+            }
+            return p;
+        };
+
+        const char* field_start = skip_comments(begin);
+
+        // Returns false once the sink asks to stop
+        auto finish_field = [&](const char* pos, bool newline) {
+            size_t len = static_cast<size_t>(pos - field_start);
+            if (!newline) {
+                emit_selected(field_start, len);
+                in_record = true;
+                return true;
+            }
+            if (len > 0 && pos[-1] == '\r') --len;
+            bool more = true;
+            if (in_record || len > 0) {
+                emit_selected(field_start, len);
+                more = sink.end_record();
+            }
+            in_record = false;
+            field_index = 0;
+            return more;
+        };
+
+        const char* block = field_start;
+        uint64_t quote_carry = 0;   // All ones when the block starts inside a quoted field
+        while (block < end) {
+            size_t avail = static_cast<size_t>(end - block);
+            uint64_t delimiters, newlines, quotes;
+            if (avail >= 64) {
+                Block64 bytes(block);
+                delimiters = bytes.eq(delimiter);
+                newlines = bytes.eq('\n');
+                quotes = bytes.eq(quote);
+            } else {
+                char padded[64] = {};
+                std::memcpy(padded, block, avail);
+                Block64 bytes(padded);
+                uint64_t valid = (uint64_t(1) << avail) - 1;
+                delimiters = bytes.eq(delimiter) & valid;
+                newlines = bytes.eq('\n') & valid;
+                quotes = bytes.eq(quote) & valid;
+            }
+
+            // Fast path: blocks without quotes that start outside a quoted field need no masking
+            if (quotes | quote_carry) {
+                uint64_t inside = prefix_xor(quotes) ^ quote_carry;
+                quote_carry = static_cast<uint64_t>(static_cast<int64_t>(inside) >> 63);
+                delimiters &= ~inside;
+                newlines &= ~inside;
+            }
+
+            const char* next = block + std::min<size_t>(avail, 64);
+            uint64_t structurals = delimiters | newlines;
+            while (structurals) {
+                unsigned bit = trailing_zeros(structurals);
+                bool newline = (newlines >> bit) & 1;
+                bool more = finish_field(block + bit, newline);
+                field_start = block + bit + 1;
+                if (!more) return field_start;
+                if (newline && comment != '\0' && field_start < end && *field_start == comment) {
+                    // Resume scanning after the comment lines, outside any quotes
+                    field_start = skip_comments(field_start);
+                    next = field_start;
+                    quote_carry = 0;
+                    break;
+                }
+                structurals &= structurals - 1;
+            }
+            block = next;
+        }
+
+        if (field_start < end || in_record) {
+            size_t len = static_cast<size_t>(end - field_start);
+            if (len > 0 && end[-1] == '\r') --len;
+            if (in_record || len > 0) {
+                emit_selected(field_start, len);
+                sink.end_record();
+            }
+        }
+        return end;
+    }
+
+    /**
+     * @struct RecordSkipper
+     * @brief Tokenizer sink that ignores fields and stops after a number of records.
+     */
+    struct RecordSkipper {
+        size_t remaining;
+        void field(const char*, size_t) {}
+        bool end_record() { return --remaining > 0; }
+    };
+
+    /**
+     * @brief Returns the position just after the first n records of [begin, end), or end.
+     * * Only the structural scan runs: no field is unquoted, converted or copied.
+     */
+    inline const char* skip_records(const char* begin, const char* end, size_t n, const Dialect& dialect) {
+        if (n == 0 || begin >= end) return begin;
+        static const std::vector<uint8_t> no_fields;
+        RecordSkipper skipper{n};
+        return tokenize(begin, end, dialect, skipper, &no_fields);
+    }
+
+    /**
+     * @struct RecordCounter
+     * @brief Tokenizer sink that ignores fields and counts records.
+     */
+    struct RecordCounter {
+        size_t count = 0;
+        void field(const char*, size_t) {}
+        bool end_record() { ++count; return true; }
+    };
+
+    /**
+     * @brief Returns the number of records in [begin, end) using only the structural scan.
+     */
+    inline size_t count_records(const char* begin, const char* end, const Dialect& dialect) {
+        static const std::vector<uint8_t> no_fields;
+        RecordCounter counter;
+        tokenize(begin, end, dialect, counter, &no_fields);
+        return counter.count;
+    }
+
+    /**
+     * @struct ColumnSpec
+     * @brief The storage type chosen for one CSV column.
+     * * Inferred columns (strict = false) may still widen while parsing:
+     * int32 to int64 on overflow, integers and bools to float64 on a decimal
+     * value, and to mixed on a value that is not a number (text after the
+     * sampled records). Numbers that follow in a mixed column are int cells
+     * when they are integers that fit in an int and the column was not
+     * float64, and double cells otherwise. Columns whose type was given
+     * explicitly never change type; their unparseable values become nulls.
+     */
+    struct ColumnSpec {
+        DType type = DType::FLOAT64;
+        bool strict = false;
+    };
+
+    /**
+     * @class SchemaSampler
+     * @brief Tokenizer sink that infers column types from the first records of a file.
+     * * For every column it tracks which types all non-empty sampled values
+     * fit into, then picks the narrowest: bool, int32, int64, float64 and
+     * finally string. A column with no non-empty sampled value is float64.
+     */
+    class SchemaSampler {
+        struct Candidates {
+            bool seen = false, is_bool = true, is_int32 = true, is_int64 = true, is_number = true;
+        };
+        std::vector<Candidates> columns;
+        size_t current = 0;
+        size_t num_records = 0;
+        size_t max_records;
+
+    public:
+        /** @brief Creates a sampler for n_columns columns that stops after max_records records. */
+        SchemaSampler(size_t n_columns, size_t max_records) : columns(n_columns), max_records(max_records) {}
+
+        void field(const char* p, size_t n) {
+            if (current >= columns.size() || is_blank(p, n)) { ++current; return; }
+            Candidates& c = columns[current++];
+            c.seen = true;
+
+            bool flag;
+            int64_t integer;
+            double number;
+            if (c.is_bool && !parse_bool(p, n, flag)) c.is_bool = false;
+            if (c.is_int64) {
+                if (!parse_int64(p, n, integer)) {
+                    c.is_int64 = c.is_int32 = false;
+                } else if (integer < std::numeric_limits<int>::min() || integer > std::numeric_limits<int>::max()) {
+                    c.is_int32 = false;
+                }
+            }
+            if (c.is_number && !c.is_int64 && !parse_double(p, n, number)) c.is_number = false;
+        }
+
+        bool end_record() {
+            current = 0;
+            return ++num_records < max_records;
+        }
+
+        /** @brief Returns the inferred column types. */
+        std::vector<ColumnSpec> specs() const {
+            std::vector<ColumnSpec> result(columns.size());
+            for (size_t i = 0; i < columns.size(); ++i) {
+                const Candidates& c = columns[i];
+                if (!c.seen) result[i].type = DType::FLOAT64;
+                else if (c.is_bool) result[i].type = DType::BOOL;
+                else if (c.is_int32) result[i].type = DType::INT32;
+                else if (c.is_int64) result[i].type = DType::INT64;
+                else if (c.is_number) result[i].type = DType::FLOAT64;
+                else result[i].type = DType::STRING;
+            }
+            return result;
+        }
+    };
+
+    /**
+     * @class ColumnBuilder
+     * @brief Tokenizer sink that appends fields directly into typed Column buffers.
+     * * The type of every column is fixed up front by a ColumnSpec, so each field
+     * takes a single, well-predicted branch into its typed parser. Empty fields
+     * and missing trailing fields are recorded in the column's null bitmap, as
+     * are values that cannot be parsed as the type of an explicitly typed
+     * column; inferred columns are widened instead (see ColumnSpec). Category columns look
+     * values up in an open-addressing dictionary index, so only distinct
+     * values are allocated.
+     */
+    class ColumnBuilder {
+        std::vector<Column> columns;
+        std::vector<ColumnSpec> specs;
+        std::vector<HashIndex> dictionaries;
+        size_t current = 0;
+        size_t num_records = 0;
+        size_t max_records;
+
+        void append_category(size_t c, const char* p, size_t n) {
+            Column& col = columns[c];
+            std::vector<std::string>& values = col.categories();
+            auto found = dictionaries[c].insert(Hash::bytes(p, n), static_cast<uint32_t>(values.size()), [&](uint32_t id) {
+                return values[id].size() == n && std::memcmp(values[id].data(), p, n) == 0;
+            });
+            if (found.second) values.emplace_back(p, n);
+            col.ints().push_back(static_cast<int>(found.first));
+        }
+
+        /**
+         * @brief Appends a field to a mixed column as an int, double or string cell.
+         * * Integers that fit in an int become int cells, as they do when an int32
+         * column is cast to mixed, unless @p integers is false (a float64 column
+         * that widened), so the cells do not depend on where a chunk widened.
+         */
+        static void append_mixed(Column& col, const char* p, size_t n, bool integers) {
+            double number;
+            int64_t integer;
+            if (integers && parse_int64(p, n, integer) && integer >= std::numeric_limits<int>::min()
+                && integer <= std::numeric_limits<int>::max()) {
+                col.cells().emplace_back(static_cast<int>(integer));
+            } else if (parse_double(p, n, number)) {
+                col.cells().emplace_back(number);
+            } else {
+                col.cells().emplace_back(std::string(p, n));
+            }
+        }
+
+        void append_value(size_t c, const char* p, size_t n) {
+            Column& col = columns[c];
+            if (is_blank(p, n)) {
+                col.push_null();
+                return;
+            }
+
+            bool strict = specs[c].strict;
+            bool integers = specs[c].type != DType::FLOAT64;
+            double number;
+            int64_t integer;
+            bool flag;
+            // An inferred column that meets a value it cannot hold is widened rather than nulled
+            auto widen_to_mixed = [&] {
+                col = col.cast(DType::MIXED);
+                append_mixed(col, p, n, integers);
+            };
+            switch (col.type()) {
+                case DType::FLOAT64:
+                    if (parse_double(p, n, number)) col.doubles().push_back(number);
+                    else if (!strict) widen_to_mixed();
+                    else col.push_null();
+                    break;
+                case DType::INT32:
+                    if (parse_int64(p, n, integer)) {
+                        if (integer >= std::numeric_limits<int>::min() && integer <= std::numeric_limits<int>::max()) {
+                            col.ints().push_back(static_cast<int>(integer));
+                        } else if (!strict) {
+                            col = col.cast(DType::INT64);
+                            col.int64s().push_back(integer);
+                        } else {
+                            col.push_null();
+                        }
+                    } else if (!strict && parse_double(p, n, number)) {
+                        col = col.cast(DType::FLOAT64);
+                        col.doubles().push_back(number);
+                    } else if (!strict) {
+                        widen_to_mixed();
+                    } else {
+                        col.push_null();
+                    }
+                    break;
+                case DType::INT64:
+                    if (parse_int64(p, n, integer)) {
+                        col.int64s().push_back(integer);
+                    } else if (!strict && parse_double(p, n, number)) {
+                        col = col.cast(DType::FLOAT64);
+                        col.doubles().push_back(number);
+                    } else if (!strict) {
+                        widen_to_mixed();
+                    } else {
+                        col.push_null();
+                    }
+                    break;
+                case DType::BOOL:
+                    if (parse_bool(p, n, flag, true)) {
+                        col.bools().push_back(flag ? 1 : 0);
+                    } else if (!strict && parse_double(p, n, number)) {
+                        col = col.cast(DType::FLOAT64);
+                        col.doubles().push_back(number);
+                    } else if (!strict) {
+                        widen_to_mixed();
+                    } else {
+                        col.push_null();
+                    }
+                    break;
+                case DType::STRING:
+                    col.strings().emplace_back(p, n);
+                    break;
+                case DType::CATEGORY:
+                    append_category(c, p, n);
+                    break;
+                default:
+                    append_mixed(col, p, n, integers);
+                    break;
+            }
+        }
+
+    public:
+        /**
+         * @brief Creates a builder with one column per spec.
+         * @param column_specs The type of every column.
+         * @param max_records Number of records after which the builder asks the tokenizer to stop.
+         */
+        explicit ColumnBuilder(const std::vector<ColumnSpec>& column_specs,
+                               size_t max_records = std::numeric_limits<size_t>::max())
+            : specs(column_specs), dictionaries(column_specs.size()), max_records(max_records) {
+            columns.reserve(specs.size());
+            for (const auto& spec : specs) columns.emplace_back(spec.type);
+        }
+
+        /**
+         * @brief Appends one field to the current column.
+         * @throws std::runtime_error If a record has more fields than columns.
+         */
+        void field(const char* p, size_t n) {
+            if (current >= columns.size()) {
+                throw std::runtime_error("CSV record " + std::to_string(num_records + 1) + " has more than "
+                                         + std::to_string(columns.size()) + " fields.");
+            }
+            append_value(current++, p, n);
+        }
+
+        /** @brief Completes the current record, padding missing fields with nulls. */
+        bool end_record() {
+            while (current < columns.size()) columns[current++].push_null();
+            current = 0;
+            return ++num_records < max_records;
+        }
+
+        /** @brief Returns the number of records completed so far. */
+        size_t records() const { return num_records; }
+
+        /** @brief Releases the built columns. */
+        std::vector<Column> take_columns() { return std::move(columns); }
+    };
+
+    /**
+     * @class MatrixBuilder
+     * @brief Tokenizer sink that parses selected fields straight into row-major double buffers.
+     * * Every selected field is routed to a slot: slots below the row width go
+     * to the feature row, and the optional target slot goes to the target
+     * buffer. Booleans become 1 and 0; empty fields, missing trailing fields
+     * and values that are not numbers become NaN.
+     */
+    class MatrixBuilder {
+        double* x;
+        double* y;
+        size_t width;
+        std::vector<size_t> slots;
+        size_t current = 0;
+        size_t num_records = 0;
+        size_t max_records;
+
+        static double parse_value(const char* p, size_t n) {
+            double number;
+            bool flag;
+            if (parse_double(p, n, number)) return number;
+            if (parse_bool(p, n, flag)) return flag ? 1.0 : 0.0;
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        void store(size_t slot, double v) {
+            if (slot < width) x[num_records * width + slot] = v;
+            else y[num_records] = v;
+        }
+
+    public:
+        /**
+         * @brief Creates a builder writing at most max_records rows.
+         * @param x Feature buffer of max_records rows of width values.
+         * @param y Target buffer of max_records values (null when there is no target).
+         * @param width Number of features per row.
+         * @param field_slots Destination slot of every selected field in file order
+         *                    (width denotes the target).
+         * @param max_records Number of rows the buffers hold.
+         */
+        MatrixBuilder(double* x, double* y, size_t width, std::vector<size_t> field_slots, size_t max_records)
+            : x(x), y(y), width(width), slots(std::move(field_slots)), max_records(max_records) {}
+
+        /** @brief Parses one field into its slot of the current row. */
+        void field(const char* p, size_t n) {
+            if (current < slots.size()) store(slots[current], parse_value(p, n));
+            ++current;
+        }
+
+        /** @brief Completes the current row, filling missing fields with NaN. */
+        bool end_record() {
+            while (current < slots.size()) store(slots[current++], std::numeric_limits<double>::quiet_NaN());
+            current = 0;
+            return ++num_records < max_records;
+        }
+
+        /** @brief Returns the number of rows completed so far. */
+        size_t records() const { return num_records; }
+    };
+
+    /**
+     * @struct FieldCollector
+     * @brief Tokenizer sink that keeps the fields of a record as strings (used for headers).
+     */
+    struct FieldCollector {
+        std::vector<std::string> fields;
+        void field(const char* p, size_t n) { fields.emplace_back(p, n); }
+        bool end_record() { return false; }
+    };
+
+    /**
+     * @struct Layout
+     * @brief Column names, column types and the start of the records of a CSV file.
+     */
+    struct Layout {
+        std::vector<std::string> headers;   ///< Names of the selected columns.
+        std::vector<ColumnSpec> specs;      ///< Types of the selected columns.
+        const char* body = nullptr;         ///< First byte of the first record to parse.
+        std::vector<uint8_t> selected;      ///< Per-position flags of the selected fields (empty when all are).
+
+        /** @brief Returns the field selection to pass to tokenize (null when every field is selected). */
+        const std::vector<uint8_t>* selection() const { return selected.empty() ? nullptr : &selected; }
+    };
+
+    /**
+     * @brief Reads the header and infers the schema of CSV data.
+     * @param begin First byte of the input.
+     * @param end One past the last byte of the input.
+     * @param has_header If true the first record holds the column names, otherwise columns are named "0", "1", ...
+     * @param dtype Explicit column types by name, overriding inference.
+     * @param sample_rows Number of records used to infer the other column types.
+     * @param dialect The delimiter, quote and comment characters.
+     * @param usecols Names of the columns to keep, in any order (empty keeps all). The
+     *                columns keep their file order, and only their fields are sampled.
+     * @param skiprows Number of data records after the header to skip before sampling and parsing.
+     * @throws std::invalid_argument If dtype or usecols names an unknown column, dtype names an
+     *         unknown type, or the dialect is invalid.
+     */
+    inline Layout read_layout(const char* begin, const char* end, bool has_header,
+                              const std::unordered_map<std::string, std::string>& dtype, size_t sample_rows,
+                              const Dialect& dialect = Dialect(), const std::vector<std::string>& usecols = {},
+                              size_t skiprows = 0) {
+        dialect.validate();
+        Layout layout;
+        FieldCollector first_line;
+        const char* after_first = tokenize(begin, end, dialect, first_line);
+        std::vector<std::string> all_headers;
+        layout.body = begin;
+        if (has_header) {
+            all_headers = std::move(first_line.fields);
+            layout.body = after_first;
+        } else {
+            for (size_t i = 0; i < first_line.fields.size(); ++i) all_headers.push_back(std::to_string(i));
+        }
+        layout.body = skip_records(layout.body, end, skiprows, dialect);
+
+        // Narrow the columns to the projection, keeping their file order
+        if (usecols.empty()) {
+            layout.headers = all_headers;
+        } else {
+            layout.selected.assign(all_headers.size(), 0);
+            for (const auto& name : usecols) {
+                auto it = std::find(all_headers.begin(), all_headers.end(), name);
+                if (it == all_headers.end()) throw std::invalid_argument("Column in usecols not found: " + name);
+                layout.selected[static_cast<size_t>(it - all_headers.begin())] = 1;
+            }
+            for (size_t i = 0; i < all_headers.size(); ++i) {
+                if (layout.selected[i]) layout.headers.push_back(all_headers[i]);
+            }
+        }
+
+        SchemaSampler sampler(layout.headers.size(), std::max<size_t>(sample_rows, 1));
+        tokenize(layout.body, end, dialect, sampler, layout.selection());
+        layout.specs = sampler.specs();
+        for (const auto& entry : dtype) {
+            if (std::find(all_headers.begin(), all_headers.end(), entry.first) == all_headers.end()) {
+                throw std::invalid_argument("Column in dtype not found: " + entry.first);
+            }
+            DType type = parse_dtype(entry.second);
+            auto it = std::find(layout.headers.begin(), layout.headers.end(), entry.first);
+            if (it != layout.headers.end()) layout.specs[static_cast<size_t>(it - layout.headers.begin())] = {type, true};
+        }
+        return layout;
+    }
+}
+
+#endif // CSV_H
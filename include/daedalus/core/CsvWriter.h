@@ -0,0 +1,148 @@
+/**
+ * @file CsvWriter.h
+ * @brief Number formatting and ordered parallel block output for CSV writers.
+ * * Writers split their rows into blocks of a few MiB. A wave of blocks is
+ * formatted in parallel (one block per thread) into reusable string buffers,
+ * and the wave is then written to the file in block order by a background
+ * task while the next wave is being formatted, so the output is identical
+ * to a serial write.
+ */
+
+// include/daedalus/core/CsvWriter.h
+
+#ifndef CSVWRITER_H
+#define CSVWRITER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <stdexcept>
+#include "Parallel.h"
+
+namespace Csv {
+    /** @brief Target size of one formatted block in bytes. */
+    constexpr size_t WRITE_BLOCK_BYTES = size_t(4) << 20;
+
+    /**
+     * @brief Appends the shortest representation of v that parses back to the same double.
+     * * Uses std::to_chars where the standard library provides it for floating
+     * point, and the shortest of %.15g, %.16g and %.17g that round-trips otherwise.
+     * NaN is written as an empty field (read back as null).
+     */
+    inline void append_double(std::string& out, double v) {
+        if (std::isnan(v)) return;
+        char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), v);
+        out.append(buffer, result.ptr);
+#else
+        int n = 0;
+        for (int precision = 15; precision <= 17; ++precision) {
+            n = std::snprintf(buffer, sizeof(buffer), "%.*g", precision, v);
+            if (std::strtod(buffer, nullptr) == v) break;
+        }
+        out.append(buffer, static_cast<size_t>(n));
+#endif
+    }
+
+    /** @brief Appends the decimal representation of an integer. */
+    template <typename Int>
+    void append_int(std::string& out, Int v) {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), v);
+        out.append(buffer, result.ptr);
+    }
+
+    /** @brief Appends a matrix element (doubles and floats as shortest round-trip, integers exactly). */
+    template <typename T>
+    void append_number(std::string& out, T v) {
+        if constexpr (std::is_floating_point<T>::value) append_double(out, static_cast<double>(v));
+        else append_int(out, v);
+    }
+
+    /**
+     * @brief Appends a text field, quoting it (RFC 4180) only if it contains the
+     * delimiter, the quote character or a line break.
+     */
+    inline void append_text(std::string& out, const char* p, size_t n, char delimiter = ',', char quote = '"') {
+        bool needs_quotes = false;
+        for (size_t i = 0; i < n && !needs_quotes; ++i) {
+            char c = p[i];
+            needs_quotes = c == delimiter || c == quote || c == '\n' || c == '\r';
+        }
+        if (!needs_quotes) {
+            out.append(p, n);
+            return;
+        }
+        out.push_back(quote);
+        for (size_t i = 0; i < n; ++i) {
+            if (p[i] == quote) out.push_back(quote);
+            out.push_back(p[i]);
+        }
+        out.push_back(quote);
+    }
+
+    /** @brief Appends a text field (see the pointer overload). */
+    inline void append_text(std::string& out, const std::string& s, char delimiter = ',', char quote = '"') {
+        append_text(out, s.data(), s.size(), delimiter, quote);
+    }
+
+    /**
+     * @brief Writes a header followed by n_rows formatted rows to a file.
+     * @param path The output path (overwritten).
+     * @param header Text written before the rows (may be empty).
+     * @param n_rows Number of rows.
+     * @param row_bytes Estimated bytes per formatted row, used to size the blocks.
+     * @param format Callable format(lo, hi, out) appending rows [lo, hi) to out.
+     * @param num_threads Number of formatting threads (0 means use all hardware threads).
+     * @throws std::runtime_error If the file cannot be opened or written.
+     */
+    template <typename FormatRows>
+    void write_blocks(const std::string& path, const std::string& header, size_t n_rows, size_t row_bytes,
+                      FormatRows&& format, size_t num_threads = 0) {
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(path.c_str(), "wb"), &std::fclose);
+        if (!file) throw std::runtime_error("Could not open file for writing: " + path);
+        auto write = [&](const std::string& s) {
+            if (!s.empty() && std::fwrite(s.data(), 1, s.size(), file.get()) != s.size()) {
+                throw std::runtime_error("Could not write file: " + path);
+            }
+        };
+        write(header);
+
+        size_t threads = Parallel::resolve_threads(num_threads);
+        size_t block_rows = std::max<size_t>(64, WRITE_BLOCK_BYTES / std::max<size_t>(row_bytes, 1));
+        size_t n_blocks = (n_rows + block_rows - 1) / block_rows;
+
+        // Double buffering: one wave is written while the next is formatted
+        std::vector<std::string> waves[2];
+        std::future<void> pending;
+        for (size_t first = 0, wave = 0; first < n_blocks; first += threads, ++wave) {
+            std::vector<std::string>& buffers = waves[wave % 2];
+            size_t count = std::min(threads, n_blocks - first);
+            buffers.resize(count);
+            Parallel::parallel_for(0, count, [&](size_t b) {
+                size_t lo = (first + b) * block_rows;
+                buffers[b].clear();
+                format(lo, std::min(n_rows, lo + block_rows), buffers[b]);
+            }, count);
+
+            if (pending.valid()) pending.get();
+            pending = std::async(std::launch::async, [&write, &buffers] {
+                for (const auto& buffer : buffers) write(buffer);
+            });
+        }
+        if (pending.valid()) pending.get();
+        if (std::fflush(file.get()) != 0) throw std::runtime_error("Could not write file: " + path);
+    }
+}
+
+#endif // CSVWRITER_H
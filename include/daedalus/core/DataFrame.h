@@ -11,24 +11,38 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
+#include <algorithm>
 #include <variant>
+#include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include "Matrix.h"
+#include "Column.h"
+#include "Parallel.h"
+#include "Sketches.h"
+#include "Factorize.h"
+#include "Columnar.h"
+#include "CsvWriter.h"
 
 /**
  * @class DataFrame
  * @brief A container for storing and manipulating heterogenous tabular data.
  * * The DataFrame stores data in a column-major format using a map of column names 
- * to vectors of variants. Supported types include double, int, and std::string.
+ * to typed Column buffers. Supported types include double, int, and std::string;
+ * columns holding more than one of these types are stored as variants.
  */
 class DataFrame {
     /** @brief Type alias for the data held in a single column. */
-    using ColumnData = std::vector<std::variant<double, int, std::string>>;
+    using ColumnData = std::vector<Cell>;
 
     std::vector<std::string> column_names;
-    std::unordered_map<std::string, ColumnData> data;
+    std::unordered_map<std::string, Column> data;
     size_t num_rows = 0;
 
+    /** @brief Fewest cells copied by one thread when appending or concatenating. */
+    static constexpr size_t MIN_CELLS_PER_THREAD = size_t(1) << 16;
+
 public:
     /** @brief Default constructor creating an empty DataFrame. */
     DataFrame() = default;
@@ -40,7 +54,7 @@ class DataFrame {
      */
     DataFrame(const std::string& col_name, const ColumnData& col_data) {
         column_names.push_back(col_name);
-        data[col_name] = col_data;
+        data[col_name] = Column::from_cells(col_data);
         num_rows = col_data.size();
     }
 
@@ -69,7 +83,7 @@ class DataFrame {
         if (it == data.end()) {
             throw std::invalid_argument("Column not found: " + col_name);
         }
-        return it->second[row]; // it->second is the ColumnData vector
+        return it->second.get(row);
     }
 
         /**
@@ -87,7 +101,38 @@ class DataFrame {
             throw std::out_of_range("Column index out of bounds.");
         }
         const std::string& col_name = column_names[col];
-        return data.at(col_name)[row];
+        return data.at(col_name).get(row);
+    }
+
+    /**
+     * @brief Returns the typed Column stored under a name.
+     * @param col_name The name of the column.
+     * @throws std::invalid_argument If col_name is not found.
+     */
+    const Column& column(const std::string& col_name) const {
+        auto it = data.find(col_name);
+        if (it == data.end()) {
+            throw std::invalid_argument("Column not found: " + col_name);
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Returns the storage type name of a column (e.g. "float64").
+     * @param col_name The name of the column.
+     * @throws std::invalid_argument If col_name is not found.
+     */
+    std::string dtype(const std::string& col_name) const {
+        return dtype_name(column(col_name).type());
+    }
+
+    /**
+     * @brief Returns the number of null (missing) values in a column.
+     * @param col_name The name of the column.
+     * @throws std::invalid_argument If the column is not found.
+     */
+    size_t null_count(const std::string& col_name) const {
+        return column(col_name).null_count();
     }
 
     /**
@@ -110,7 +155,7 @@ class DataFrame {
         size_t display_rows = std::min(num_rows, (size_t)10);
         for (size_t r = 0; r < display_rows; ++r) {
             for (size_t c = 0; c < column_names.size(); ++c) {
-                const auto& val = data.at(column_names[c])[r];
+                const auto val = data.at(column_names[c]).get(r);
                 std::visit([&ss](auto&& arg) { ss << arg << "\t"; }, val);
             }
             ss << "\n";
@@ -129,10 +174,8 @@ class DataFrame {
         size_t rows_to_copy = std::min(n, num_rows);
 
         for (const auto& name : column_names) {
-            const auto& full_col = data.at(name);
-            // Create a sub-vector containing only the first 'n' elements
-            ColumnData head_col(full_col.begin(), full_col.begin() + rows_to_copy);
-            result.add_column(name, head_col);
+            // Copy only the first 'n' elements
+            result.add_column(name, data.at(name).slice(0, rows_to_copy));
         }
 
         return result;
@@ -147,10 +190,11 @@ class DataFrame {
         DataFrame result;
         size_t rows_to_copy = std::min(n, num_rows);
 
+        std::vector<size_t> indices(rows_to_copy);
+        for (size_t i = 0; i < rows_to_copy; ++i) indices[i] = num_rows - 1 - i;
+
         for (const auto& name : column_names) {
-            const auto& full_col = data.at(name);
-            ColumnData head_col(full_col.rbegin(), full_col.rbegin() + rows_to_copy);
-            result.add_column(name, head_col);
+            result.add_column(name, data.at(name).take(indices));
         }
 
         return result;
@@ -163,13 +207,23 @@ class DataFrame {
      * @throws std::invalid_argument If the length of col_data does not match existing rows.
      */
     void add_column(const std::string& name, const ColumnData& col_data) {
-        if (num_rows != 0 && col_data.size() != num_rows) {
+        add_column(name, Column::from_cells(col_data));
+    }
+
+    /**
+     * @brief Adds a new typed column to the DataFrame.
+     * @param name The unique name of the column.
+     * @param col The typed Column, moved into the DataFrame.
+     * @throws std::invalid_argument If the length of col does not match existing rows.
+     */
+    void add_column(const std::string& name, Column col) {
+        if (num_rows != 0 && col.size() != num_rows) {
             throw std::invalid_argument("Column length mismatch.");
         }
-        if (num_rows == 0) num_rows = col_data.size();
-        
+        if (num_rows == 0) num_rows = col.size();
+
         column_names.push_back(name);
-        data[name] = col_data;
+        data[name] = std::move(col);
     }
 
     /**
@@ -211,21 +265,14 @@ class DataFrame {
         std::vector<size_t> keep_indices;
         const auto& target_col = data.at(col_name);
         for (size_t i = 0; i < num_rows; ++i) {
-            if (predicate(target_col[i])) {
+            if (predicate(target_col.get(i))) {
                 keep_indices.push_back(i);
             }
         }
 
         DataFrame filtered_df;
         for (const auto& name : column_names) {
-            ColumnData new_col;
-            new_col.reserve(keep_indices.size());
-            const auto& original_col = data.at(name);
-
-            for (size_t idx : keep_indices) {
-                new_col.push_back(original_col[idx]);
-            }
-            filtered_df.add_column(name, new_col);
+            filtered_df.add_column(name, data.at(name).take(keep_indices));
         }
 
         return filtered_df;
@@ -246,22 +293,29 @@ class DataFrame {
             throw std::invalid_argument("Column not found: " + column_name);
         }
 
-        auto& col = data[column_name];
+        auto& target = data[column_name];
+        if (target.type() != DType::STRING && target.type() != DType::MIXED && target.type() != DType::CATEGORY) {
+            if (val0.empty() || val1.empty()) {
+                throw std::runtime_error("encode_binary requires exactly 2 unique categories in the column.");
+            }
+            return; // Nothing to encode in a purely numeric column
+        }
+
+        // Work on the variant form so that mixed columns keep their numeric cells
+        std::vector<Cell> col = target.to_cells();
 
         // Auto-detect values if not provided
         if (val0.empty() || val1.empty()) {
-            std::set<std::string> unique_values;
-            for (const auto& v : col) {
-                if (std::holds_alternative<std::string>(v)) {
-                    unique_values.insert(std::get<std::string>(v));
-                }
+            std::vector<std::string> unique_values;
+            for (const Cell& v : target.take(Factorize::column(target).first_rows).to_cells()) {
+                if (std::holds_alternative<std::string>(v)) unique_values.push_back(std::get<std::string>(v));
             }
             if (unique_values.size() != 2) {
                 throw std::runtime_error("encode_binary requires exactly 2 unique categories in the column.");
             }
-            auto it = unique_values.begin();
-            val0 = *it;
-            val1 = *(++it);
+            std::sort(unique_values.begin(), unique_values.end());
+            val0 = unique_values[0];
+            val1 = unique_values[1];
         }
 
         // Perform the transformation
@@ -273,6 +327,7 @@ class DataFrame {
                 else throw std::runtime_error("Unexpected value in binary encoding: " + current_val);
             }
         }
+        target = Column::from_cells(col);
     }
 
     /**
@@ -284,19 +339,339 @@ class DataFrame {
     Matrix<double> to_matrix(const std::vector<std::string>& target_columns) const {
         Matrix<double> result(num_rows, target_columns.size());
         
-        for (size_t c = 0; c < target_columns.size(); ++c) {
-            const auto& col = data.at(target_columns[c]);
-            for (size_t r = 0; r < num_rows; ++r) {
-                // Visit the variant to extract a double, even if it's stored as int
-                result(r, c) = std::visit([](auto&& arg) -> double {
-                    using T = std::decay_t<decltype(arg)>;
-                    if constexpr (std::is_arithmetic_v<T>) return static_cast<double>(arg);
-                    return 0.0; // Default for non-numeric
-                }, col[r]);
+        size_t n_cols = target_columns.size();
+        double* out = result.data_ptr();
+        for (size_t c = 0; c < n_cols; ++c) {
+            const Column& col = data.at(target_columns[c]);
+            switch (col.has_nulls() ? DType::MIXED : col.type()) {
+                case DType::FLOAT64: {
+                    const double* src = col.doubles().data();
+                    for (size_t r = 0; r < num_rows; ++r) out[r * n_cols + c] = src[r];
+                    break;
+                }
+                case DType::INT32: {
+                    const int* src = col.ints().data();
+                    for (size_t r = 0; r < num_rows; ++r) out[r * n_cols + c] = static_cast<double>(src[r]);
+                    break;
+                }
+                default:
+                    // Strings become 0.0, nulls NaN and every other value is cast to double
+                    for (size_t r = 0; r < num_rows; ++r) out[r * n_cols + c] = col.as_double(r);
+                    break;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Builds a mergeable quantile sketch of a numeric column in one parallel pass.
+     * @param col_name The name of the column.
+     * @param k The KLL accuracy parameter (rank error is roughly 1.65 / k).
+     * @return The KLLSketch summarising the column.
+     * @throws std::invalid_argument If the column is not found or holds only strings.
+     */
+    KLLSketch quantile_sketch(const std::string& col_name, size_t k = 200) const {
+        return Sketches::quantile_sketch(column(col_name), k);
+    }
+
+    /**
+     * @brief Builds a mergeable distinct-count sketch of a column in one parallel pass.
+     * @param col_name The name of the column.
+     * @param precision The HyperLogLog precision (4 to 18).
+     * @return The HyperLogLog sketch summarising the column.
+     * @throws std::invalid_argument If the column is not found.
+     */
+    HyperLogLog distinct_sketch(const std::string& col_name, int precision = 14) const {
+        return Sketches::distinct_sketch(column(col_name), precision);
+    }
+
+    /**
+     * @brief Returns the distinct values of a column in order of first appearance.
+     * * Uses a parallel hash factorization of the typed column buffer, so only
+     * the distinct values (not every row) are materialised as cells.
+     * @param col_name The name of the column.
+     * @return The distinct values of the column.
+     * @throws std::invalid_argument If the column is not found.
+     */
+    ColumnData unique(const std::string& col_name) const {
+        const Column& col = column(col_name);
+        return col.take(Factorize::column(col).first_rows).to_cells();
+    }
+
+    /**
+     * @brief Counts the occurrences of each distinct value in a column.
+     * * Values are ordered by descending count; ties keep first-appearance order.
+     * @param col_name The name of the column.
+     * @return A DataFrame with the distinct values in a column named col_name and their
+     * counts in an int64 column "count".
+     * @throws std::invalid_argument If the column is not found.
+     */
+    DataFrame value_counts(const std::string& col_name) const {
+        const Column& col = column(col_name);
+        Factorization f = Factorize::column(col);
+
+        // Every extra block needs its own histogram, so blocks get at least four rows
+        // per distinct value; high-cardinality columns are counted on one thread
+        std::vector<int64_t> counts(f.num_unique(), 0);
+        std::vector<std::vector<int64_t>> partial(Parallel::resolve_threads(0));
+        Parallel::parallel_blocks(0, num_rows, [&](size_t lo, size_t hi, size_t block) {
+            std::vector<int64_t>& local = block == 0 ? counts : partial[block];
+            local.resize(f.num_unique(), 0);
+            for (size_t i = lo; i < hi; ++i) ++local[f.codes[i]];
+        }, 0, std::max<size_t>(16384, 4 * f.num_unique()));
+        for (const auto& p : partial) {
+            for (size_t c = 0; c < p.size(); ++c) counts[c] += p[c];
+        }
+
+        std::vector<size_t> order(f.num_unique());
+        for (size_t c = 0; c < order.size(); ++c) order[c] = c;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return counts[a] > counts[b]; });
+
+        std::vector<size_t> rows(order.size());
+        std::vector<int64_t> sorted_counts(order.size());
+        for (size_t k = 0; k < order.size(); ++k) {
+            rows[k] = f.first_rows[order[k]];
+            sorted_counts[k] = counts[order[k]];
+        }
+
+        DataFrame result;
+        result.add_column(col_name, col.take(rows));
+        result.add_column(col_name == "count" ? "count_" : "count", Column(std::move(sorted_counts)));
+        return result;
+    }
+
+    /**
+     * @brief Returns a DataFrame without duplicate rows, keeping first occurrences.
+     * * Rows are compared on the subset columns by hashing the typed buffers of
+     * each column into dense codes and then hashing the per-row code tuples.
+     * @param subset The columns to compare (all columns if empty).
+     * @return A new DataFrame containing the first occurrence of each distinct row.
+     * @throws std::invalid_argument If a subset column is not found.
+     */
+    DataFrame drop_duplicates(const std::vector<std::string>& subset = {}) const {
+        const std::vector<std::string>& keys = subset.empty() ? column_names : subset;
+        if (keys.empty() || num_rows == 0) return *this;
+
+        std::vector<const Column*> key_columns;
+        for (const auto& name : keys) key_columns.push_back(&column(name));
+        std::vector<size_t> rows = Factorize::rows(key_columns).first_rows;
+
+        DataFrame result;
+        for (const auto& name : column_names) result.add_column(name, data.at(name).take(rows));
+        return result;
+    }
+
+    /**
+     * @brief Writes the DataFrame to a Daedalus columnar (.dcol) file.
+     * * The file stores typed column chunks with per-chunk statistics and a
+     * schema footer (see Columnar.h), so it can be memory-mapped and read back
+     * without parsing. Read it with read_dcol.
+     * @param path The output path.
+     * @param compression "lz4" (default) or "none". Uncompressed numeric columns
+     *                    can be viewed in place from the mapped file.
+     * @param chunk_rows Rows per chunk; the unit of statistics-based skipping.
+     * @throws std::invalid_argument If compression is unknown.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void save(const std::string& path, const std::string& compression = "lz4", size_t chunk_rows = 65536) const {
+        std::vector<const Column*> columns;
+        for (const auto& name : column_names) columns.push_back(&data.at(name));
+        Dcol::write(path, column_names, columns, compression, chunk_rows);
+    }
+
+    /**
+     * @brief Writes the DataFrame to a CSV file.
+     * * Numbers are formatted with std::to_chars (shortest representation that
+     * reads back exactly), bools as true/false and categories as their string.
+     * Nulls are written as empty fields, and text containing the delimiter, a
+     * quote or a line break is quoted (RFC 4180), so read_csv reads the file
+     * back. Blocks of rows are formatted in parallel and written in order.
+     * @param path The output path (overwritten).
+     * @param header If true (default), the first line holds the column names.
+     * @param delimiter The field separator.
+     * @param num_threads Number of formatting threads (0 means use all hardware threads).
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void to_csv(const std::string& path, bool header = true, char delimiter = ',', size_t num_threads = 0) const {
+        std::vector<const Column*> columns;
+        for (const auto& name : column_names) columns.push_back(&data.at(name));
+
+        std::string head;
+        if (header && !column_names.empty()) {
+            for (size_t c = 0; c < column_names.size(); ++c) {
+                if (c > 0) head.push_back(delimiter);
+                Csv::append_text(head, column_names[c], delimiter);
+            }
+            head.push_back('\n');
+        }
+
+        Csv::write_blocks(path, head, num_rows, columns.size() * 12 + 1, [&](size_t lo, size_t hi, std::string& out) {
+            for (size_t i = lo; i < hi; ++i) {
+                for (size_t c = 0; c < columns.size(); ++c) {
+                    if (c > 0) out.push_back(delimiter);
+                    append_csv_field(out, *columns[c], i, delimiter);
+                }
+                out.push_back('\n');
+            }
+        }, num_threads);
+    }
+
+    /**
+     * @brief Appends the rows of another DataFrame in-place.
+     * * The batch must contain the same column names (in any order). Each column
+     * is widened once if the batch holds a wider type (int32 to float64, or to
+     * mixed), then the typed buffers are extended with geometric growth so that
+     * repeated appends cost amortized O(1) per row.
+     * @param batch The DataFrame whose rows are appended.
+     * @throws std::invalid_argument If the column names do not match.
+     */
+    void append_rows(const DataFrame& batch) {
+        if (column_names.empty()) {
+            *this = batch;
+            return;
+        }
+        check_same_columns(batch);
+
+        // Small batches (a streaming reader's) are appended on the calling thread
+        size_t min_columns = std::max<size_t>(1, MIN_CELLS_PER_THREAD / std::max<size_t>(batch.num_rows, 1));
+        Parallel::parallel_for(0, column_names.size(), [&](size_t c) {
+            const std::string& name = column_names[c];
+            data.at(name).append(batch.data.at(name));
+        }, 0, min_columns);
+        num_rows += batch.num_rows;
+    }
+
+    /**
+     * @brief Concatenates DataFrames along rows (axis 0) or columns (axis 1).
+     * * For axis 0 every frame must share the column names of the first frame.
+     * The output type of each column is the promotion of its input types, each
+     * output buffer is allocated once at its final size and every (column, frame)
+     * segment is copied in parallel into its slot.
+     * For axis 1 every frame must have the same number of rows and column names
+     * must be unique across frames.
+     * @param frames The DataFrames to concatenate, in order (not copied).
+     * @param axis 0 to stack rows, 1 to place columns side by side.
+     * @return A new DataFrame holding the concatenated data.
+     * @throws std::invalid_argument If shapes or column names are incompatible, or axis is not 0 or 1.
+     */
+    static DataFrame concat(const std::vector<const DataFrame*>& frames, int axis = 0) {
+        if (axis != 0 && axis != 1) {
+            throw std::invalid_argument("Axis must be 0 (rows) or 1 (columns).");
+        }
+        DataFrame result;
+        if (frames.empty()) return result;
+
+        if (axis == 1) {
+            std::unordered_set<std::string> seen;
+            for (const DataFrame* frame : frames) {
+                if (frame->cols() != 0 && result.cols() != 0 && frame->num_rows != result.num_rows) {
+                    throw std::invalid_argument("All DataFrames must have the same number of rows for axis 1.");
+                }
+                for (const auto& name : frame->column_names) {
+                    if (!seen.insert(name).second) {
+                        throw std::invalid_argument("Duplicate column name in concat: " + name);
+                    }
+                    result.add_column(name, frame->data.at(name));
+                }
+            }
+            return result;
+        }
+
+        const DataFrame& first = *frames[0];
+        std::vector<size_t> offsets(frames.size() + 1, 0);
+        for (size_t f = 0; f < frames.size(); ++f) {
+            if (f > 0) first.check_same_columns(*frames[f]);
+            offsets[f + 1] = offsets[f] + frames[f]->num_rows;
+        }
+        size_t total_rows = offsets.back();
+
+        // Reconcile the schema once per column and allocate the final buffers
+        for (const auto& name : first.column_names) {
+            DType target = first.data.at(name).type();
+            bool any_rows = false;
+            for (const DataFrame* frame : frames) {
+                const Column& col = frame->data.at(name);
+                if (col.size() == 0) continue;
+                target = any_rows ? Column::promote(target, col.type()) : col.type();
+                any_rows = true;
+            }
+            Column out(target);
+            for (const DataFrame* frame : frames) out.merge_categories(frame->data.at(name));
+            out.resize(total_rows);
+            result.column_names.push_back(name);
+            result.data.emplace(name, std::move(out));
+        }
+        result.num_rows = total_rows;
+
+        // Each (column, frame) pair writes a disjoint slice of the output
+        size_t n_cols = first.column_names.size();
+        std::vector<Column*> outputs(n_cols);
+        for (size_t c = 0; c < n_cols; ++c) outputs[c] = &result.data.at(first.column_names[c]);
+
+        size_t rows_per_task = std::max<size_t>(1, total_rows / frames.size());
+        Parallel::parallel_for(0, n_cols * frames.size(), [&](size_t task) {
+            size_t c = task / frames.size();
+            size_t f = task % frames.size();
+            outputs[c]->copy_from(frames[f]->data.at(first.column_names[c]), offsets[f]);
+        }, 0, std::max<size_t>(1, MIN_CELLS_PER_THREAD / rows_per_task));
+
+        // Null bitmaps can share words across segments, so they are merged serially
+        for (size_t c = 0; c < n_cols; ++c) {
+            for (size_t f = 0; f < frames.size(); ++f) {
+                outputs[c]->copy_nulls_from(frames[f]->data.at(first.column_names[c]), offsets[f]);
             }
         }
+
         return result;
     }
+
+    /**
+     * @brief Concatenates DataFrames along rows (axis 0) or columns (axis 1).
+     * * See the overload taking pointers, which this forwards to.
+     * @throws std::invalid_argument If shapes or column names are incompatible, or axis is not 0 or 1.
+     */
+    static DataFrame concat(const std::vector<DataFrame>& frames, int axis = 0) {
+        std::vector<const DataFrame*> pointers;
+        pointers.reserve(frames.size());
+        for (const auto& frame : frames) pointers.push_back(&frame);
+        return concat(pointers, axis);
+    }
+
+private:
+    /** @brief Appends row i of a column as a CSV field (empty if null). */
+    static void append_csv_field(std::string& out, const Column& col, size_t i, char delimiter) {
+        if (col.is_null(i)) return;
+        switch (col.type()) {
+            case DType::FLOAT64: Csv::append_double(out, col.doubles()[i]); break;
+            case DType::INT32: Csv::append_int(out, col.ints()[i]); break;
+            case DType::INT64: Csv::append_int(out, col.int64s()[i]); break;
+            case DType::BOOL: out += col.bools()[i] ? "true" : "false"; break;
+            case DType::STRING: Csv::append_text(out, col.strings()[i], delimiter); break;
+            case DType::CATEGORY: Csv::append_text(out, col.categories()[col.ints()[i]], delimiter); break;
+            default: {
+                const Cell& cell = col.cells()[i];
+                if (const auto* d = std::get_if<double>(&cell)) Csv::append_double(out, *d);
+                else if (const auto* v = std::get_if<int>(&cell)) Csv::append_int(out, *v);
+                else Csv::append_text(out, std::get<std::string>(cell), delimiter);
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Ensures another DataFrame holds exactly the same column names.
+     * @throws std::invalid_argument If the column sets differ.
+     */
+    void check_same_columns(const DataFrame& other) const {
+        if (other.column_names.size() != column_names.size()) {
+            throw std::invalid_argument("DataFrames must have the same columns.");
+        }
+        for (const auto& name : column_names) {
+            if (other.data.find(name) == other.data.end()) {
+                throw std::invalid_argument("DataFrames must have the same columns. Missing: " + name);
+            }
+        }
+    }
 };
 
 #endif // DATAFRAME_H
\ No newline at end of file
@@ -0,0 +1,221 @@
+/**
+ * @file Factorize.h
+ * @brief Hash-based factorization (dictionary encoding) of columns and rows.
+ * * Factorizing maps every row to a dense code identifying its distinct value,
+ * numbered in order of first appearance. unique, value_counts and
+ * drop_duplicates are all built on top of it.
+ */
+
+// include/daedalus/core/Factorize.h
+
+#ifndef FACTORIZE_H
+#define FACTORIZE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <variant>
+#include <stdexcept>
+#include "Column.h"
+#include "Hash.h"
+#include "Parallel.h"
+
+/**
+ * @struct Factorization
+ * @brief Dense codes for a sequence of keys.
+ * * codes[i] is the code of row i, and first_rows[c] is the first row whose
+ * key has code c. Codes are numbered in order of first appearance, so
+ * first_rows is strictly increasing.
+ */
+struct Factorization {
+    std::vector<uint32_t> codes;
+    std::vector<size_t> first_rows;
+
+    /** @brief Returns the number of distinct keys. */
+    size_t num_unique() const { return first_rows.size(); }
+};
+
+/**
+ * @namespace Factorize
+ * @brief Parallel open-addressing factorization over typed Column buffers.
+ * * Each thread factorizes a contiguous block of rows into its own HashIndex.
+ * The per-block distinct keys are then merged in block order into a global
+ * index (which preserves first-appearance order) and every thread remaps its
+ * block's codes to the global codes.
+ */
+namespace Factorize {
+    /**
+     * @brief Factorizes rows [0, n) given a hash and an equality function over row indices.
+     * @param n Number of rows.
+     * @param hash Callable hash(i) returning the 64-bit hash of row i's key.
+     * @param equal Callable equal(i, j) returning true if rows i and j have equal keys.
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     * @return The Factorization of the rows.
+     */
+    template <typename HashFn, typename EqualFn>
+    Factorization keys(size_t n, HashFn&& hash, EqualFn&& equal, size_t num_threads = 0) {
+        struct Block {
+            size_t lo = 0, hi = 0;
+            std::vector<size_t> first_rows;
+            std::vector<uint64_t> hashes;
+            std::vector<uint32_t> to_global;
+        };
+
+        Factorization result;
+        result.codes.resize(n);
+        std::vector<Block> blocks(Parallel::resolve_threads(num_threads));
+
+        // 1. Each block builds a local dictionary and writes block-local codes
+        Parallel::parallel_blocks(0, n, [&](size_t lo, size_t hi, size_t b) {
+            Block& block = blocks[b];
+            block.lo = lo;
+            block.hi = hi;
+            HashIndex index;
+            for (size_t i = lo; i < hi; ++i) {
+                uint64_t h = hash(i);
+                auto found = index.insert(h, static_cast<uint32_t>(block.first_rows.size()), [&](uint32_t id) {
+                    return equal(block.first_rows[id], i);
+                });
+                if (found.second) {
+                    block.first_rows.push_back(i);
+                    block.hashes.push_back(h);
+                }
+                result.codes[i] = found.first;
+            }
+        }, num_threads, 16384);
+
+        // 2. Merge the local dictionaries in block order
+        size_t expected = 0;
+        for (const auto& block : blocks) expected = std::max(expected, block.first_rows.size());
+        HashIndex global(expected);
+        for (auto& block : blocks) {
+            block.to_global.resize(block.first_rows.size());
+            for (size_t u = 0; u < block.first_rows.size(); ++u) {
+                size_t row = block.first_rows[u];
+                auto found = global.insert(block.hashes[u], static_cast<uint32_t>(result.first_rows.size()), [&](uint32_t id) {
+                    return equal(result.first_rows[id], row);
+                });
+                if (found.second) result.first_rows.push_back(row);
+                block.to_global[u] = found.first;
+            }
+        }
+
+        // 3. Remap block-local codes to global codes
+        Parallel::parallel_for(0, blocks.size(), [&](size_t b) {
+            const Block& block = blocks[b];
+            for (size_t i = block.lo; i < block.hi; ++i) result.codes[i] = block.to_global[result.codes[i]];
+        }, num_threads);
+
+        return result;
+    }
+
+    /**
+     * @brief Factorizes a Column with per-row hash and equality functions, treating nulls as one key.
+     */
+    template <typename HashFn, typename EqualFn>
+    Factorization with_nulls(const Column& col, HashFn&& hash, EqualFn&& equal, size_t num_threads) {
+        if (!col.has_nulls()) return keys(col.size(), hash, equal, num_threads);
+        const uint64_t null_hash = Hash::mix64(0x6e756c6cULL);
+        return keys(col.size(),
+            [&](size_t i) { return col.is_null(i) ? null_hash : hash(i); },
+            [&](size_t i, size_t j) {
+                bool a = col.is_null(i), b = col.is_null(j);
+                return (a || b) ? (a && b) : equal(i, j);
+            }, num_threads);
+    }
+
+    /**
+     * @brief Factorizes a single Column by hashing its typed buffer directly.
+     * * NaN values compare equal to each other, and so do nulls. In a mixed
+     * column an int and a double are distinct keys even when numerically equal,
+     * matching Cell equality. Category columns are factorized on their integer
+     * codes, without touching the dictionary strings.
+     * @param col The column to factorize.
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     */
+    inline Factorization column(const Column& col, size_t num_threads = 0) {
+        switch (col.type()) {
+            case DType::FLOAT64: {
+                const double* v = col.doubles().data();
+                return with_nulls(col, [v](size_t i) { return Hash::number(v[i]); },
+                    [v](size_t i, size_t j) { return v[i] == v[j] || (std::isnan(v[i]) && std::isnan(v[j])); },
+                    num_threads);
+            }
+            case DType::INT32: case DType::CATEGORY: {
+                const int* v = col.ints().data();
+                return with_nulls(col, [v](size_t i) { return Hash::mix64(static_cast<uint64_t>(static_cast<int64_t>(v[i]))); },
+                    [v](size_t i, size_t j) { return v[i] == v[j]; }, num_threads);
+            }
+            case DType::INT64: {
+                const int64_t* v = col.int64s().data();
+                return with_nulls(col, [v](size_t i) { return Hash::mix64(static_cast<uint64_t>(v[i])); },
+                    [v](size_t i, size_t j) { return v[i] == v[j]; }, num_threads);
+            }
+            case DType::BOOL: {
+                const uint8_t* v = col.bools().data();
+                return with_nulls(col, [v](size_t i) { return Hash::mix64(v[i]); },
+                    [v](size_t i, size_t j) { return v[i] == v[j]; }, num_threads);
+            }
+            case DType::STRING: {
+                const std::string* v = col.strings().data();
+                return with_nulls(col, [v](size_t i) { return Hash::text(v[i]); },
+                    [v](size_t i, size_t j) { return v[i] == v[j]; }, num_threads);
+            }
+            default: {
+                const Cell* v = col.cells().data();
+                auto hash = [v](size_t i) {
+                    if (const auto* s = std::get_if<std::string>(&v[i])) return Hash::text(*s);
+                    if (const auto* d = std::get_if<double>(&v[i])) return Hash::number(*d);
+                    return Hash::number(static_cast<double>(std::get<int>(v[i])));
+                };
+                auto equal = [v](size_t i, size_t j) {
+                    if (v[i].index() != v[j].index()) return false;
+                    if (const auto* d = std::get_if<double>(&v[i])) {
+                        double e = std::get<double>(v[j]);
+                        return *d == e || (std::isnan(*d) && std::isnan(e));
+                    }
+                    return v[i] == v[j];
+                };
+                return with_nulls(col, hash, equal, num_threads);
+            }
+        }
+    }
+
+    /**
+     * @brief Factorizes whole rows across several equally sized columns.
+     * * Each column is factorized first, so rows are then hashed and compared
+     * as small tuples of integer codes regardless of the column types.
+     * @param columns The columns forming the row key.
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     * @throws std::invalid_argument If the columns have different lengths.
+     */
+    inline Factorization rows(const std::vector<const Column*>& columns, size_t num_threads = 0) {
+        if (columns.empty()) throw std::invalid_argument("At least one column is required to factorize rows.");
+        if (columns.size() == 1) return column(*columns[0], num_threads);
+
+        size_t n = columns[0]->size();
+        std::vector<std::vector<uint32_t>> codes;
+        codes.reserve(columns.size());
+        for (const Column* col : columns) {
+            if (col->size() != n) throw std::invalid_argument("All columns must have the same length.");
+            codes.push_back(column(*col, num_threads).codes);
+        }
+
+        auto hash = [&codes](size_t i) {
+            uint64_t h = 0;
+            for (const auto& c : codes) h = Hash::combine(h, c[i]);
+            return h;
+        };
+        auto equal = [&codes](size_t i, size_t j) {
+            for (const auto& c : codes) {
+                if (c[i] != c[j]) return false;
+            }
+            return true;
+        };
+        return keys(n, hash, equal, num_threads);
+    }
+}
+
+#endif // FACTORIZE_H
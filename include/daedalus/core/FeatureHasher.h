@@ -0,0 +1,232 @@
+/**
+ * @file FeatureHasher.h
+ * @brief The hashing trick: maps DataFrame columns to a fixed-width sparse feature space.
+ * * Each categorical value becomes the feature "column=value" and each numeric
+ * value the feature "column" weighted by the value. A feature's column in the
+ * output is its hash modulo n_features, so no vocabulary is built or stored and
+ * rows can be hashed independently, in parallel. Collisions are expected; with
+ * alternate_sign the sign of each entry is taken from another bit of the hash,
+ * so colliding features cancel on average instead of accumulating.
+ */
+
+// include/daedalus/core/FeatureHasher.h
+
+#ifndef FEATUREHASHER_H
+#define FEATUREHASHER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "DataFrame.h"
+#include "Hash.h"
+#include "Parallel.h"
+#include "SparseMatrix.h"
+
+/**
+ * @class FeatureHasher
+ * @brief Hashes categorical, numeric and tokenized text columns of a DataFrame into a CSR matrix.
+ * * Values are hashed with MurmurHash64A (Hash::bytes), seeded with the hash of
+ * the column name, so "a=x" and "b=x" land in different places without any
+ * string concatenation. A category column hashes each distinct dictionary
+ * entry once and then looks rows up by code.
+ */
+class FeatureHasher {
+public:
+    /** @brief Default number of output columns. */
+    static constexpr size_t DEFAULT_FEATURES = size_t(1) << 20;
+
+private:
+    size_t n_features;
+    bool alternate_sign;
+    uint64_t seed;
+
+    /** @brief Minimum number of rows handed to one thread. */
+    static constexpr size_t MIN_ROWS_PER_THREAD = 2048;
+
+    /** @brief How the values of one input column become features. */
+    struct ColumnPlan {
+        const Column* column;
+        bool text;
+        uint64_t name_seed;                       // Seeds the hash of this column's values
+        uint64_t name_hash;                       // Feature of a numeric value
+        std::vector<uint64_t> category_hashes;    // Per dictionary entry, for category columns
+    };
+
+    struct Entry {
+        uint32_t index;
+        double value;
+    };
+
+    /** @brief The CSR rows produced by one block of input rows. */
+    struct Block {
+        size_t first_row = 0;
+        std::vector<size_t> row_nnz;
+        std::vector<uint32_t> indices;
+        std::vector<double> values;
+    };
+
+    /** @brief Appends the entry of hash h with the given value. */
+    void emit(uint64_t h, double value, std::vector<Entry>& row) const {
+        if (value == 0.0 || std::isnan(value)) return;
+        if (alternate_sign && (h >> 63)) value = -value;
+        row.push_back({static_cast<uint32_t>((h & 0x7fffffffffffffffULL) % n_features), value});
+    }
+
+    /** @brief Emits one entry per token (a maximal run of letters, digits and non-ASCII bytes), lower-cased. */
+    void emit_tokens(const std::string& text, uint64_t name_seed, std::string& token, std::vector<Entry>& row) const {
+        auto is_token_byte = [](unsigned char c) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+        };
+        size_t i = 0, n = text.size();
+        while (i < n) {
+            while (i < n && !is_token_byte(static_cast<unsigned char>(text[i]))) ++i;
+            token.clear();
+            while (i < n && is_token_byte(static_cast<unsigned char>(text[i]))) {
+                char c = text[i++];
+                token.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c);
+            }
+            if (!token.empty()) emit(Hash::bytes(token.data(), token.size(), name_seed), 1.0, row);
+        }
+    }
+
+    /** @brief Emits the features of row r of one column. */
+    void emit_cell(const ColumnPlan& plan, size_t r, std::string& token, std::vector<Entry>& row) const {
+        const Column& col = *plan.column;
+        if (col.is_null(r)) return;
+        auto emit_string = [&](const std::string& s) {
+            if (plan.text) {
+                emit_tokens(s, plan.name_seed, token, row);
+            } else {
+                emit(Hash::bytes(s.data(), s.size(), plan.name_seed), 1.0, row);
+            }
+        };
+        switch (col.type()) {
+            case DType::FLOAT64: emit(plan.name_hash, col.doubles()[r], row); break;
+            case DType::INT32: emit(plan.name_hash, static_cast<double>(col.ints()[r]), row); break;
+            case DType::INT64: emit(plan.name_hash, static_cast<double>(col.int64s()[r]), row); break;
+            case DType::BOOL: emit(plan.name_hash, static_cast<double>(col.bools()[r]), row); break;
+            case DType::STRING: emit_string(col.strings()[r]); break;
+            case DType::CATEGORY: {
+                int code = col.ints()[r];
+                if (plan.text) {
+                    emit_string(col.categories()[static_cast<size_t>(code)]);
+                } else {
+                    emit(plan.category_hashes[static_cast<size_t>(code)], 1.0, row);
+                }
+                break;
+            }
+            default: {
+                const Cell& cell = col.cells()[r];
+                if (const auto* s = std::get_if<std::string>(&cell)) {
+                    emit_string(*s);
+                } else if (const auto* i = std::get_if<int>(&cell)) {
+                    emit(plan.name_hash, static_cast<double>(*i), row);
+                } else {
+                    emit(plan.name_hash, std::get<double>(cell), row);
+                }
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Constructs the hasher.
+     * @param features Number of output columns (a power of two spreads hashes most evenly).
+     * @param signed_hash Whether to flip the sign of entries using a bit of the hash.
+     * @param hash_seed Seed selecting an independent hash function.
+     * @throws std::invalid_argument If features is 0 or does not fit a 32-bit column index.
+     */
+    explicit FeatureHasher(size_t features = DEFAULT_FEATURES, bool signed_hash = true, uint64_t hash_seed = 0)
+        : n_features(features), alternate_sign(signed_hash), seed(hash_seed) {
+        if (features == 0 || features > std::numeric_limits<uint32_t>::max()) {
+            throw std::invalid_argument("n_features must be between 1 and 2^32 - 1.");
+        }
+    }
+
+    size_t get_n_features() const { return n_features; }
+
+    /**
+     * @brief Hashes the given columns of df into a (rows x n_features) CSR matrix.
+     * * Every thread hashes a block of rows into its own CSR fragment, sorting
+     * each row's entries and summing duplicates; the fragments are then
+     * concatenated in parallel. Null cells and zero values produce no entry.
+     * @param df The data.
+     * @param columns Columns hashed as a single value per cell (strings and categories
+     *        as "column=value", numbers as "column" with the cell's value).
+     * @param text_columns String columns split into lower-cased alphanumeric tokens,
+     *        each hashed as "column=token" with a count of 1 per occurrence.
+     * @throws std::invalid_argument If a column does not exist.
+     */
+    SparseMatrix<double> transform(const DataFrame& df, const std::vector<std::string>& columns,
+                                   const std::vector<std::string>& text_columns = {}) const {
+        std::vector<ColumnPlan> plans;
+        auto plan_column = [&](const std::string& name, bool text) {
+            ColumnPlan plan{&df.column(name), text, Hash::text(name, seed), 0, {}};
+            plan.name_hash = Hash::mix64(plan.name_seed);
+            if (!text && plan.column->type() == DType::CATEGORY) {
+                for (const auto& value : plan.column->categories()) {
+                    plan.category_hashes.push_back(Hash::bytes(value.data(), value.size(), plan.name_seed));
+                }
+            }
+            plans.push_back(std::move(plan));
+        };
+        for (const auto& name : columns) plan_column(name, false);
+        for (const auto& name : text_columns) plan_column(name, true);
+
+        size_t n = df.rows();
+        std::vector<Block> blocks(Parallel::resolve_threads(0));
+        Parallel::parallel_blocks(0, n, [&](size_t lo, size_t hi, size_t b) {
+            Block& block = blocks[b];
+            block.first_row = lo;
+            block.row_nnz.reserve(hi - lo);
+            std::vector<Entry> row;
+            std::string token;
+            for (size_t r = lo; r < hi; ++r) {
+                row.clear();
+                for (const auto& plan : plans) emit_cell(plan, r, token, row);
+                std::sort(row.begin(), row.end(), [](const Entry& a, const Entry& c) { return a.index < c.index; });
+                size_t before = block.indices.size();
+                for (size_t e = 0; e < row.size();) {
+                    uint32_t index = row[e].index;
+                    double sum = 0.0;
+                    for (; e < row.size() && row[e].index == index; ++e) sum += row[e].value;
+                    if (sum != 0.0) {
+                        block.indices.push_back(index);
+                        block.values.push_back(sum);
+                    }
+                }
+                block.row_nnz.push_back(block.indices.size() - before);
+            }
+        }, 0, MIN_ROWS_PER_THREAD);
+
+        // Concatenate the fragments in row order
+        std::vector<Block*> used;
+        for (auto& block : blocks) {
+            if (!block.row_nnz.empty()) used.push_back(&block);
+        }
+        std::sort(used.begin(), used.end(), [](const Block* a, const Block* c) { return a->first_row < c->first_row; });
+        std::vector<size_t> indptr(n + 1, 0);
+        std::vector<size_t> offsets;
+        size_t r = 0;
+        for (const Block* block : used) {
+            offsets.push_back(indptr[r]);
+            for (size_t count : block->row_nnz) {
+                indptr[r + 1] = indptr[r] + count;
+                ++r;
+            }
+        }
+        std::vector<uint32_t> indices(indptr[n]);
+        std::vector<double> values(indptr[n]);
+        Parallel::parallel_for(0, used.size(), [&](size_t b) {
+            std::copy(used[b]->indices.begin(), used[b]->indices.end(), indices.begin() + static_cast<std::ptrdiff_t>(offsets[b]));
+            std::copy(used[b]->values.begin(), used[b]->values.end(), values.begin() + static_cast<std::ptrdiff_t>(offsets[b]));
+        }, used.size());
+        return SparseMatrix<double>(n, n_features, std::move(indptr), std::move(indices), std::move(values));
+    }
+};
+
+#endif // FEATUREHASHER_H
@@ -0,0 +1,48 @@
+/**
+ * @file FeatureProducts.h
+ * @brief The X^T * e products behind the gradient-descent fits of the linear models.
+ * * LinearRegression and LogisticRegression accept dense, sparse and
+ * polynomial features through one templated gradient_descent. Each fit calls
+ * transposed(X) once and then transpose_times(XT, e) every epoch, so sparse
+ * features are transposed once per fit while dense and polynomial features
+ * are used as they are.
+ */
+
+// include/daedalus/core/FeatureProducts.h
+
+#ifndef FEATUREPRODUCTS_H
+#define FEATUREPRODUCTS_H
+
+#include "Matrix.h"
+#include "SparseMatrix.h"
+#include "Preprocessing.h"
+
+/**
+ * @namespace FeatureProducts
+ * @brief Per-fit preparation and per-epoch X^T * e for each feature type.
+ */
+namespace FeatureProducts {
+    /** @brief Returns X^T * e for dense features. */
+    inline Matrix<double> transpose_times(const Matrix<double>& X, const Matrix<double>& e) {
+        return X.transpose() * e;
+    }
+
+    /** @brief Returns X^T * e for sparse features, given the X^T built by transposed(). */
+    inline Matrix<double> transpose_times(const SparseMatrix<double>& XT, const Matrix<double>& e) {
+        return XT * e;
+    }
+
+    /** @brief Returns X^T * e for polynomial features, expanding one batch of rows at a time. */
+    inline Matrix<double> transpose_times(const PolynomialExpansion& X, const Matrix<double>& e) {
+        return X.transpose_multiply(e);
+    }
+
+    /** @brief Dense and polynomial features are passed to transpose_times() as they are. */
+    inline const Matrix<double>& transposed(const Matrix<double>& X) { return X; }
+    inline const PolynomialExpansion& transposed(const PolynomialExpansion& X) { return X; }
+
+    /** @brief Sparse features are transposed once per fit rather than once per epoch. */
+    inline SparseMatrix<double> transposed(const SparseMatrix<double>& X) { return X.transpose(); }
+}
+
+#endif // FEATUREPRODUCTS_H
@@ -0,0 +1,183 @@
+/**
+ * @file Hash.h
+ * @brief Fast non-cryptographic hash functions used by sketches and hash tables.
+ */
+
+// include/daedalus/core/Hash.h
+
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+/**
+ * @namespace Hash
+ * @brief 64-bit hashing helpers for numbers and byte strings.
+ */
+namespace Hash {
+    /**
+     * @brief Finalization mix of MurmurHash3 (fmix64).
+     * * A bijective avalanche step: every input bit affects every output bit.
+     * @param x The value to mix.
+     * @return The mixed 64-bit value.
+     */
+    inline uint64_t mix64(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    /**
+     * @brief MurmurHash64A over an arbitrary byte range.
+     * @param key Pointer to the bytes to hash.
+     * @param len Number of bytes.
+     * @param seed Seed that selects an independent hash function.
+     * @return The 64-bit hash.
+     */
+    inline uint64_t bytes(const void* key, size_t len, uint64_t seed = 0) {
+        const uint64_t m = 0xc6a4a7935bd1e995ULL;
+        const int r = 47;
+        const unsigned char* data = static_cast<const unsigned char*>(key);
+        uint64_t h = seed ^ (static_cast<uint64_t>(len) * m);
+
+        size_t n_blocks = len / 8;
+        for (size_t i = 0; i < n_blocks; ++i) {
+            uint64_t k;
+            std::memcpy(&k, data + i * 8, sizeof(k));
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+            h ^= k;
+            h *= m;
+        }
+
+        const unsigned char* tail = data + n_blocks * 8;
+        switch (len & 7) {
+            case 7: h ^= static_cast<uint64_t>(tail[6]) << 48; [[fallthrough]];
+            case 6: h ^= static_cast<uint64_t>(tail[5]) << 40; [[fallthrough]];
+            case 5: h ^= static_cast<uint64_t>(tail[4]) << 32; [[fallthrough]];
+            case 4: h ^= static_cast<uint64_t>(tail[3]) << 24; [[fallthrough]];
+            case 3: h ^= static_cast<uint64_t>(tail[2]) << 16; [[fallthrough]];
+            case 2: h ^= static_cast<uint64_t>(tail[1]) << 8; [[fallthrough]];
+            case 1: h ^= static_cast<uint64_t>(tail[0]);
+                    h *= m;
+        }
+
+        h ^= h >> r;
+        h *= m;
+        h ^= h >> r;
+        return h;
+    }
+
+    /** @brief Hashes the bytes of a string. */
+    inline uint64_t text(const std::string& s, uint64_t seed = 0) {
+        return bytes(s.data(), s.size(), seed);
+    }
+
+    /**
+     * @brief Hashes a double so that equal values hash equally.
+     * * -0.0 is folded onto 0.0 and every NaN onto a single canonical NaN.
+     * Integers stored as doubles therefore hash the same as the double itself.
+     */
+    inline uint64_t number(double v, uint64_t seed = 0) {
+        if (v == 0.0) v = 0.0;
+        if (std::isnan(v)) v = std::nan("");
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return mix64(bits ^ mix64(seed));
+    }
+
+    /** @brief Combines a running hash with another hash value (order dependent). */
+    inline uint64_t combine(uint64_t h, uint64_t value) {
+        return mix64(h ^ (value + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2)));
+    }
+}
+
+/**
+ * @class HashIndex
+ * @brief Open-addressing hash index from precomputed hashes to dense ids.
+ * * The index does not own any keys: each slot stores a key's 64-bit hash and
+ * an id chosen by the caller, and key equality is delegated to a callback that
+ * compares the probing key against the key behind an existing id. This lets
+ * callers deduplicate rows of typed columns without materialising a key object
+ * (or allocating a string) per row. Uses linear probing and keeps the load
+ * factor at or below 1/2.
+ */
+class HashIndex {
+    static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+    std::vector<uint64_t> hashes;
+    std::vector<uint32_t> ids;
+    size_t mask = 0;
+    size_t count = 0;
+
+    /** @brief Doubles the table, reinserting existing entries by their stored hash. */
+    void grow() {
+        std::vector<uint64_t> old_hashes = std::move(hashes);
+        std::vector<uint32_t> old_ids = std::move(ids);
+        size_t capacity = old_ids.size() * 2;
+        hashes.assign(capacity, 0);
+        ids.assign(capacity, EMPTY);
+        mask = capacity - 1;
+        for (size_t i = 0; i < old_ids.size(); ++i) {
+            if (old_ids[i] == EMPTY) continue;
+            size_t slot = static_cast<size_t>(old_hashes[i]) & mask;
+            while (ids[slot] != EMPTY) slot = (slot + 1) & mask;
+            hashes[slot] = old_hashes[i];
+            ids[slot] = old_ids[i];
+        }
+    }
+
+public:
+    /**
+     * @brief Constructs an empty index sized for an expected number of keys.
+     * @param expected Number of distinct keys expected (the table grows as needed).
+     */
+    explicit HashIndex(size_t expected = 16) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity *= 2;
+        hashes.assign(capacity, 0);
+        ids.assign(capacity, EMPTY);
+        mask = capacity - 1;
+    }
+
+    /** @brief Returns the number of distinct keys stored. */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Looks up a key and inserts it with new_id if it is not present.
+     * @param hash The 64-bit hash of the key.
+     * @param new_id The id to store if the key is new.
+     * @param equal Callback equal(existing_id) returning true if the probing key equals that id's key.
+     * @return The id of the key and true if it was inserted.
+     */
+    template <typename Equal>
+    std::pair<uint32_t, bool> insert(uint64_t hash, uint32_t new_id, Equal&& equal) {
+        if ((count + 1) * 2 > ids.size()) grow();
+
+        size_t slot = static_cast<size_t>(hash) & mask;
+        while (true) {
+            uint32_t id = ids[slot];
+            if (id == EMPTY) {
+                if (new_id == EMPTY) throw std::overflow_error("HashIndex supports at most 2^32 - 1 distinct keys.");
+                ids[slot] = new_id;
+                hashes[slot] = hash;
+                ++count;
+                return {new_id, true};
+            }
+            if (hashes[slot] == hash && equal(id)) return {id, false};
+            slot = (slot + 1) & mask;
+        }
+    }
+};
+
+#endif // HASH_H
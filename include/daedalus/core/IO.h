@@ -11,63 +11,674 @@
 #define IO_H
 
 #include "DataFrame.h"
+#include "AsyncIO.h"
+#include "Csv.h"
+#include "Columnar.h"
+#include "Compression.h"
+#include "Libsvm.h"
+#include "MappedFile.h"
+#include "Npy.h"
+#include "Parallel.h"
+#include "SparseMatrix.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
 #include <fstream>
-#include <sstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+/** @brief Smallest byte range handed to a single CSV parsing thread. */
+constexpr size_t CSV_MIN_CHUNK_BYTES = size_t(4) << 20;
+
+/**
+ * @brief Parses CSV text that is already in memory into a DataFrame.
+ * * This is the parser behind read_csv, for callers that obtained the bytes
+ * some other way (a network buffer, or the asynchronous multi-file reader).
+ * The bytes must be uncompressed. See read_csv for the parameters.
+ * @param data The first byte of the CSV text.
+ * @param size The number of bytes.
+ */
+inline DataFrame read_csv_buffer(const char* data, size_t size, bool has_header = true, size_t num_threads = 0,
+                                 const std::unordered_map<std::string, std::string>& dtype = {},
+                                 size_t sample_rows = 1000, char delimiter = ',', char quote = '"', char comment = '\0',
+                                 const std::vector<std::string>& usecols = {}, std::optional<size_t> nrows = std::nullopt,
+                                 size_t skiprows = 0,
+                                 std::optional<std::pair<size_t, size_t>> chunks_range = std::nullopt) {
+    if (chunks_range && chunks_range->first > chunks_range->second) {
+        throw std::invalid_argument("chunks_range start must not exceed its stop.");
+    }
+    DataFrame df;
+    const char* begin = data;
+    const char* end = begin + size;
+    if (size == 0) return df;
+
+    // Handle Headers, then infer the schema from a sample and apply explicit types
+    Csv::Dialect dialect{delimiter, quote, comment};
+    Csv::Layout layout = Csv::read_layout(begin, end, has_header, dtype, sample_rows, dialect, usecols, skiprows);
+    const std::vector<std::string>& headers = layout.headers;
+    const std::vector<Csv::ColumnSpec>& specs = layout.specs;
+    const char* body = layout.body;
+
+    // Restrict the records to the byte range and the row limit
+    if (chunks_range) {
+        const char* stop = Csv::align_to_record(body, begin + std::min(chunks_range->second, size), end, quote);
+        body = Csv::align_to_record(body, begin + std::min(chunks_range->first, size), end, quote);
+        end = std::max(body, stop);
+    }
+    if (nrows) end = Csv::skip_records(body, end, *nrows, dialect);
+
+    // Parse byte ranges in parallel, each into its own typed column fragments
+    size_t n_chunks = std::min(Parallel::resolve_threads(num_threads),
+                               std::max<size_t>(1, static_cast<size_t>(end - body) / CSV_MIN_CHUNK_BYTES));
+    std::vector<const char*> bounds = Csv::split_chunks(body, end, n_chunks, quote);
+    std::vector<DataFrame> fragments(n_chunks);
+    Parallel::parallel_for(0, n_chunks, [&](size_t c) {
+        Csv::ColumnBuilder builder(specs);
+        Csv::tokenize(bounds[c], bounds[c + 1], dialect, builder, layout.selection());
+        if (builder.records() == 0) return;
+        std::vector<Column> columns = builder.take_columns();
+        for (size_t i = 0; i < headers.size(); ++i) fragments[c].add_column(headers[i], std::move(columns[i]));
+    }, n_chunks);
+
+    // Stitch the fragments together, skipping chunks that held no records
+    std::vector<DataFrame> parts;
+    for (auto& fragment : fragments) {
+        if (fragment.cols() != 0) parts.push_back(std::move(fragment));
+    }
+    if (parts.size() == 1) return std::move(parts[0]);
+    if (parts.size() > 1) return DataFrame::concat(parts);
+
+    // Populate an empty DataFrame with the header names only
+    for (size_t i = 0; i < headers.size(); ++i) df.add_column(headers[i], Column(specs[i].type));
+    return df;
+}
 
 /**
  * @brief Reads a CSV file and populates a DataFrame.
  * * This function parses a Comma-Separated Values (CSV) file. It automatically 
- * detects headers and attempts to infer data types for each cell.
+ * detects headers and infers a data type for each column.
  * * @section parsing_logic Parsing Logic:
- * The function attempts to parse each value as a @c double first. If 
- * conversion fails (e.g., if the value is text), it falls back to storing 
- * the value as a @c std::string.
- * @param filename The path to the CSV file to be read.
+ * The file is memory-mapped and split into fields by a SIMD structural scan
+ * (see Csv.h). The type of every column is inferred once from the first
+ * @p sample_rows records (bool, int32, int64, float64 or string) unless it is
+ * given in @p dtype, and every field is then parsed with @c std::from_chars
+ * straight into that column's typed buffer. Empty fields and missing trailing
+ * fields are recorded as nulls. Inferred columns are widened if a later value
+ * requires it (to int64, float64, or mixed for text); explicitly typed columns
+ * never change type, and values that do not parse as that type become nulls.
+ * * Files larger than a few MiB are split into byte ranges that are resynchronised
+ * at record boundaries (see Csv::split_chunks) and parsed on separate threads;
+ * the per-thread column fragments are then stitched with DataFrame::concat.
+ * * Column projection, row limits and byte ranges are applied by the tokenizer:
+ * fields outside @p usecols are never unquoted or converted, and skipped or
+ * trailing records are only scanned for record boundaries. Records with more
+ * fields than the header are an error unless @p usecols is given, in which case
+ * the extra fields are ignored.
+ * * gzip and zstd files are recognised by their magic bytes and decompressed
+ * into memory before parsing, in parallel when the file is made of
+ * independent members (see Compression.h); @p chunks_range then refers to
+ * offsets in the decompressed data.
+ * * @section multi_file Multiple Files:
+ * A @p filename containing '*', '?' or '[' that does not name an existing file
+ * is a glob pattern over the file name (e.g. "data/part-*.csv"). The matching
+ * files are read in sorted order by an AsyncIO::FileReader, which keeps
+ * several large reads in flight (through io_uring where available), and
+ * every file is parsed on the thread pool as soon as it has arrived, so
+ * parsing overlaps the reads of the following files. Every file must have
+ * the same columns; each is inferred separately and the results are stitched
+ * with DataFrame::concat, which promotes column types that disagree.
+ * @p skiprows applies to every file and @p nrows to the total.
+ * @param filename The path to the CSV file to be read, or a glob pattern.
  * @param has_header If true (default), the first line is treated as column names.
+ *                   Otherwise the columns are named "0", "1", ...
+ * @param num_threads Number of parsing threads (0 means use all hardware threads).
+ * @param dtype Column types by name ("float64", "int32", "int64", "bool", "string",
+ *              "category" or "mixed"), overriding inference for those columns.
+ * @param sample_rows Number of records used to infer the types of the other columns.
+ * @param delimiter The field separator.
+ * @param quote The quote character. Quoted fields may contain delimiters, newlines
+ *              and doubled quotes (RFC 4180).
+ * @param comment Lines starting with this character are skipped ('\0' disables comments).
+ * @param usecols Names of the columns to read (empty reads all). Columns keep their file order.
+ * @param nrows Maximum number of records to read (after skiprows and within chunks_range).
+ * @param skiprows Number of data records after the header to skip.
+ * @param chunks_range Byte offsets [start, stop) of the file; only records that start
+ *                     in this range are read, so disjoint ranges split a file between
+ *                     readers without overlap. Column types are still inferred from
+ *                     the start of the file so every range agrees on the schema.
  * @return DataFrame A populated DataFrame containing the CSV data.
- * @throws std::runtime_error If the file cannot be opened.
+ * @throws std::runtime_error If the file cannot be opened or decompressed, a row has too many
+ *         fields, or a glob pattern matches no files.
+ * @throws std::invalid_argument If dtype or usecols names an unknown column, dtype names
+ *         an unknown type, the delimiter, quote and comment characters conflict, or
+ *         chunks_range is reversed or combined with a glob pattern, or the files of a
+ *         glob pattern do not have the same columns.
  */
-inline DataFrame read_csv(const std::string& filename, bool has_header = true) {
-    DataFrame df;
-    std::ifstream file(filename);
-    if (!file.is_open()) throw std::runtime_error("Could not open CSV file.");
+inline DataFrame read_csv(const std::string& filename, bool has_header = true, size_t num_threads = 0,
+                          const std::unordered_map<std::string, std::string>& dtype = {},
+                          size_t sample_rows = 1000, char delimiter = ',', char quote = '"', char comment = '\0',
+                          const std::vector<std::string>& usecols = {}, std::optional<size_t> nrows = std::nullopt,
+                          size_t skiprows = 0,
+                          std::optional<std::pair<size_t, size_t>> chunks_range = std::nullopt) {
+    if (!AsyncIO::has_wildcards(filename) || std::ifstream(filename).good()) {
+        Compression::DecodedFile file(filename, num_threads);
+        return read_csv_buffer(file.data(), file.size(), has_header, num_threads, dtype, sample_rows,
+                               delimiter, quote, comment, usecols, nrows, skiprows, chunks_range);
+    }
+    if (chunks_range) throw std::invalid_argument("chunks_range cannot be combined with a glob pattern.");
+    std::vector<std::string> paths = AsyncIO::expand_glob(filename);
+    if (paths.empty()) throw std::runtime_error("No files match: " + filename);
+
+    // Parse each file as soon as it has been read, with at most one file per thread in progress
+    size_t threads = Parallel::resolve_threads(num_threads);
+    size_t file_threads = std::max<size_t>(1, threads / std::min(threads, paths.size()));
+    std::vector<DataFrame> parts;
+    std::deque<std::future<DataFrame>> pending;
+    auto collect = [&] {
+        DataFrame part = pending.front().get();
+        pending.pop_front();
+        if (part.cols() != 0) parts.push_back(std::move(part));
+    };
+    AsyncIO::FileReader reader(paths);
+    while (std::optional<AsyncIO::Buffer> buffer = reader.next()) {
+        if (pending.size() >= threads) collect();
+        pending.push_back(std::async(std::launch::async, [&, file = std::move(*buffer)] {
+            if (Compression::detect(file.data.get(), file.size) == Compression::Format::NONE) {
+                return read_csv_buffer(file.data.get(), file.size, has_header, file_threads, dtype, sample_rows,
+                                       delimiter, quote, comment, usecols, nrows, skiprows);
+            }
+            std::string text = Compression::decompress(file.data.get(), file.size, file_threads);
+            return read_csv_buffer(text.data(), text.size(), has_header, file_threads, dtype, sample_rows,
+                                   delimiter, quote, comment, usecols, nrows, skiprows);
+        }));
+    }
+    while (!pending.empty()) collect();
+
+    if (parts.empty()) return DataFrame();
+    DataFrame df = parts.size() == 1 ? std::move(parts[0]) : DataFrame::concat(parts);
+    if (nrows && df.rows() > *nrows) df = df.head(*nrows);
+    return df;
+}
 
-    std::string line, word;
-    std::vector<std::string> headers;
+/**
+ * @brief Reads numeric CSV columns straight into a feature Matrix and a target Matrix.
+ * * Unlike read_csv followed by DataFrame::to_matrix, no typed columns are
+ * built: the records are first counted with the structural scan alone, the
+ * final row-major buffers are allocated once, and each parsing thread then
+ * converts its byte range (see Csv::split_chunks) directly into its rows of
+ * X and y. Only the requested fields are converted; the others are skipped
+ * by the tokenizer. Booleans become 1 and 0, while empty fields, missing
+ * trailing fields and values that are not numbers become NaN. Compressed
+ * files are decompressed first, as in read_csv.
+ * @param filename The path to the CSV file to be read.
+ * @param columns Names of the feature columns, in the order of the columns of X
+ *                (empty uses every column except the target, in file order).
+ * @param target_column Name of the target column (empty for none).
+ * @param has_header If true (default), the first line is treated as column names.
+ *                   Otherwise the columns are named "0", "1", ...
+ * @param num_threads Number of parsing threads (0 means use all hardware threads).
+ * @param delimiter The field separator.
+ * @param quote The quote character.
+ * @param comment Lines starting with this character are skipped ('\0' disables comments).
+ * @return The pair (X, y): X has one row per record and one column per feature,
+ *         y has one row per record and a single column (no column without a target).
+ * @throws std::runtime_error If the file cannot be opened or decompressed.
+ * @throws std::invalid_argument If a column is unknown or repeated, the target is also
+ *         a feature, or the delimiter, quote and comment characters conflict.
+ */
+inline std::pair<Matrix<double>, Matrix<double>> read_csv_matrix(
+        const std::string& filename, const std::vector<std::string>& columns,
+        const std::string& target_column = "", bool has_header = true, size_t num_threads = 0,
+        char delimiter = ',', char quote = '"', char comment = '\0') {
+    Compression::DecodedFile file(filename, num_threads);
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+    Csv::Dialect dialect{delimiter, quote, comment};
+    dialect.validate();
+    if (file.size() == 0) {
+        if (!columns.empty() || !target_column.empty()) throw std::invalid_argument("CSV file is empty: " + filename);
+        return {Matrix<double>(0, 0), Matrix<double>(0, 0)};
+    }
 
-    // Handle Headers
-    if (std::getline(file, line)) {
-        std::stringstream ss(line);
-        while (std::getline(ss, word, ',')) {
-            headers.push_back(word);
+    // Resolve the feature order and the target against the header
+    std::vector<std::string> features = columns;
+    if (features.empty()) {
+        for (const auto& name : Csv::read_layout(begin, end, has_header, {}, 1, dialect).headers) {
+            if (name != target_column) features.push_back(name);
         }
     }
+    std::vector<std::string> usecols = features;
+    if (!target_column.empty()) {
+        if (std::find(features.begin(), features.end(), target_column) != features.end()) {
+            throw std::invalid_argument("Target column is also a feature: " + target_column);
+        }
+        usecols.push_back(target_column);
+    }
+    for (size_t i = 0; i < usecols.size(); ++i) {
+        if (std::find(usecols.begin(), usecols.begin() + static_cast<std::ptrdiff_t>(i), usecols[i])
+                != usecols.begin() + static_cast<std::ptrdiff_t>(i)) {
+            throw std::invalid_argument("Column selected twice: " + usecols[i]);
+        }
+    }
+    Csv::Layout layout = Csv::read_layout(begin, end, has_header, {}, 1, dialect, usecols);
 
-    // Prepare storage for columns
-    std::vector<std::vector<std::variant<double, int, std::string>>> temp_data(headers.size());
-
-    // Parse Rows
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        size_t col_idx = 0;
-        while (std::getline(ss, word, ',')) {
-            try {
-                // Try to store as double first
-                temp_data[col_idx].push_back(std::stod(word));
-            } catch (...) {
-                // Fallback to string
-                temp_data[col_idx].push_back(word);
-            }
-            col_idx++;
+    // The tokenizer emits the selected fields in file order; map each one to its output slot
+    size_t width = features.size();
+    std::vector<size_t> slots;
+    for (const auto& name : layout.headers) {
+        auto it = std::find(features.begin(), features.end(), name);
+        slots.push_back(it != features.end() ? static_cast<size_t>(it - features.begin()) : width);
+    }
+
+    // Count every chunk's records, then parse each chunk into its own rows of the final buffers
+    const char* body = layout.body;
+    size_t n_chunks = std::min(Parallel::resolve_threads(num_threads),
+                               std::max<size_t>(1, static_cast<size_t>(end - body) / CSV_MIN_CHUNK_BYTES));
+    std::vector<const char*> bounds = Csv::split_chunks(body, end, n_chunks, quote);
+    std::vector<size_t> offsets(n_chunks + 1, 0);
+    Parallel::parallel_for(0, n_chunks, [&](size_t c) {
+        offsets[c + 1] = Csv::count_records(bounds[c], bounds[c + 1], dialect);
+    }, n_chunks);
+    for (size_t c = 0; c < n_chunks; ++c) offsets[c + 1] += offsets[c];
+
+    size_t n_rows = offsets[n_chunks];
+    Matrix<double> X(n_rows, width);
+    Matrix<double> y(n_rows, target_column.empty() ? 0 : 1);
+    Parallel::parallel_for(0, n_chunks, [&](size_t c) {
+        size_t rows = offsets[c + 1] - offsets[c];
+        if (rows == 0) return;
+        double* y_rows = target_column.empty() ? nullptr : y.data_ptr() + offsets[c];
+        Csv::MatrixBuilder builder(X.data_ptr() + offsets[c] * width, y_rows, width, slots, rows);
+        Csv::tokenize(bounds[c], bounds[c + 1], dialect, builder, layout.selection());
+    }, n_chunks);
+    return {std::move(X), std::move(y)};
+}
+
+/**
+ * @class CsvReader
+ * @brief Streams a CSV file as a sequence of DataFrame batches.
+ * * The file is memory-mapped and its schema is inferred once (as in read_csv),
+ * so every batch starts from the same column types. At most two batches are
+ * materialised at a time: the one returned to the caller and the next one,
+ * which is parsed on a background thread while the caller works on the
+ * current batch (double buffering).
+ * * gzip and zstd files are never decompressed as a whole: a Compression::Stream
+ * decodes blocks on its own thread a little ahead of the parser, and only
+ * the bytes of the records not yet parsed are kept in a window buffer.
+ */
+class CsvReader {
+    MappedFile file;
+    Csv::Dialect dialect;
+    Csv::Layout layout;
+    size_t batch_rows;
+    const char* cursor = nullptr;
+    const char* end = nullptr;
+    std::unique_ptr<Compression::Stream> stream;
+    std::string window;
+    size_t window_pos = 0;
+    bool stream_done = false;
+    std::future<DataFrame> pending;
+
+    /** @brief Appends the next decoded block to the window; returns false at the end of the stream. */
+    bool fill_window() {
+        window.erase(0, window_pos);
+        window_pos = 0;
+        std::string block;
+        stream_done = !stream->next(block);
+        window += block;
+        return !stream_done;
+    }
+
+    /** @brief Returns true while records remain to be parsed. */
+    bool has_input() const {
+        return stream ? !(stream_done && window_pos >= window.size()) : cursor < end;
+    }
+
+    /** @brief Tokenizes the complete records of the window into builder until it is full. */
+    void parse_window(Csv::ColumnBuilder& builder) {
+        while (true) {
+            const char* begin = window.data() + window_pos;
+            const char* stop = window.data() + window.size();
+            const char* limit = stream_done ? stop : Csv::last_record_end(begin, stop, dialect.quote);
+            window_pos = static_cast<size_t>(Csv::tokenize(begin, limit, dialect, builder, layout.selection()) - window.data());
+            if (builder.records() >= batch_rows || stream_done) return;
+            fill_window();
+        }
+    }
+
+    /** @brief Parses up to batch_rows records at the cursor and advances it. */
+    DataFrame parse_batch() {
+        Csv::ColumnBuilder builder(layout.specs, batch_rows);
+        if (stream) parse_window(builder);
+        else cursor = Csv::tokenize(cursor, end, dialect, builder, layout.selection());
+
+        DataFrame batch;
+        if (builder.records() == 0) return batch;
+        std::vector<Column> columns = builder.take_columns();
+        for (size_t i = 0; i < layout.headers.size(); ++i) batch.add_column(layout.headers[i], std::move(columns[i]));
+        return batch;
+    }
+
+    /** @brief Starts parsing the next batch on a background thread if input remains. */
+    void prefetch() {
+        if (has_input()) pending = std::async(std::launch::async, [this] { return parse_batch(); });
+    }
+
+public:
+    /**
+     * @brief Opens a CSV file for batched reading and starts parsing the first batch.
+     * @param filename The path to the CSV file.
+     * @param batch_rows Maximum number of rows per batch.
+     * @param has_header If true (default), the first line is treated as column names.
+     * @param dtype Column types by name, overriding inference (see read_csv).
+     * @param sample_rows Number of records used to infer the other column types.
+     * @param delimiter The field separator.
+     * @param quote The quote character.
+     * @param comment Lines starting with this character are skipped ('\0' disables comments).
+     * @throws std::runtime_error If the file cannot be opened or decompressed.
+     * @throws std::invalid_argument If batch_rows is 0, dtype names an unknown column or type,
+     *         or the delimiter, quote and comment characters conflict.
+     */
+    CsvReader(const std::string& filename, size_t batch_rows, bool has_header = true,
+              const std::unordered_map<std::string, std::string>& dtype = {}, size_t sample_rows = 1000,
+              char delimiter = ',', char quote = '"', char comment = '\0')
+        : file(filename), dialect{delimiter, quote, comment}, batch_rows(batch_rows) {
+        if (batch_rows == 0) throw std::invalid_argument("batch_rows must be positive.");
+        if (file.size() == 0) return;
+        end = file.data() + file.size();
+        if (Compression::detect(file.data(), file.size()) == Compression::Format::NONE) {
+            layout = Csv::read_layout(file.data(), end, has_header, dtype, sample_rows, dialect);
+            cursor = layout.body;
+            prefetch();
+            return;
+        }
+
+        // Infer the schema from the first decoded blocks that hold a complete record
+        stream.reset(new Compression::Stream(file.data(), file.size()));
+        while (fill_window() && Csv::last_record_end(window.data(), window.data() + window.size(), quote) == window.data()) {}
+        if (window.empty()) return;
+        const char* stop = window.data() + window.size();
+        const char* limit = stream_done ? stop : Csv::last_record_end(window.data(), stop, quote);
+        layout = Csv::read_layout(window.data(), limit, has_header, dtype, sample_rows, dialect);
+        window_pos = static_cast<size_t>(layout.body - window.data());
+        prefetch();
+    }
+
+    CsvReader(const CsvReader&) = delete;
+    CsvReader& operator=(const CsvReader&) = delete;
+
+    /** @brief Waits for any batch still being parsed before stopping the decoder and unmapping the file. */
+    ~CsvReader() {
+        if (pending.valid()) pending.wait();
+    }
+
+    /** @brief Returns the column names of every batch. */
+    const std::vector<std::string>& columns() const { return layout.headers; }
+
+    /**
+     * @brief Returns the next batch, or std::nullopt once the file is exhausted.
+     * * Blocks only if the prefetched batch is not ready yet, then immediately
+     * starts parsing the following batch in the background.
+     * @throws std::runtime_error If a record has more fields than columns.
+     */
+    std::optional<DataFrame> next() {
+        while (pending.valid()) {
+            DataFrame batch = pending.get();
+            prefetch();
+            if (batch.rows() > 0) return batch;
         }
+        return std::nullopt;
     }
 
-    // Populate DataFrame
-    for (size_t i = 0; i < headers.size(); ++i) {
-        df.add_column(headers[i], temp_data[i]);
+    /**
+     * @brief Returns the selected columns of the next batch as a Matrix, or std::nullopt at the end.
+     * @param target_columns The columns to extract (see DataFrame::to_matrix).
+     */
+    std::optional<Matrix<double>> next_matrix(const std::vector<std::string>& target_columns) {
+        std::optional<DataFrame> batch = next();
+        if (!batch) return std::nullopt;
+        return batch->to_matrix(target_columns);
     }
+};
+
+/**
+ * @brief Reads columns of a memory-mapped .dcol file into a DataFrame.
+ * * Chunks whose statistics show that they cannot satisfy every predicate are
+ * never decoded; the rows of the remaining chunks are then filtered exactly.
+ * Chunks are decoded (and decompressed) in parallel straight into the output
+ * column buffers.
+ * @param file The opened file.
+ * @param columns The columns to read, in output order (empty reads all).
+ * @param filters Predicates that every returned row satisfies (combined with AND).
+ * @param num_threads Number of threads (0 means use all hardware threads).
+ * @throws std::invalid_argument If a column is unknown or a predicate is invalid.
+ */
+inline DataFrame read_dcol(const Dcol::File& file, const std::vector<std::string>& columns = {},
+                           const std::vector<Dcol::Predicate>& filters = {}, size_t num_threads = 0) {
+    std::vector<std::string> names = columns.empty() ? file.column_names() : columns;
+    std::vector<size_t> chunks = file.select_chunks(filters);
 
+    // Decode the selected columns and any extra filter columns in one pass
+    std::vector<std::string> decode_names = names;
+    std::vector<size_t> filter_slots;
+    for (const auto& p : filters) {
+        size_t slot = std::find(decode_names.begin(), decode_names.end(), p.column) - decode_names.begin();
+        if (slot == decode_names.size()) decode_names.push_back(p.column);
+        filter_slots.push_back(slot);
+    }
+    std::vector<Column> decoded = file.read_columns(decode_names, chunks, num_threads);
+
+    if (!filters.empty()) {
+        size_t n = decoded[filter_slots[0]].size();
+        std::vector<size_t> keep;
+        for (size_t i = 0; i < n; ++i) {
+            bool match = true;
+            for (size_t f = 0; f < filters.size() && match; ++f) match = filters[f].matches(decoded[filter_slots[f]].as_double(i));
+            if (match) keep.push_back(i);
+        }
+        if (keep.size() != n) {
+            Parallel::parallel_for(0, names.size(), [&](size_t c) { decoded[c] = decoded[c].take(keep); }, num_threads);
+        }
+    }
+
+    DataFrame df;
+    for (size_t c = 0; c < names.size(); ++c) df.add_column(names[c], std::move(decoded[c]));
     return df;
 }
 
+/**
+ * @brief Reads a .dcol file written by DataFrame::save into a DataFrame.
+ * @param filename The path to the .dcol file.
+ * @param columns The columns to read, in output order (empty reads all).
+ * @param filters Predicates that every returned row satisfies (combined with AND).
+ * @param num_threads Number of threads (0 means use all hardware threads).
+ * @throws std::runtime_error If the file cannot be opened or is not a valid .dcol file.
+ * @throws std::invalid_argument If a column is unknown or a predicate is invalid.
+ */
+inline DataFrame read_dcol(const std::string& filename, const std::vector<std::string>& columns = {},
+                           const std::vector<Dcol::Predicate>& filters = {}, size_t num_threads = 0) {
+    Dcol::File file(filename);
+    return read_dcol(file, columns, filters, num_threads);
+}
+
+/**
+ * @brief Loads a NumPy .npy array into a Matrix.
+ * * The file is memory-mapped and parsed natively, without NumPy. 1-d arrays
+ * become column vectors (N x 1). Supported dtypes are little-endian float64,
+ * float32, int64, int32, int16, int8, uint32, uint8 and bool, in C or Fortran
+ * order; everything but C-order float64 (a single copy) is converted to
+ * float64 in parallel.
+ * @param filename The path to the .npy file.
+ * @param num_threads Number of threads (0 means use all hardware threads).
+ * @throws std::runtime_error If the file cannot be opened, is not an .npy file, or
+ *         holds an unsupported dtype or more than two dimensions.
+ */
+inline Matrix<double> load_npy(const std::string& filename, size_t num_threads = 0) {
+    MappedFile file(filename);
+    return Npy::to_matrix(file.data(), file.size(), num_threads);
+}
+
+/**
+ * @brief Saves a Matrix as a C-order float64 .npy array (readable by numpy.load).
+ * @param filename The output path (overwritten).
+ * @param matrix The matrix to save.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+inline void save_npy(const std::string& filename, const Matrix<double>& matrix) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(filename.c_str(), "wb"), &std::fclose);
+    if (!file) throw std::runtime_error("Could not open file for writing: " + filename);
+    std::string header = Npy::encode_header(matrix.rows(), matrix.cols());
+    size_t bytes = matrix.rows() * matrix.cols() * sizeof(double);
+    if (std::fwrite(header.data(), 1, header.size(), file.get()) != header.size()
+            || (bytes > 0 && std::fwrite(matrix.data_ptr(), 1, bytes, file.get()) != bytes)
+            || std::fflush(file.get()) != 0) {
+        throw std::runtime_error("Could not write file: " + filename);
+    }
+}
+
+/**
+ * @brief Loads every array of an uncompressed NumPy .npz archive (as written by numpy.savez).
+ * * The archive is memory-mapped and each member is converted in place, as in load_npy.
+ * @param filename The path to the .npz file.
+ * @param num_threads Number of threads (0 means use all hardware threads).
+ * @return The arrays by name (the member names without their ".npy" suffix).
+ * @throws std::runtime_error If the archive is malformed, a member is compressed
+ *         (numpy.savez_compressed) or an array cannot be loaded.
+ */
+inline std::map<std::string, Matrix<double>> load_npz(const std::string& filename, size_t num_threads = 0) {
+    MappedFile file(filename);
+    std::map<std::string, Matrix<double>> arrays;
+    for (const auto& entry : Npy::zip_entries(file.data(), file.size())) {
+        if (entry.method != 0) {
+            throw std::runtime_error("Compressed .npz members are not supported (use numpy.savez): " + entry.name);
+        }
+        std::string name = entry.name;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".npy") == 0) name.resize(name.size() - 4);
+        arrays.emplace(name, Npy::to_matrix(file.data() + entry.offset, entry.size, num_threads));
+    }
+    return arrays;
+}
+
+/**
+ * @brief Saves matrices as an uncompressed .npz archive (readable by numpy.load).
+ * @param filename The output path (overwritten).
+ * @param arrays The matrices by name; each is stored as the member "<name>.npy".
+ * @throws std::runtime_error If the file cannot be written.
+ */
+inline void save_npz(const std::string& filename, const std::map<std::string, Matrix<double>>& arrays) {
+    Npy::ZipWriter zip(filename);
+    for (const auto& entry : arrays) {
+        const Matrix<double>& matrix = entry.second;
+        std::string header = Npy::encode_header(matrix.rows(), matrix.cols());
+        zip.add(entry.first + ".npy", {{header.data(), header.size()},
+                                        {reinterpret_cast<const char*>(matrix.data_ptr()), matrix.rows() * matrix.cols() * sizeof(double)}});
+    }
+    zip.finish();
+}
+
+/** @brief Smallest byte range handed to a single LIBSVM parsing thread. */
+constexpr size_t LIBSVM_MIN_CHUNK_BYTES = size_t(1) << 20;
+
+/**
+ * @brief Reads a LIBSVM / SVMlight file into a sparse feature matrix and a label column.
+ * * The file is memory-mapped (or decompressed, as in read_csv) and split at
+ * line boundaries into byte ranges that are parsed in parallel. The per-range
+ * rows are then copied in parallel into a single CSR matrix. Entries keep
+ * their order within a line, and lines without features become empty rows.
+ * @param filename The path to the file.
+ * @param n_features Number of columns (default: the largest index in the file plus one).
+ * @param zero_based Whether indices start at 0 (default: true if any index is 0, as
+ *                   1-based files never contain it).
+ * @param num_threads Number of parsing threads (0 means use all hardware threads).
+ * @return The pair (X, y): X is a CSR matrix with one row per line and y is a column of labels.
+ * @throws std::runtime_error If the file cannot be opened or a line is malformed.
+ * @throws std::invalid_argument If an index is 0 in a 1-based file, or is not below n_features.
+ */
+inline std::pair<SparseMatrix<double>, Matrix<double>> read_libsvm(
+        const std::string& filename, std::optional<size_t> n_features = std::nullopt,
+        std::optional<bool> zero_based = std::nullopt, size_t num_threads = 0) {
+    Compression::DecodedFile file(filename, num_threads);
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+
+    size_t n_chunks = std::min(Parallel::resolve_threads(num_threads),
+                               std::max<size_t>(1, file.size() / LIBSVM_MIN_CHUNK_BYTES));
+    std::vector<const char*> bounds = Libsvm::split_lines(begin, end, n_chunks);
+    std::vector<Libsvm::Fragment> fragments(n_chunks);
+    Parallel::parallel_for(0, n_chunks, [&](size_t c) {
+        Libsvm::parse(bounds[c], bounds[c + 1], fragments[c]);
+    }, n_chunks);
+
+    // Resolve the index base and the width from all fragments
+    uint64_t min_index = std::numeric_limits<uint64_t>::max(), max_index = 0;
+    size_t n_rows = 0, n_entries = 0;
+    for (const auto& f : fragments) {
+        min_index = std::min(min_index, f.min_index);
+        max_index = std::max(max_index, f.max_index);
+        n_rows += f.labels.size();
+        n_entries += f.values.size();
+    }
+    bool has_entries = n_entries > 0;
+    uint64_t offset = zero_based.value_or(has_entries && min_index == 0) ? 0 : 1;
+    if (has_entries && min_index < offset) throw std::invalid_argument("Feature index 0 found in a 1-based LIBSVM file.");
+    size_t width = has_entries ? static_cast<size_t>(max_index - offset + 1) : 0;
+    if (n_features) {
+        if (*n_features < width) {
+            throw std::invalid_argument("LIBSVM file has feature index " + std::to_string(max_index)
+                                        + ", which does not fit in n_features = " + std::to_string(*n_features) + ".");
+        }
+        width = *n_features;
+    }
+    if (width > std::numeric_limits<uint32_t>::max()) throw std::invalid_argument("LIBSVM feature index is too large.");
+
+    // Concatenate the fragments into the final CSR arrays
+    std::vector<size_t> row_start(n_chunks + 1, 0), entry_start(n_chunks + 1, 0);
+    for (size_t c = 0; c < n_chunks; ++c) {
+        row_start[c + 1] = row_start[c] + fragments[c].labels.size();
+        entry_start[c + 1] = entry_start[c] + fragments[c].values.size();
+    }
+    std::vector<size_t> indptr(n_rows + 1, 0);
+    std::vector<uint32_t> indices(n_entries);
+    std::vector<double> values(n_entries);
+    Matrix<double> y(n_rows, 1);
+    Parallel::parallel_for(0, n_chunks, [&](size_t c) {
+        const Libsvm::Fragment& f = fragments[c];
+        size_t row = row_start[c], entry = entry_start[c];
+        for (size_t r = 0; r < f.labels.size(); ++r) {
+            y(row + r, 0) = f.labels[r];
+            entry += f.row_nnz[r];
+            indptr[row + r + 1] = entry;
+        }
+        for (size_t e = 0; e < f.indices.size(); ++e) indices[entry_start[c] + e] = static_cast<uint32_t>(f.indices[e] - offset);
+        std::copy(f.values.begin(), f.values.end(), values.begin() + static_cast<std::ptrdiff_t>(entry_start[c]));
+    }, n_chunks);
+
+    return {SparseMatrix<double>(n_rows, width, std::move(indptr), std::move(indices), std::move(values)), std::move(y)};
+}
+
+/**
+ * @brief Writes a sparse matrix and its labels in LIBSVM format.
+ * * Blocks of lines are formatted in parallel and written in order (see Csv::write_blocks).
+ * Values are written in their shortest round-trip form.
+ * @param filename The output path (overwritten).
+ * @param X The features.
+ * @param y The labels (one per row of X, as a column).
+ * @param zero_based Write 0-based indices instead of the standard 1-based ones.
+ * @param num_threads Number of formatting threads (0 means use all hardware threads).
+ * @throws std::invalid_argument If y does not hold one value per row of X.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+inline void save_libsvm(const std::string& filename, const SparseMatrix<double>& X, const Matrix<double>& y,
+                        bool zero_based = false, size_t num_threads = 0) {
+    if (y.rows() != X.rows() || y.cols() != 1) throw std::invalid_argument("y must be a column with one label per row of X.");
+    size_t row_bytes = 8 + (X.rows() == 0 ? 0 : 24 * X.nnz() / X.rows());
+    Csv::write_blocks(filename, "", X.rows(), row_bytes, [&](size_t lo, size_t hi, std::string& out) {
+        Libsvm::format_rows(X.indptr(), X.indices(), X.values(), y.data_ptr(), zero_based ? 0 : 1, lo, hi, out);
+    }, num_threads);
+}
+
 #endif // IO_H
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+ * @file Libsvm.h
+ * @brief Parsing and formatting of the LIBSVM / SVMlight sparse text format.
+ * * Every line holds a label followed by index:value pairs for the non-zero
+ * features, e.g. "1 3:0.5 17:1 # comment". An optional "qid:n" token after
+ * the label is accepted and ignored. Indices are 1-based in files written by
+ * LIBSVM and SVMlight, but 0-based files are common too.
+ */
+
+// include/daedalus/core/Libsvm.h
+
+#ifndef LIBSVM_H
+#define LIBSVM_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "Csv.h"
+#include "CsvWriter.h"
+
+/**
+ * @namespace Libsvm
+ * @brief Chunked parsing of LIBSVM lines into CSR fragments, and the matching writer.
+ */
+namespace Libsvm {
+    /**
+     * @struct Fragment
+     * @brief The rows parsed from one byte range, with raw (unshifted) feature indices.
+     */
+    struct Fragment {
+        std::vector<double> labels;
+        std::vector<size_t> row_nnz;
+        std::vector<uint64_t> indices;
+        std::vector<double> values;
+        uint64_t min_index = std::numeric_limits<uint64_t>::max();
+        uint64_t max_index = 0;
+    };
+
+    /** @brief Returns true for the whitespace characters that separate tokens. */
+    inline bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    /**
+     * @brief Parses the lines of [begin, end), which must start at a line boundary.
+     * @throws std::runtime_error If a label, index or value is malformed.
+     */
+    inline void parse(const char* begin, const char* end, Fragment& out) {
+        const char* p = begin;
+        while (p < end) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!eol) eol = end;
+            const char* comment = static_cast<const char*>(std::memchr(p, '#', static_cast<size_t>(eol - p)));
+            const char* stop = comment ? comment : eol;
+
+            auto next_token = [&](const char*& q) {
+                while (q < stop && is_space(*q)) ++q;
+                const char* start = q;
+                while (q < stop && !is_space(*q)) ++q;
+                return start;
+            };
+
+            const char* q = p;
+            const char* token = next_token(q);
+            if (token < q) {
+                double label;
+                if (!Csv::parse_double(token, static_cast<size_t>(q - token), label)) {
+                    throw std::runtime_error("Invalid LIBSVM label: " + std::string(token, q));
+                }
+                out.labels.push_back(label);
+                size_t nnz = 0;
+                for (token = next_token(q); token < q; token = next_token(q)) {
+                    const char* colon = static_cast<const char*>(std::memchr(token, ':', static_cast<size_t>(q - token)));
+                    if (!colon) throw std::runtime_error("Invalid LIBSVM feature: " + std::string(token, q));
+                    if (colon - token == 3 && std::memcmp(token, "qid", 3) == 0) continue;
+                    uint64_t index;
+                    double value;
+                    auto parsed = std::from_chars(token, colon, index);
+                    if (parsed.ec != std::errc() || parsed.ptr != colon
+                            || !Csv::parse_double(colon + 1, static_cast<size_t>(q - colon - 1), value)) {
+                        throw std::runtime_error("Invalid LIBSVM feature: " + std::string(token, q));
+                    }
+                    out.indices.push_back(index);
+                    out.values.push_back(value);
+                    out.min_index = std::min(out.min_index, index);
+                    out.max_index = std::max(out.max_index, index);
+                    ++nnz;
+                }
+                out.row_nnz.push_back(nnz);
+            }
+            p = eol + 1;
+        }
+    }
+
+    /**
+     * @brief Splits [begin, end) into n byte ranges that each start at a line boundary.
+     * @return n + 1 boundaries; range i is [bounds[i], bounds[i + 1]) and may be empty.
+     */
+    inline std::vector<const char*> split_lines(const char* begin, const char* end, size_t n) {
+        n = std::max<size_t>(n, 1);
+        std::vector<const char*> bounds(n + 1, end);
+        bounds[0] = begin;
+        size_t total = static_cast<size_t>(end - begin);
+        for (size_t k = 1; k < n; ++k) {
+            const char* p = std::max(begin + total * k / n, bounds[k - 1]);
+            const char* newline = p < end ? static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p))) : nullptr;
+            bounds[k] = newline ? newline + 1 : end;
+        }
+        return bounds;
+    }
+
+    /**
+     * @brief Appends rows [lo, hi) of a CSR matrix and its labels in LIBSVM format.
+     * @param index_offset Added to every column index (1 for 1-based output).
+     */
+    template <typename T>
+    void format_rows(const std::vector<size_t>& indptr, const std::vector<uint32_t>& indices, const std::vector<T>& values,
+                     const T* labels, size_t index_offset, size_t lo, size_t hi, std::string& out) {
+        for (size_t r = lo; r < hi; ++r) {
+            Csv::append_number(out, labels[r]);
+            for (size_t e = indptr[r]; e < indptr[r + 1]; ++e) {
+                out.push_back(' ');
+                Csv::append_int(out, static_cast<uint64_t>(indices[e]) + index_offset);
+                out.push_back(':');
+                Csv::append_number(out, values[e]);
+            }
+            out.push_back('\n');
+        }
+    }
+}
+
+#endif // LIBSVM_H
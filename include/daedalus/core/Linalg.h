@@ -0,0 +1,374 @@
+/**
+ * @file Linalg.h
+ * @brief Parallel, cache-blocked dense kernels for the estimators built on Matrix.
+ * * Matrix::operator* is a straightforward triple loop through the
+ * bounds-checked accessor. The kernels here work on the raw row-major
+ * buffers instead: the product is split across threads by output rows, the
+ * inner dimension and the output columns are tiled so that a panel of the
+ * right-hand side stays in cache, and the innermost loop runs over
+ * contiguous output columns so the compiler can vectorize it. Optional
+ * column shifts let callers multiply a centered matrix (X - 1 u^T) without
+ * materializing it, which is what PCA needs for large inputs.
+ */
+
+// include/daedalus/core/Linalg.h
+
+#ifndef LINALG_H
+#define LINALG_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Matrix.h"
+#include "Parallel.h"
+
+/**
+ * @namespace Linalg
+ * @brief Blocked GEMM variants, a symmetric eigensolver and orthonormalization.
+ */
+namespace Linalg {
+    /** @brief Rows of the left operand packed (and centered) together. */
+    constexpr size_t ROW_PANEL = 64;
+
+    /** @brief Tile of the inner dimension kept in cache. */
+    constexpr size_t INNER_TILE = 256;
+
+    /** @brief Tile of the output columns kept in cache. */
+    constexpr size_t COL_TILE = 512;
+
+    /**
+     * @brief Serial kernel: C[rows x cols] += A[rows x inner] * B[inner x cols].
+     * * Within each cache tile, 4 x 8 blocks of C are accumulated in registers
+     * over the whole inner tile, so C is loaded and stored once per tile rather
+     * than once per inner index. Edges fall back to a plain row update.
+     * @param lda, ldb, ldc Row strides of A, B and C.
+     */
+    inline void gemm_block(const double* A, size_t lda, const double* B, size_t ldb, double* C, size_t ldc,
+                           size_t rows, size_t inner, size_t cols) {
+        constexpr size_t MR = 4, NR = 8;
+        for (size_t k0 = 0; k0 < inner; k0 += INNER_TILE) {
+            size_t k1 = std::min(inner, k0 + INNER_TILE);
+            for (size_t j0 = 0; j0 < cols; j0 += COL_TILE) {
+                size_t j1 = std::min(cols, j0 + COL_TILE);
+                size_t j_full = j0 + (j1 - j0) / NR * NR;
+                size_t i = 0;
+                for (; i + MR <= rows; i += MR) {
+                    const double* a0 = A + i * lda;
+                    for (size_t j = j0; j < j_full; j += NR) {
+                        double acc[MR][NR] = {};
+                        for (size_t k = k0; k < k1; ++k) {
+                            const double* b = B + k * ldb + j;
+                            for (size_t r = 0; r < MR; ++r) {
+                                double ark = a0[r * lda + k];
+                                for (size_t c = 0; c < NR; ++c) acc[r][c] += ark * b[c];
+                            }
+                        }
+                        for (size_t r = 0; r < MR; ++r) {
+                            double* c_row = C + (i + r) * ldc + j;
+                            for (size_t c = 0; c < NR; ++c) c_row[c] += acc[r][c];
+                        }
+                    }
+                    for (size_t r = 0; r < MR && j_full < j1; ++r) {
+                        const double* a = a0 + r * lda;
+                        double* c_row = C + (i + r) * ldc;
+                        for (size_t k = k0; k < k1; ++k) {
+                            const double* b = B + k * ldb;
+                            for (size_t j = j_full; j < j1; ++j) c_row[j] += a[k] * b[j];
+                        }
+                    }
+                }
+                for (; i < rows; ++i) {
+                    const double* a = A + i * lda;
+                    double* c_row = C + i * ldc;
+                    for (size_t k = k0; k < k1; ++k) {
+                        double aik = a[k];
+                        const double* b = B + k * ldb;
+                        for (size_t j = j0; j < j1; ++j) c_row[j] += aik * b[j];
+                    }
+                }
+            }
+        }
+    }
+
+    /** @brief Returns a minimum block size that gives each thread a worthwhile amount of work. */
+    inline size_t min_rows_for(size_t work_per_row) {
+        return std::max<size_t>(1, (size_t(1) << 18) / std::max<size_t>(work_per_row, 1));
+    }
+
+    /**
+     * @brief Computes (A - 1 shift^T) * B in parallel over rows of A.
+     * @param A Left operand (n x k).
+     * @param B Right operand (k x m).
+     * @param shift Per-column value subtracted from A (empty for none).
+     * @throws std::invalid_argument If the dimensions do not match.
+     */
+    inline Matrix<double> multiply(const Matrix<double>& A, const Matrix<double>& B, const std::vector<double>& shift = {}) {
+        if (A.cols() != B.rows()) throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        if (!shift.empty() && shift.size() != A.cols()) throw std::invalid_argument("Shift must have one value per column.");
+        size_t n = A.rows(), k = A.cols(), m = B.cols();
+        Matrix<double> C(n, m);
+        const double* a = A.data_ptr();
+        const double* b = B.data_ptr();
+        double* c = C.data_ptr();
+        Parallel::parallel_blocks(0, n, [&](size_t lo, size_t hi, size_t) {
+            if (shift.empty()) {
+                gemm_block(a + lo * k, k, b, m, c + lo * m, m, hi - lo, k, m);
+                return;
+            }
+            std::vector<double> panel(ROW_PANEL * k);
+            for (size_t r0 = lo; r0 < hi; r0 += ROW_PANEL) {
+                size_t rows = std::min(hi, r0 + ROW_PANEL) - r0;
+                for (size_t i = 0; i < rows; ++i) {
+                    const double* src = a + (r0 + i) * k;
+                    double* dst = panel.data() + i * k;
+                    for (size_t j = 0; j < k; ++j) dst[j] = src[j] - shift[j];
+                }
+                gemm_block(panel.data(), k, b, m, c + r0 * m, m, rows, k, m);
+            }
+        }, 0, min_rows_for(k * m));
+        return C;
+    }
+
+    /**
+     * @brief Computes (A - 1 a_shift^T)^T * (B - 1 b_shift^T) without forming either transpose.
+     * * Threads own disjoint row ranges of the (p x q) result. Each walks the
+     * n shared rows in panels, transposing (and centering) its slice of the
+     * A panel so the product is again a contiguous row-times-panel update.
+     * @param A Left operand (n x p).
+     * @param B Right operand (n x q).
+     * @param a_shift Per-column value subtracted from A (empty for none).
+     * @param b_shift Per-column value subtracted from B (empty for none).
+     * @throws std::invalid_argument If A and B have different numbers of rows.
+     */
+    inline Matrix<double> multiply_tn(const Matrix<double>& A, const Matrix<double>& B,
+                                      const std::vector<double>& a_shift = {}, const std::vector<double>& b_shift = {}) {
+        if (A.rows() != B.rows()) throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        if ((!a_shift.empty() && a_shift.size() != A.cols()) || (!b_shift.empty() && b_shift.size() != B.cols())) {
+            throw std::invalid_argument("Shift must have one value per column.");
+        }
+        size_t n = A.rows(), p = A.cols(), q = B.cols();
+        Matrix<double> C(p, q);
+        const double* a = A.data_ptr();
+        const double* b = B.data_ptr();
+        double* c = C.data_ptr();
+        Parallel::parallel_blocks(0, p, [&](size_t lo, size_t hi, size_t) {
+            size_t width = hi - lo;
+            std::vector<double> at(width * ROW_PANEL);
+            std::vector<double> bp(b_shift.empty() ? 0 : ROW_PANEL * q);
+            for (size_t r0 = 0; r0 < n; r0 += ROW_PANEL) {
+                size_t rows = std::min(n, r0 + ROW_PANEL) - r0;
+                for (size_t i = 0; i < rows; ++i) {
+                    const double* src = a + (r0 + i) * p + lo;
+                    for (size_t j = 0; j < width; ++j) {
+                        at[j * ROW_PANEL + i] = a_shift.empty() ? src[j] : src[j] - a_shift[lo + j];
+                    }
+                }
+                const double* panel = b + r0 * q;
+                if (!b_shift.empty()) {
+                    for (size_t i = 0; i < rows; ++i) {
+                        for (size_t j = 0; j < q; ++j) bp[i * q + j] = panel[i * q + j] - b_shift[j];
+                    }
+                    panel = bp.data();
+                }
+                gemm_block(at.data(), ROW_PANEL, panel, q, c + lo * q, q, width, rows, q);
+            }
+        }, 0, min_rows_for(n * q));
+        return C;
+    }
+
+    /**
+     * @brief Eigendecomposition of a symmetric matrix.
+     * * Householder reduction to tridiagonal form followed by the implicit QL
+     * algorithm (the tred2 / tql2 routines of EISPACK, as in JAMA). The QL
+     * rotations are applied to rows of the transposed eigenvector matrix so
+     * their inner loops run over contiguous memory.
+     * @param S A symmetric n x n matrix (only symmetric input gives meaningful results).
+     * @return The eigenvalues in decreasing order, and an n x n matrix whose row i
+     *         is the unit eigenvector of eigenvalue i.
+     * @throws std::invalid_argument If S is not square.
+     */
+    inline std::pair<std::vector<double>, Matrix<double>> symmetric_eigen(const Matrix<double>& S) {
+        if (S.rows() != S.cols()) throw std::invalid_argument("Eigendecomposition requires a square matrix.");
+        const size_t n = S.rows();
+        std::vector<double> d(n), e(n);
+        if (n == 0) return {d, Matrix<double>(0, 0)};
+        std::vector<double> V(S.data_ptr(), S.data_ptr() + n * n);
+        auto v = [&](size_t i, size_t j) -> double& { return V[i * n + j]; };
+
+        // Householder tridiagonalization (tred2)
+        for (size_t j = 0; j < n; ++j) d[j] = v(n - 1, j);
+        for (size_t i = n - 1; i > 0; --i) {
+            double scale = 0.0, h = 0.0;
+            for (size_t k = 0; k < i; ++k) scale += std::abs(d[k]);
+            if (scale == 0.0) {
+                e[i] = d[i - 1];
+                for (size_t j = 0; j < i; ++j) {
+                    d[j] = v(i - 1, j);
+                    v(i, j) = 0.0;
+                    v(j, i) = 0.0;
+                }
+            } else {
+                for (size_t k = 0; k < i; ++k) {
+                    d[k] /= scale;
+                    h += d[k] * d[k];
+                }
+                double f = d[i - 1];
+                double g = std::sqrt(h);
+                if (f > 0) g = -g;
+                e[i] = scale * g;
+                h -= f * g;
+                d[i - 1] = f - g;
+                for (size_t j = 0; j < i; ++j) e[j] = 0.0;
+                for (size_t j = 0; j < i; ++j) {
+                    f = d[j];
+                    v(j, i) = f;
+                    g = e[j] + v(j, j) * f;
+                    for (size_t k = j + 1; k <= i - 1; ++k) {
+                        g += v(k, j) * d[k];
+                        e[k] += v(k, j) * f;
+                    }
+                    e[j] = g;
+                }
+                f = 0.0;
+                for (size_t j = 0; j < i; ++j) {
+                    e[j] /= h;
+                    f += e[j] * d[j];
+                }
+                double hh = f / (h + h);
+                for (size_t j = 0; j < i; ++j) e[j] -= hh * d[j];
+                for (size_t j = 0; j < i; ++j) {
+                    f = d[j];
+                    g = e[j];
+                    for (size_t k = j; k <= i - 1; ++k) v(k, j) -= (f * e[k] + g * d[k]);
+                    d[j] = v(i - 1, j);
+                    v(i, j) = 0.0;
+                }
+            }
+            d[i] = h;
+        }
+        for (size_t i = 0; i + 1 < n; ++i) {
+            v(n - 1, i) = v(i, i);
+            v(i, i) = 1.0;
+            double h = d[i + 1];
+            if (h != 0.0) {
+                for (size_t k = 0; k <= i; ++k) d[k] = v(k, i + 1) / h;
+                for (size_t j = 0; j <= i; ++j) {
+                    double g = 0.0;
+                    for (size_t k = 0; k <= i; ++k) g += v(k, i + 1) * v(k, j);
+                    for (size_t k = 0; k <= i; ++k) v(k, j) -= g * d[k];
+                }
+            }
+            for (size_t k = 0; k <= i; ++k) v(k, i + 1) = 0.0;
+        }
+        for (size_t j = 0; j < n; ++j) {
+            d[j] = v(n - 1, j);
+            v(n - 1, j) = 0.0;
+        }
+        v(n - 1, n - 1) = 1.0;
+        e[0] = 0.0;
+
+        // Work on W = V^T so each rotation updates two contiguous rows
+        std::vector<double> W(n * n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) W[j * n + i] = V[i * n + j];
+        }
+
+        // Implicit QL iterations on the tridiagonal matrix (tql2)
+        for (size_t i = 1; i < n; ++i) e[i - 1] = e[i];
+        e[n - 1] = 0.0;
+        double f = 0.0, tst1 = 0.0;
+        const double eps = std::numeric_limits<double>::epsilon();
+        for (size_t l = 0; l < n; ++l) {
+            tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+            size_t m = l;
+            while (m < n && std::abs(e[m]) > eps * tst1) ++m;
+            if (m == n) m = n - 1;
+            if (m > l) {
+                int iterations = 0;
+                do {
+                    if (++iterations > 60) throw std::runtime_error("Eigendecomposition did not converge.");
+                    double g = d[l];
+                    double p = (d[l + 1] - g) / (2.0 * e[l]);
+                    double r = std::hypot(p, 1.0);
+                    if (p < 0) r = -r;
+                    d[l] = e[l] / (p + r);
+                    d[l + 1] = e[l] * (p + r);
+                    double dl1 = d[l + 1];
+                    double h = g - d[l];
+                    for (size_t i = l + 2; i < n; ++i) d[i] -= h;
+                    f += h;
+
+                    p = d[m];
+                    double c = 1.0, c2 = c, c3 = c;
+                    double el1 = e[l + 1];
+                    double s = 0.0, s2 = 0.0;
+                    for (size_t i = m; i-- > l;) {
+                        c3 = c2;
+                        c2 = c;
+                        s2 = s;
+                        g = c * e[i];
+                        h = c * p;
+                        r = std::hypot(p, e[i]);
+                        e[i + 1] = s * r;
+                        s = e[i] / r;
+                        c = p / r;
+                        p = c * d[i] - s * g;
+                        d[i + 1] = h + s * (c * g + s * d[i]);
+                        double* wi = W.data() + i * n;
+                        double* wj = wi + n;
+                        for (size_t k = 0; k < n; ++k) {
+                            double t = wj[k];
+                            wj[k] = s * wi[k] + c * t;
+                            wi[k] = c * wi[k] - s * t;
+                        }
+                    }
+                    p = -s * s2 * c3 * el1 * e[l] / dl1;
+                    e[l] = s * p;
+                    d[l] = c * p;
+                } while (std::abs(e[l]) > eps * tst1);
+            }
+            d[l] += f;
+            e[l] = 0.0;
+        }
+
+        // Sort by decreasing eigenvalue
+        std::vector<size_t> order(n);
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::sort(order.begin(), order.end(), [&](size_t x, size_t y) { return d[x] > d[y]; });
+        std::vector<double> values(n);
+        Matrix<double> vectors(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            values[i] = d[order[i]];
+            std::copy_n(W.data() + order[i] * n, n, vectors.data_ptr() + i * n);
+        }
+        return {values, vectors};
+    }
+
+    /**
+     * @brief Returns an orthonormal basis Q (n x l) of the column space of Y (n x l).
+     * * Uses the eigendecomposition of the small Gram matrix Y^T Y = U L U^T and
+     * sets Q = Y U L^(-1/2), twice for numerical stability (as in CholeskyQR2).
+     * Directions with negligible energy become zero columns instead of failing.
+     */
+    inline Matrix<double> orthonormalize(const Matrix<double>& Y) {
+        Matrix<double> Q = Y;
+        for (int pass = 0; pass < 2; ++pass) {
+            auto [values, vectors] = symmetric_eigen(multiply_tn(Q, Q));
+            size_t l = values.size();
+            double cutoff = (values.empty() ? 0.0 : values[0]) * l * std::numeric_limits<double>::epsilon();
+            Matrix<double> R(l, l);
+            for (size_t i = 0; i < l; ++i) {
+                double inv = values[i] > cutoff && values[i] > 0 ? 1.0 / std::sqrt(values[i]) : 0.0;
+                for (size_t j = 0; j < l; ++j) R(j, i) = vectors(i, j) * inv;
+            }
+            Q = multiply(Q, R);
+        }
+        return Q;
+    }
+}
+
+#endif // LINALG_H
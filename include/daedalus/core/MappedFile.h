@@ -0,0 +1,142 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file.
+ */
+
+// include/daedalus/core/MappedFile.h
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class MappedFile
+ * @brief RAII wrapper around a read-only memory mapping of a file.
+ * * The whole file is mapped so that parsers can work on a single contiguous
+ * byte range without copying it into user-space buffers. The mapping is
+ * released when the object is destroyed. Empty files have a null data pointer.
+ */
+class MappedFile {
+    const char* ptr = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    /** @brief Unmaps the file and closes the handles. */
+    void release() {
+#ifdef _WIN32
+        if (ptr) UnmapViewOfFile(ptr);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (ptr) munmap(const_cast<char*>(ptr), length);
+        if (fd >= 0) close(fd);
+        fd = -1;
+#endif
+        ptr = nullptr;
+        length = 0;
+    }
+
+public:
+    /**
+     * @brief Maps a file into memory.
+     * @param path The path of the file.
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Could not open file: " + path);
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            release();
+            throw std::runtime_error("Could not read size of file: " + path);
+        }
+        length = static_cast<size_t>(size.QuadPart);
+        if (length == 0) return;
+
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) ptr = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!ptr) {
+            release();
+            throw std::runtime_error("Could not memory-map file: " + path);
+        }
+#else
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Could not open file: " + path);
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            release();
+            throw std::runtime_error("Could not read size of file: " + path);
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length == 0) return;
+
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            length = 0;
+            release();
+            throw std::runtime_error("Could not memory-map file: " + path);
+        }
+        ptr = static_cast<const char*>(mapped);
+#ifdef MADV_SEQUENTIAL
+        madvise(mapped, length, MADV_SEQUENTIAL);
+#endif
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            std::swap(ptr, other.ptr);
+            std::swap(length, other.length);
+#ifdef _WIN32
+            std::swap(file, other.file);
+            std::swap(mapping, other.mapping);
+#else
+            std::swap(fd, other.fd);
+#endif
+        }
+        return *this;
+    }
+
+    ~MappedFile() { release(); }
+
+    /** @brief Returns a pointer to the first byte of the file (null if empty). */
+    const char* data() const { return ptr; }
+
+    /** @brief Returns the size of the file in bytes. */
+    size_t size() const { return length; }
+};
+
+#endif // MAPPEDFILE_H
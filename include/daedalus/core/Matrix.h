@@ -18,6 +18,8 @@
 #include <cmath>
 #include <algorithm>
 #include <iterator>
+#include <string>
+#include "CsvWriter.h"
 
 template <typename T>
 
@@ -131,6 +133,43 @@ class Matrix {
         return ss.str();
     }
 
+    /**
+     * @brief Writes the matrix to a CSV file, one matrix row per line.
+     * * Values are formatted with std::to_chars (shortest representation that
+     * reads back exactly); NaN is written as an empty field. Blocks of rows are
+     * formatted in parallel and written in order.
+     * @param path The output path (overwritten).
+     * @param header Optional column names for a header line (one per column).
+     * @param delimiter The field separator.
+     * @param num_threads Number of formatting threads (0 means use all hardware threads).
+     * @throws std::invalid_argument If the header does not name every column.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void to_csv(const std::string& path, const std::vector<std::string>& header = {}, char delimiter = ',',
+                size_t num_threads = 0) const {
+        if (!header.empty() && header.size() != num_cols) {
+            throw std::invalid_argument("Header must name every column of the Matrix.");
+        }
+        std::string head;
+        for (size_t j = 0; j < header.size(); ++j) {
+            if (j > 0) head.push_back(delimiter);
+            Csv::append_text(head, header[j], delimiter);
+        }
+        if (!header.empty()) head.push_back('\n');
+
+        const T* values = data.data();
+        Csv::write_blocks(path, head, num_rows, num_cols * 20 + 1, [&](size_t lo, size_t hi, std::string& out) {
+            for (size_t i = lo; i < hi; ++i) {
+                const T* row = values + i * num_cols;
+                for (size_t j = 0; j < num_cols; ++j) {
+                    if (j > 0) out.push_back(delimiter);
+                    Csv::append_number(out, row[j]);
+                }
+                out.push_back('\n');
+            }
+        }, num_threads);
+    }
+
     // --- Getters ---
 
     /** @return Number of rows in the matrix. */
@@ -1,62 +1,426 @@
 /**
- * @file Utils.h
- * @brief General utility functions for data manipulation and dataset preparation.
+ * @file ModelSelection.h
+ * @brief Utilities for splitting datasets into training and evaluation subsets.
+ * * Splits are computed as row indices. A MatrixView pairs those indices with
+ * the original matrix, so a split costs O(rows) memory instead of a copy of
+ * the data; take_rows() gathers a view into a new matrix, in parallel, only
+ * when a contiguous copy is actually needed. cross_validate() evaluates a
+ * model on k folds, training the folds concurrently.
  */
 
-// include/daedalus/core/Utils.h
+// include/daedalus/core/ModelSelection.h
 
-#ifndef UTILS_H
-#define UTILS_H
+#ifndef MODELSELECTION_H
+#define MODELSELECTION_H
 
 #include "Matrix.h"
+#include "Metrics.h"
+#include "Parallel.h"
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 #include <numeric>
 
+/** @brief Row indices of a train/test split. */
+struct SplitIndices {
+    std::vector<size_t> train;
+    std::vector<size_t> test;
+};
+
+/**
+ * @brief Copies the given rows of X, in order, into a new matrix.
+ * * Each row is one contiguous block copy; blocks of rows are copied in parallel.
+ * @param X The source matrix.
+ * @param rows Row indices into X; may repeat.
+ * @param num_threads Number of threads to use (0 = hardware concurrency).
+ * @throws std::out_of_range If an index is not a row of X.
+ */
+template <typename T>
+Matrix<T> take_rows(const Matrix<T>& X, const std::vector<size_t>& rows, size_t num_threads = 0) {
+    size_t cols = X.cols();
+    for (size_t r : rows) {
+        if (r >= X.rows()) throw std::out_of_range("Row index " + std::to_string(r) + " is out of range.");
+    }
+    Matrix<T> result(rows.size(), cols);
+    const T* src = X.data_ptr();
+    T* dst = result.data_ptr();
+    // Give every thread at least ~64K elements so small gathers stay serial
+    size_t min_rows = std::max<size_t>(1, (size_t(1) << 16) / std::max<size_t>(cols, 1));
+    Parallel::parallel_for(0, rows.size(), [&](size_t i) {
+        std::copy_n(src + rows[i] * cols, cols, dst + i * cols);
+    }, num_threads, min_rows);
+    return result;
+}
+
+/**
+ * @class MatrixView
+ * @brief A read-only selection of rows of a matrix, in a given order, without copying them.
+ * * The view refers to the source matrix, which must outlive it. The index
+ * list is shared, so the X and y views of the same split hold one copy of it.
+ * @tparam T The numeric type stored in the matrix.
+ */
+template <typename T>
+class MatrixView {
+private:
+    const Matrix<T>* source;
+    std::shared_ptr<const std::vector<size_t>> index;
+
+public:
+    /**
+     * @brief Constructs a view of the given rows of X.
+     * @throws std::out_of_range If an index is not a row of X.
+     */
+    MatrixView(const Matrix<T>& X, std::shared_ptr<const std::vector<size_t>> rows)
+        : source(&X), index(std::move(rows)) {
+        for (size_t r : *index) {
+            if (r >= X.rows()) throw std::out_of_range("Row index " + std::to_string(r) + " is out of range.");
+        }
+    }
+
+    size_t rows() const { return index->size(); }
+    size_t cols() const { return source->cols(); }
+
+    /** @brief Returns the element at row r of the view, column c. */
+    const T& operator()(size_t r, size_t c) const { return (*source)(index->at(r), c); }
+
+    /** @brief Returns a pointer to the contiguous storage of row r of the view (unchecked). */
+    const T* row_ptr(size_t r) const { return source->data_ptr() + (*index)[r] * source->cols(); }
+
+    /** @brief Returns the source row of every row of the view. */
+    const std::vector<size_t>& indices() const { return *index; }
+
+    /** @brief Returns the matrix the view refers to. */
+    const Matrix<T>& base() const { return *source; }
+
+    /** @brief Copies the viewed rows into a new matrix (a parallel gather). */
+    Matrix<T> materialize(size_t num_threads = 0) const { return take_rows(*source, *index, num_threads); }
+};
+
+namespace ModelSelection {
+    /** @brief Returns the number of test rows for a split of n rows, validating test_size. */
+    inline size_t test_count(size_t n, double test_size) {
+        if (!(test_size >= 0.0 && test_size <= 1.0)) {
+            throw std::invalid_argument("test_size must be between 0.0 and 1.0.");
+        }
+        return static_cast<size_t>(n * test_size);
+    }
+
+    /** @brief Throws if X and y do not have the same number of rows. */
+    template <typename T>
+    void check_rows(const Matrix<T>& X, const Matrix<T>& y) {
+        if (X.rows() != y.rows()) {
+            throw std::invalid_argument("X has " + std::to_string(X.rows()) + " rows but y has " +
+                                        std::to_string(y.rows()) + ".");
+        }
+    }
+}
+
+/**
+ * @brief Shuffles the row indices 0..n-1 and splits them into train and test sets.
+ * @param n Number of rows.
+ * @param test_size The proportion of rows in the test set (0.0 to 1.0).
+ * @param seed The seed for the random number generator.
+ * @throws std::invalid_argument If test_size is outside [0, 1].
+ */
+inline SplitIndices train_test_split_indices(size_t n, double test_size = 0.2, int seed = 42) {
+    size_t test_rows = ModelSelection::test_count(n, test_size);
+    std::vector<size_t> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::shuffle(indices.begin(), indices.end(), std::default_random_engine(seed));
+
+    SplitIndices split;
+    split.train.assign(indices.begin(), indices.end() - static_cast<std::ptrdiff_t>(test_rows));
+    split.test.assign(indices.end() - static_cast<std::ptrdiff_t>(test_rows), indices.end());
+    return split;
+}
+
+/**
+ * @brief Splits row indices so every class of y has the same share of rows in the test set.
+ * * Classes are the distinct values of the first column of y. Each class
+ * contributes floor(count * test_size) test rows, and the rows left over to
+ * reach the total of train_test_split_indices() go to the classes with the
+ * largest remainders. Both sets are shuffled, so classes are interleaved.
+ * @param y Target matrix; the first column holds the class labels.
+ * @param test_size The proportion of rows in the test set (0.0 to 1.0).
+ * @param seed The seed for the random number generator.
+ * @throws std::invalid_argument If test_size is outside [0, 1] or y has no columns.
+ */
+template <typename T>
+SplitIndices stratified_split_indices(const Matrix<T>& y, double test_size = 0.2, int seed = 42) {
+    size_t n = y.rows();
+    size_t test_rows = ModelSelection::test_count(n, test_size);
+    if (n > 0 && y.cols() == 0) throw std::invalid_argument("y must have at least one column.");
+
+    std::vector<size_t> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::default_random_engine rng(seed);
+    std::shuffle(indices.begin(), indices.end(), rng);
+
+    // Group the shuffled rows by label, so taking a prefix of a class is a random sample of it
+    std::map<T, std::vector<size_t>> classes;
+    const T* labels = y.data_ptr();
+    for (size_t r : indices) classes[labels[r * y.cols()]].push_back(r);
+
+    std::vector<std::vector<size_t>*> groups;
+    std::vector<size_t> quota;
+    std::vector<std::pair<double, size_t>> remainders;
+    size_t assigned = 0;
+    for (auto& entry : classes) {
+        double exact = entry.second.size() * test_size;
+        size_t whole = static_cast<size_t>(exact);
+        remainders.push_back({exact - whole, groups.size()});
+        groups.push_back(&entry.second);
+        quota.push_back(whole);
+        assigned += whole;
+    }
+    std::stable_sort(remainders.begin(), remainders.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (size_t i = 0; assigned < test_rows && i < remainders.size(); ++i) {
+        size_t g = remainders[i].second;
+        if (quota[g] < groups[g]->size()) {
+            ++quota[g];
+            ++assigned;
+        }
+    }
+
+    SplitIndices split;
+    split.train.reserve(n - test_rows);
+    split.test.reserve(test_rows);
+    for (size_t g = 0; g < groups.size(); ++g) {
+        const auto& rows = *groups[g];
+        split.test.insert(split.test.end(), rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(quota[g]));
+        split.train.insert(split.train.end(), rows.begin() + static_cast<std::ptrdiff_t>(quota[g]), rows.end());
+    }
+    std::shuffle(split.train.begin(), split.train.end(), rng);
+    std::shuffle(split.test.begin(), split.test.end(), rng);
+    return split;
+}
+
+/**
+ * @brief Splits X and y into train and test views over the original matrices.
+ * * No data is copied. X and y must outlive the returned views.
+ * @param X Feature matrix.
+ * @param y Target matrix.
+ * @param test_size The proportion of the dataset to include in the test split (0.0 to 1.0).
+ * @param seed The seed for the random number generator to ensure reproducibility.
+ * @param stratify Whether to preserve the class proportions of the first column of y.
+ * @return A tuple containing {X_train, X_test, y_train, y_test}.
+ * @throws std::invalid_argument If X and y have different row counts or test_size is outside [0, 1].
+ */
+template <typename T>
+std::tuple<MatrixView<T>, MatrixView<T>, MatrixView<T>, MatrixView<T>> train_test_split_views(
+    const Matrix<T>& X, const Matrix<T>& y, double test_size = 0.2, int seed = 42, bool stratify = false) {
+    ModelSelection::check_rows(X, y);
+    SplitIndices split = stratify ? stratified_split_indices(y, test_size, seed)
+                                  : train_test_split_indices(X.rows(), test_size, seed);
+    auto train = std::make_shared<const std::vector<size_t>>(std::move(split.train));
+    auto test = std::make_shared<const std::vector<size_t>>(std::move(split.test));
+    return {MatrixView<T>(X, train), MatrixView<T>(X, test), MatrixView<T>(y, train), MatrixView<T>(y, test)};
+}
+
 /**
  * @brief Splits matrices into random train and test subsets.
- * * This function shuffles the dataset indices and partitions the features (X) 
- * and targets (y) into two sets based on the @p test_size ratio.
+ * * This function shuffles the dataset indices and partitions the features (X)
+ * and targets (y) into two sets based on the @p test_size ratio. The rows are
+ * gathered in parallel; use train_test_split_views() to avoid the copies.
  * @tparam T The numeric type stored in the matrices.
  * @param X Feature matrix.
  * @param y Target matrix.
  * @param test_size The proportion of the dataset to include in the test split (0.0 to 1.0).
  * @param seed The seed for the random number generator to ensure reproducibility.
- * @return std::tuple<Matrix<T>, Matrix<T>, Matrix<T>, Matrix<T>> 
+ * @param stratify Whether to preserve the class proportions of the first column of y.
+ * @return std::tuple<Matrix<T>, Matrix<T>, Matrix<T>, Matrix<T>>
  * A tuple containing {X_train, X_test, y_train, y_test}.
+ * @throws std::invalid_argument If X and y have different row counts or test_size is outside [0, 1].
  */
 template <typename T>
 std::tuple<Matrix<T>, Matrix<T>, Matrix<T>, Matrix<T>> train_test_split(
-    const Matrix<T>& X, const Matrix<T>& y, double test_size = 0.2, int seed = 42) {
-    
-    size_t total_rows = X.rows();
-    size_t x_cols = X.cols();
-    size_t y_cols = y.cols();
-    size_t test_rows = static_cast<size_t>(total_rows * test_size);
-    size_t train_rows = total_rows - test_rows;
-
-    std::vector<size_t> indices(total_rows);
+    const Matrix<T>& X, const Matrix<T>& y, double test_size = 0.2, int seed = 42, bool stratify = false) {
+    ModelSelection::check_rows(X, y);
+    SplitIndices split = stratify ? stratified_split_indices(y, test_size, seed)
+                                  : train_test_split_indices(X.rows(), test_size, seed);
+    return {take_rows(X, split.train), take_rows(X, split.test), take_rows(y, split.train), take_rows(y, split.test)};
+}
+
+/**
+ * @brief Splits the row indices 0..n-1 into k folds for cross-validation.
+ * * The (optionally shuffled) rows are cut into k contiguous test folds whose
+ * sizes differ by at most one; each fold's training set is every other row.
+ * @param n Number of rows.
+ * @param k Number of folds.
+ * @param shuffle Whether to shuffle the rows before cutting the folds.
+ * @param seed The seed for the random number generator.
+ * @throws std::invalid_argument If k < 2 or k > n.
+ */
+inline std::vector<SplitIndices> kfold_indices(size_t n, size_t k, bool shuffle = true, int seed = 42) {
+    if (k < 2 || k > n) throw std::invalid_argument("The number of folds must be between 2 and the number of rows.");
+    std::vector<size_t> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    if (shuffle) std::shuffle(indices.begin(), indices.end(), std::default_random_engine(seed));
+
+    std::vector<SplitIndices> folds(k);
+    for (size_t f = 0; f < k; ++f) {
+        auto lo = indices.begin() + static_cast<std::ptrdiff_t>(n * f / k);
+        auto hi = indices.begin() + static_cast<std::ptrdiff_t>(n * (f + 1) / k);
+        folds[f].test.assign(lo, hi);
+        folds[f].train.reserve(n - folds[f].test.size());
+        folds[f].train.insert(folds[f].train.end(), indices.begin(), lo);
+        folds[f].train.insert(folds[f].train.end(), hi, indices.end());
+    }
+    return folds;
+}
+
+/**
+ * @brief Splits row indices into k folds that each keep the class proportions of y.
+ * * The rows of each class (the distinct values of the first column of y) are
+ * shuffled and dealt to the folds in turn, continuing from the fold where the
+ * previous class stopped, so fold sizes differ by at most one.
+ * @param y Target matrix; the first column holds the class labels.
+ * @param k Number of folds.
+ * @param seed The seed for the random number generator.
+ * @throws std::invalid_argument If k < 2, k > rows or y has no columns.
+ */
+template <typename T>
+std::vector<SplitIndices> stratified_kfold_indices(const Matrix<T>& y, size_t k, int seed = 42) {
+    size_t n = y.rows();
+    if (k < 2 || k > n) throw std::invalid_argument("The number of folds must be between 2 and the number of rows.");
+    if (y.cols() == 0) throw std::invalid_argument("y must have at least one column.");
+
+    std::vector<size_t> indices(n);
     std::iota(indices.begin(), indices.end(), 0);
     std::shuffle(indices.begin(), indices.end(), std::default_random_engine(seed));
+    std::map<T, std::vector<size_t>> classes;
+    const T* labels = y.data_ptr();
+    for (size_t r : indices) classes[labels[r * y.cols()]].push_back(r);
 
-    Matrix<T> X_train(train_rows, x_cols);
-    Matrix<T> X_test(test_rows, x_cols);
-    Matrix<T> y_train(train_rows, y_cols);
-    Matrix<T> y_test(test_rows, y_cols);
+    std::vector<size_t> fold_of(n);
+    size_t next = 0;
+    for (const auto& entry : classes) {
+        for (size_t r : entry.second) {
+            fold_of[r] = next;
+            next = (next + 1) % k;
+        }
+    }
 
-    for (size_t i = 0; i < train_rows; ++i) {
-        for (size_t j = 0; j < x_cols; ++j) X_train(i, j) = X(indices[i], j);
-        for (size_t j = 0; j < y_cols; ++j) y_train(i, j) = y(indices[i], j);
+    std::vector<SplitIndices> folds(k);
+    for (size_t r : indices) {
+        for (size_t f = 0; f < k; ++f) (f == fold_of[r] ? folds[f].test : folds[f].train).push_back(r);
     }
+    return folds;
+}
+
+namespace ModelSelection {
+    /** @brief A metric computed from (y_true, y_pred). */
+    using Scorer = std::function<double(const Matrix<double>&, const Matrix<double>&)>;
 
-    for (size_t i = 0; i < test_rows; ++i) {
-        for (size_t j = 0; j < x_cols; ++j) X_test(i, j) = X(indices[train_rows + i], j);
-        for (size_t j = 0; j < y_cols; ++j) y_test(i, j) = y(indices[train_rows + i], j);
+    /**
+     * @brief Returns the Metrics function with the given name.
+     * @throws std::invalid_argument If the name is not a known metric.
+     */
+    inline Scorer scorer(const std::string& name) {
+        if (name == "mean_squared_error") return Metrics::mean_squared_error;
+        if (name == "r2_score") return Metrics::r2_score;
+        if (name == "accuracy_score") return Metrics::accuracy_score;
+        if (name == "precision_score") return Metrics::precision_score;
+        if (name == "recall_score") return Metrics::recall_score;
+        if (name == "f1_score") return Metrics::f1_score;
+        if (name == "mcc_score") return Metrics::mcc_score;
+        throw std::invalid_argument("Unknown metric: " + name);
     }
+}
 
-    return {X_train, X_test, y_train, y_test};
+/**
+ * @brief Evaluates one model per fold and collects timings and test scores.
+ * * Each fold trains on its own model, so the folds run concurrently, one per
+ * thread. A fold gathers its training rows from the shared index lists just
+ * before fitting and releases them before scoring, so at most one training
+ * copy per running fold exists at a time.
+ * @tparam ModelPtr A pointer-like type to a model with fit(X, y) and predict(X).
+ * @param models One unfitted model per fold.
+ * @param X Feature matrix.
+ * @param y Target matrix.
+ * @param folds The train/test indices of every fold (see kfold_indices()).
+ * @param metrics Names of Metrics functions computed on each test fold.
+ * @param num_threads Maximum number of folds trained at once (0 = hardware concurrency).
+ * @return A map from "fit_time" and "score_time" (seconds) and "test_<metric>"
+ *         to one value per fold, in fold order.
+ * @throws std::invalid_argument If the counts of models and folds differ, X and y
+ *         have different row counts, or a metric is unknown.
+ */
+template <typename ModelPtr>
+std::map<std::string, std::vector<double>> cross_validate_models(
+    const std::vector<ModelPtr>& models, const Matrix<double>& X, const Matrix<double>& y,
+    const std::vector<SplitIndices>& folds, const std::vector<std::string>& metrics, size_t num_threads = 0) {
+    ModelSelection::check_rows(X, y);
+    if (models.size() != folds.size()) throw std::invalid_argument("cross_validate needs one model per fold.");
+    std::vector<ModelSelection::Scorer> scorers;
+    for (const auto& name : metrics) scorers.push_back(ModelSelection::scorer(name));
+
+    size_t k = folds.size();
+    std::vector<double> fit_time(k), score_time(k);
+    std::vector<std::vector<double>> scores(metrics.size(), std::vector<double>(k));
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](Clock::time_point since) {
+        return std::chrono::duration<double>(Clock::now() - since).count();
+    };
+
+    Parallel::parallel_for(0, k, [&](size_t f) {
+        auto& model = models[f];
+        auto start = Clock::now();
+        {
+            Matrix<double> X_train = take_rows(X, folds[f].train, 1);
+            Matrix<double> y_train = take_rows(y, folds[f].train, 1);
+            model->fit(X_train, y_train);
+        }
+        fit_time[f] = seconds(start);
+
+        start = Clock::now();
+        Matrix<double> y_pred = model->predict(take_rows(X, folds[f].test, 1));
+        Matrix<double> y_test = take_rows(y, folds[f].test, 1);
+        for (size_t m = 0; m < scorers.size(); ++m) scores[m][f] = scorers[m](y_test, y_pred);
+        score_time[f] = seconds(start);
+    }, num_threads);
+
+    std::map<std::string, std::vector<double>> result;
+    result["fit_time"] = std::move(fit_time);
+    result["score_time"] = std::move(score_time);
+    for (size_t m = 0; m < metrics.size(); ++m) result["test_" + metrics[m]] = std::move(scores[m]);
+    return result;
+}
+
+/**
+ * @brief K-fold cross-validation of the models built by a factory.
+ * * make_model() is called once per fold on the calling thread before any
+ * training starts, so it does not need to be thread-safe; the folds are
+ * then trained concurrently (see cross_validate_models()).
+ * @param make_model Callable returning a new, unfitted model pointer.
+ * @param X Feature matrix.
+ * @param y Target matrix.
+ * @param k Number of folds.
+ * @param metrics Names of Metrics functions computed on each test fold.
+ * @param stratify Whether to keep the class proportions of the first column of y in every fold.
+ * @param seed The seed used to shuffle the rows.
+ * @param num_threads Maximum number of folds trained at once (0 = hardware concurrency).
+ */
+template <typename Factory>
+std::map<std::string, std::vector<double>> cross_validate(
+    Factory&& make_model, const Matrix<double>& X, const Matrix<double>& y, size_t k = 5,
+    const std::vector<std::string>& metrics = {"r2_score"}, bool stratify = false, int seed = 42,
+    size_t num_threads = 0) {
+    ModelSelection::check_rows(X, y);
+    std::vector<SplitIndices> folds = stratify ? stratified_kfold_indices(y, k, seed) : kfold_indices(X.rows(), k, true, seed);
+    std::vector<decltype(make_model())> models;
+    models.reserve(k);
+    for (size_t f = 0; f < k; ++f) models.push_back(make_model());
+    return cross_validate_models(models, X, y, folds, metrics, num_threads);
 }
 
-#endif // UTILS_H
\ No newline at end of file
+#endif // MODELSELECTION_H
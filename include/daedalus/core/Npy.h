@@ -0,0 +1,437 @@
+/**
+ * @file Npy.h
+ * @brief Native reading and writing of NumPy .npy arrays and uncompressed .npz archives.
+ * * An .npy file is a magic string, a version, a Python dict literal describing
+ * the dtype, memory order and shape, and the raw array data. Files are
+ * memory-mapped, so loading a C-order float64 array is a single copy from the
+ * page cache into the Matrix; other supported dtypes are converted and
+ * Fortran-order arrays transposed in parallel blocks of rows.
+ * * An .npz file is a zip archive of .npy members. Members must be stored
+ * without compression (np.savez, not np.savez_compressed); they are then
+ * read in place from the mapping of the archive.
+ */
+
+// include/daedalus/core/Npy.h
+
+#ifndef NPY_H
+#define NPY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "Matrix.h"
+#include "Parallel.h"
+
+/**
+ * @namespace Npy
+ * @brief The .npy header format, dtype conversion and the zip container of .npz files.
+ */
+namespace Npy {
+    /** @brief The magic string that starts every .npy file. */
+    constexpr char MAGIC[] = "\x93NUMPY";
+    constexpr size_t MAGIC_SIZE = 6;
+
+    /** @brief Elements copied or converted by a single thread at minimum. */
+    constexpr size_t MIN_PARALLEL_ELEMENTS = size_t(1) << 18;
+
+    /**
+     * @struct Header
+     * @brief The description of the array stored in an .npy file.
+     */
+    struct Header {
+        std::string descr;              ///< NumPy type string, e.g. "<f8".
+        bool fortran_order = false;     ///< True if the data is stored column-major.
+        std::vector<size_t> shape;      ///< The array dimensions (empty for a scalar).
+        size_t data_offset = 0;         ///< Position of the first data byte.
+    };
+
+    /** @brief Returns the value of a key in the header dict literal (up to the next top-level comma). */
+    inline std::string dict_value(const std::string& dict, const std::string& key) {
+        size_t pos = dict.find("'" + key + "'");
+        if (pos == std::string::npos) throw std::runtime_error("Invalid .npy header: missing '" + key + "'.");
+        pos = dict.find(':', pos);
+        if (pos == std::string::npos) throw std::runtime_error("Invalid .npy header.");
+        size_t end = pos + 1;
+        int depth = 0;
+        while (end < dict.size() && (depth > 0 || (dict[end] != ',' && dict[end] != '}'))) {
+            if (dict[end] == '(') ++depth;
+            else if (dict[end] == ')') --depth;
+            ++end;
+        }
+        std::string value = dict.substr(pos + 1, end - pos - 1);
+        size_t first = value.find_first_not_of(" '\"");
+        size_t last = value.find_last_not_of(" '\"");
+        return first == std::string::npos ? std::string() : value.substr(first, last - first + 1);
+    }
+
+    /**
+     * @brief Parses the header of an .npy file.
+     * @throws std::runtime_error If the data is not an .npy array.
+     */
+    inline Header parse_header(const char* data, size_t size) {
+        if (size < MAGIC_SIZE + 4 || std::memcmp(data, MAGIC, MAGIC_SIZE) != 0) {
+            throw std::runtime_error("Not a .npy file.");
+        }
+        auto byte = [&](size_t i) { return static_cast<size_t>(static_cast<uint8_t>(data[i])); };
+        size_t major = byte(MAGIC_SIZE);
+        size_t length, start;
+        if (major == 1) {
+            length = byte(8) | (byte(9) << 8);
+            start = 10;
+        } else if ((major == 2 || major == 3) && size >= 12) {
+            length = byte(8) | (byte(9) << 8) | (byte(10) << 16) | (byte(11) << 24);
+            start = 12;
+        } else {
+            throw std::runtime_error("Unsupported .npy version " + std::to_string(major) + ".");
+        }
+        if (start + length > size) throw std::runtime_error("Truncated .npy header.");
+
+        Header header;
+        std::string dict(data + start, length);
+        header.descr = dict_value(dict, "descr");
+        header.fortran_order = dict_value(dict, "fortran_order") == "True";
+        std::string shape = dict_value(dict, "shape");
+        for (size_t i = 0; i < shape.size(); ) {
+            if (shape[i] < '0' || shape[i] > '9') { ++i; continue; }
+            size_t n = 0;
+            while (i < shape.size() && shape[i] >= '0' && shape[i] <= '9') n = n * 10 + static_cast<size_t>(shape[i++] - '0');
+            header.shape.push_back(n);
+        }
+        header.data_offset = start + length;
+        return header;
+    }
+
+    /** @brief Returns the number of bytes of one element of a supported type string, or 0. */
+    inline size_t item_size(const std::string& descr) {
+        static const char* const types[] = {"<f8", "<f4", "<i8", "<i4", "<u1", "|u1", "|b1", "|i1", "<i2", "<u4"};
+        for (const char* t : types) {
+            if (descr == t) return static_cast<size_t>(std::atoi(t + 2));
+        }
+        if (descr == "=f8") return 8;
+        return 0;
+    }
+
+    /** @brief Reads element i of a little-endian typed buffer as a double. */
+    inline double element(const char* p, char kind, size_t width, size_t i) {
+        const char* at = p + i * width;
+        switch (kind) {
+            case 'f':
+                if (width == 8) { double v; std::memcpy(&v, at, 8); return v; }
+                else { float v; std::memcpy(&v, at, 4); return v; }
+            case 'i':
+                if (width == 8) { int64_t v; std::memcpy(&v, at, 8); return static_cast<double>(v); }
+                if (width == 4) { int32_t v; std::memcpy(&v, at, 4); return v; }
+                if (width == 2) { int16_t v; std::memcpy(&v, at, 2); return v; }
+                return static_cast<int8_t>(*at);
+            case 'u':
+                if (width == 4) { uint32_t v; std::memcpy(&v, at, 4); return v; }
+                return static_cast<uint8_t>(*at);
+            default:
+                return *at != 0 ? 1.0 : 0.0;
+        }
+    }
+
+    /**
+     * @brief Converts the bytes of an .npy array into a Matrix<double>.
+     * * 0-d arrays become 1x1, 1-d arrays column vectors (N x 1) and 2-d arrays
+     * keep their shape. C-order float64 data is copied with memcpy; other
+     * types are converted and Fortran-order data transposed, all in parallel.
+     * @param data The whole .npy content (header and array).
+     * @param size Size of the content in bytes.
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     * @throws std::runtime_error If the header is invalid, the type is unsupported
+     *         (big-endian, complex, strings, objects), the array has more than two
+     *         dimensions or the data is truncated.
+     */
+    inline Matrix<double> to_matrix(const char* data, size_t size, size_t num_threads = 0) {
+        Header header = parse_header(data, size);
+        size_t width = item_size(header.descr);
+        if (width == 0) throw std::runtime_error("Unsupported .npy dtype: " + header.descr);
+        if (header.shape.size() > 2) {
+            throw std::runtime_error("Only 1-d and 2-d arrays can be loaded into a Matrix, got "
+                                     + std::to_string(header.shape.size()) + " dimensions.");
+        }
+        size_t rows = header.shape.empty() ? 1 : header.shape[0];
+        size_t cols = header.shape.size() == 2 ? header.shape[1] : 1;
+        size_t count = rows * cols;
+        if (header.data_offset + count * width > size) throw std::runtime_error("Truncated .npy data.");
+
+        Matrix<double> result(rows, cols);
+        const char* src = data + header.data_offset;
+        double* out = result.data_ptr();
+        char kind = header.descr[1];
+        bool transpose = header.fortran_order && rows > 1 && cols > 1;
+        size_t min_rows = std::max<size_t>(1, MIN_PARALLEL_ELEMENTS / std::max<size_t>(cols, 1));
+        Parallel::parallel_blocks(0, rows, [&](size_t lo, size_t hi, size_t) {
+            if (transpose) {
+                // Element (r, c) of a column-major array is at c * rows + r
+                for (size_t c = 0; c < cols; ++c) {
+                    for (size_t r = lo; r < hi; ++r) out[r * cols + c] = element(src, kind, width, c * rows + r);
+                }
+            } else if (kind == 'f' && width == 8) {
+                std::memcpy(out + lo * cols, src + lo * cols * 8, (hi - lo) * cols * 8);
+            } else {
+                for (size_t i = lo * cols; i < hi * cols; ++i) out[i] = element(src, kind, width, i);
+            }
+        }, num_threads, min_rows);
+        return result;
+    }
+
+    /**
+     * @brief Returns the .npy header (magic, version and padded dict) for a C-order float64 matrix.
+     * * The header is padded with spaces so the data starts at a multiple of
+     * 64 bytes, as NumPy does; version 2.0 is used if it exceeds 65535 bytes.
+     */
+    inline std::string encode_header(size_t rows, size_t cols) {
+        std::string dict = "{'descr': '<f8', 'fortran_order': False, 'shape': (" + std::to_string(rows) + ", "
+                         + std::to_string(cols) + "), }";
+        bool v2 = dict.size() + 11 > 65535;
+        size_t prefix = v2 ? 12 : 10;
+        size_t total = ((prefix + dict.size() + 1 + 63) / 64) * 64;
+        dict.append(total - prefix - dict.size() - 1, ' ');
+        dict.push_back('\n');
+
+        std::string header(MAGIC, MAGIC_SIZE);
+        header.push_back(static_cast<char>(v2 ? 2 : 1));
+        header.push_back(0);
+        size_t length = dict.size();
+        for (size_t i = 0; i < (v2 ? 4u : 2u); ++i) header.push_back(static_cast<char>((length >> (8 * i)) & 0xff));
+        return header + dict;
+    }
+
+    /** @brief Returns the CRC-32 (as used by zip) of a byte range, continuing from crc. */
+    inline uint32_t crc32(const char* p, size_t n, uint32_t crc = 0) {
+        static const std::vector<uint32_t> table = [] {
+            std::vector<uint32_t> t(256);
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[i] = c;
+            }
+            return t;
+        }();
+        crc = ~crc;
+        for (size_t i = 0; i < n; ++i) crc = table[(crc ^ static_cast<uint8_t>(p[i])) & 0xff] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    /** @brief Reads a little-endian integer of n bytes. */
+    inline uint64_t read_le(const char* p, size_t n) {
+        uint64_t v = 0;
+        for (size_t i = 0; i < n; ++i) v |= static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+        return v;
+    }
+
+    /** @brief Appends a little-endian integer of n bytes. */
+    inline void write_le(std::string& out, uint64_t v, size_t n) {
+        for (size_t i = 0; i < n; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+
+    /**
+     * @struct ZipEntry
+     * @brief A member of a zip archive, located from the central directory.
+     */
+    struct ZipEntry {
+        std::string name;
+        uint16_t method = 0;        ///< 0 means stored (uncompressed).
+        size_t offset = 0;          ///< Position of the member data in the archive.
+        size_t size = 0;            ///< Stored size of the member data.
+    };
+
+    /**
+     * @brief Lists the members of a zip archive, including zip64 archives.
+     * @throws std::runtime_error If the archive is malformed.
+     */
+    inline std::vector<ZipEntry> zip_entries(const char* data, size_t size) {
+        // The end of central directory record is within the last 64 KiB + 22 bytes
+        if (size < 22) throw std::runtime_error("Not a zip archive.");
+        size_t eocd = std::string::npos;
+        for (size_t pos = size - 22 + 1; pos-- > 0 && size - pos <= 65535 + 22; ) {
+            if (read_le(data + pos, 4) == 0x06054b50) { eocd = pos; break; }
+        }
+        if (eocd == std::string::npos) throw std::runtime_error("Not a zip archive.");
+        uint64_t count = read_le(data + eocd + 10, 2);
+        uint64_t directory = read_le(data + eocd + 16, 4);
+        if ((count == 0xffff || directory == 0xffffffff) && eocd >= 20 && read_le(data + eocd - 20, 4) == 0x07064b50) {
+            uint64_t record = read_le(data + eocd - 20 + 8, 8);
+            if (record + 56 > size || read_le(data + record, 4) != 0x06064b50) throw std::runtime_error("Corrupt zip64 archive.");
+            count = read_le(data + record + 32, 8);
+            directory = read_le(data + record + 48, 8);
+        }
+
+        std::vector<ZipEntry> entries;
+        size_t pos = static_cast<size_t>(directory);
+        for (uint64_t e = 0; e < count; ++e) {
+            if (pos + 46 > size || read_le(data + pos, 4) != 0x02014b50) throw std::runtime_error("Corrupt zip directory.");
+            ZipEntry entry;
+            entry.method = static_cast<uint16_t>(read_le(data + pos + 10, 2));
+            uint64_t stored = read_le(data + pos + 20, 4);
+            uint64_t raw = read_le(data + pos + 24, 4);
+            size_t name_length = static_cast<size_t>(read_le(data + pos + 28, 2));
+            size_t extra_length = static_cast<size_t>(read_le(data + pos + 30, 2));
+            size_t comment_length = static_cast<size_t>(read_le(data + pos + 32, 2));
+            uint64_t local = read_le(data + pos + 42, 4);
+            if (pos + 46 + name_length + extra_length > size) throw std::runtime_error("Corrupt zip directory.");
+            entry.name.assign(data + pos + 46, name_length);
+
+            // Zip64 extra field: the 64-bit values of the fields saturated at 0xffffffff, in order
+            const char* extra = data + pos + 46 + name_length;
+            for (size_t x = 0; x + 4 <= extra_length; ) {
+                size_t id = static_cast<size_t>(read_le(extra + x, 2));
+                size_t length = static_cast<size_t>(read_le(extra + x + 2, 2));
+                if (id == 1) {
+                    size_t field = x + 4;
+                    if (raw == 0xffffffff && field + 8 <= x + 4 + length) { raw = read_le(extra + field, 8); field += 8; }
+                    if (stored == 0xffffffff && field + 8 <= x + 4 + length) { stored = read_le(extra + field, 8); field += 8; }
+                    if (local == 0xffffffff && field + 8 <= x + 4 + length) { local = read_le(extra + field, 8); }
+                }
+                x += 4 + length;
+            }
+
+            if (local + 30 > size || read_le(data + local, 4) != 0x04034b50) throw std::runtime_error("Corrupt zip member.");
+            entry.offset = static_cast<size_t>(local + 30 + read_le(data + local + 26, 2) + read_le(data + local + 28, 2));
+            entry.size = static_cast<size_t>(stored);
+            if (entry.offset + entry.size > size) throw std::runtime_error("Truncated zip member: " + entry.name);
+            entries.push_back(std::move(entry));
+            pos += 46 + name_length + extra_length + comment_length;
+        }
+        return entries;
+    }
+
+    /**
+     * @class ZipWriter
+     * @brief Writes a zip archive of stored (uncompressed) members, using zip64 fields when needed.
+     */
+    class ZipWriter {
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file;
+        std::string path;
+        std::string directory;
+        uint64_t position = 0;
+        uint64_t count = 0;
+
+        void write(const char* p, size_t n) {
+            if (n > 0 && std::fwrite(p, 1, n, file.get()) != n) throw std::runtime_error("Could not write file: " + path);
+            position += n;
+        }
+
+    public:
+        /**
+         * @brief Creates (or overwrites) an archive.
+         * @throws std::runtime_error If the file cannot be opened.
+         */
+        explicit ZipWriter(const std::string& path) : file(std::fopen(path.c_str(), "wb"), &std::fclose), path(path) {
+            if (!file) throw std::runtime_error("Could not open file for writing: " + path);
+        }
+
+        /**
+         * @brief Appends a member whose content is the concatenation of the given parts.
+         */
+        void add(const std::string& name, const std::vector<std::pair<const char*, size_t>>& parts) {
+            uint64_t size = 0;
+            uint32_t crc = 0;
+            for (const auto& part : parts) {
+                size += part.second;
+                crc = crc32(part.first, part.second, crc);
+            }
+            bool zip64 = size >= 0xffffffff || position >= 0xffffffff;
+            uint64_t offset = position;
+
+            std::string local;
+            write_le(local, 0x04034b50, 4);
+            write_le(local, zip64 ? 45 : 20, 2);
+            write_le(local, 0, 2);                      // flags
+            write_le(local, 0, 2);                      // stored
+            write_le(local, 0, 2);                      // time
+            write_le(local, 0x21, 2);                   // date (1980-01-01)
+            write_le(local, crc, 4);
+            write_le(local, zip64 ? 0xffffffff : size, 4);
+            write_le(local, zip64 ? 0xffffffff : size, 4);
+            write_le(local, name.size(), 2);
+            write_le(local, zip64 ? 20 : 0, 2);
+            local += name;
+            if (zip64) {
+                write_le(local, 1, 2);
+                write_le(local, 16, 2);
+                write_le(local, size, 8);
+                write_le(local, size, 8);
+            }
+            write(local.data(), local.size());
+            for (const auto& part : parts) write(part.first, part.second);
+
+            std::string entry;
+            write_le(entry, 0x02014b50, 4);
+            write_le(entry, zip64 ? 45 : 20, 2);
+            write_le(entry, zip64 ? 45 : 20, 2);
+            write_le(entry, 0, 2);
+            write_le(entry, 0, 2);
+            write_le(entry, 0, 2);
+            write_le(entry, 0x21, 2);
+            write_le(entry, crc, 4);
+            write_le(entry, zip64 ? 0xffffffff : size, 4);
+            write_le(entry, zip64 ? 0xffffffff : size, 4);
+            write_le(entry, name.size(), 2);
+            write_le(entry, zip64 ? 28 : 0, 2);
+            write_le(entry, 0, 2);                      // comment
+            write_le(entry, 0, 2);                      // disk
+            write_le(entry, 0, 2);                      // internal attributes
+            write_le(entry, 0, 4);                      // external attributes
+            write_le(entry, zip64 ? 0xffffffff : offset, 4);
+            entry += name;
+            if (zip64) {
+                write_le(entry, 1, 2);
+                write_le(entry, 24, 2);
+                write_le(entry, size, 8);
+                write_le(entry, size, 8);
+                write_le(entry, offset, 8);
+            }
+            directory += entry;
+            ++count;
+        }
+
+        /**
+         * @brief Writes the central directory and closes the archive.
+         * @throws std::runtime_error If the file cannot be written.
+         */
+        void finish() {
+            uint64_t start = position;
+            write(directory.data(), directory.size());
+            bool zip64 = start >= 0xffffffff || count >= 0xffff;
+            std::string tail;
+            if (zip64) {
+                uint64_t record = position;
+                write_le(tail, 0x06064b50, 4);
+                write_le(tail, 44, 8);
+                write_le(tail, 45, 2);
+                write_le(tail, 45, 2);
+                write_le(tail, 0, 4);
+                write_le(tail, 0, 4);
+                write_le(tail, count, 8);
+                write_le(tail, count, 8);
+                write_le(tail, directory.size(), 8);
+                write_le(tail, start, 8);
+                write_le(tail, 0x07064b50, 4);
+                write_le(tail, 0, 4);
+                write_le(tail, record, 8);
+                write_le(tail, 1, 4);
+            }
+            write_le(tail, 0x06054b50, 4);
+            write_le(tail, 0, 2);
+            write_le(tail, 0, 2);
+            write_le(tail, zip64 ? 0xffff : count, 2);
+            write_le(tail, zip64 ? 0xffff : count, 2);
+            write_le(tail, directory.size(), 4);
+            write_le(tail, zip64 ? 0xffffffff : start, 4);
+            write_le(tail, 0, 2);
+            write(tail.data(), tail.size());
+            if (std::fflush(file.get()) != 0) throw std::runtime_error("Could not write file: " + path);
+        }
+    };
+}
+
+#endif // NPY_H
@@ -0,0 +1,103 @@
+/**
+ * @file Parallel.h
+ * @brief Lightweight helpers for splitting loops across hardware threads.
+ * * The helpers partition an index range into contiguous blocks and run each
+ * block on its own std::thread. Small ranges run inline on the calling thread
+ * so that callers can use them unconditionally.
+ */
+
+// include/daedalus/core/Parallel.h
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @namespace Parallel
+ * @brief Fork-join loop helpers built on std::thread.
+ */
+namespace Parallel {
+    /**
+     * @brief Returns the number of hardware threads available (at least 1).
+     */
+    inline size_t hardware_threads() {
+        unsigned int n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : static_cast<size_t>(n);
+    }
+
+    /**
+     * @brief Resolves a user supplied thread count.
+     * @param requested The requested number of threads (0 means use all hardware threads).
+     * @return The number of threads to use (at least 1).
+     */
+    inline size_t resolve_threads(size_t requested) {
+        return requested == 0 ? hardware_threads() : requested;
+    }
+
+    /**
+     * @brief Runs func(lo, hi, block) over contiguous blocks of [begin, end).
+     * * The range is split into at most @p num_threads blocks of at least
+     * @p min_block indices each. The first exception thrown by any block is
+     * rethrown on the calling thread once all blocks have finished.
+     * @param begin First index of the range.
+     * @param end One past the last index of the range.
+     * @param func Callable invoked as func(size_t lo, size_t hi, size_t block).
+     * @param num_threads Maximum number of threads (0 means use all hardware threads).
+     * @param min_block Minimum number of indices handed to a single thread.
+     */
+    template <typename Func>
+    void parallel_blocks(size_t begin, size_t end, Func&& func, size_t num_threads = 0, size_t min_block = 1) {
+        if (end <= begin) return;
+        size_t n = end - begin;
+        size_t blocks = std::min(resolve_threads(num_threads), (n + min_block - 1) / std::max<size_t>(min_block, 1));
+        if (blocks <= 1) {
+            func(begin, end, size_t(0));
+            return;
+        }
+
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        std::vector<std::thread> workers;
+        workers.reserve(blocks - 1);
+
+        auto run_block = [&](size_t b) {
+            size_t lo = begin + (n * b) / blocks;
+            size_t hi = begin + (n * (b + 1)) / blocks;
+            try {
+                func(lo, hi, b);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+            }
+        };
+
+        for (size_t b = 1; b < blocks; ++b) workers.emplace_back(run_block, b);
+        run_block(0);
+        for (auto& worker : workers) worker.join();
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    /**
+     * @brief Runs func(i) for every i in [begin, end) across threads.
+     * @param begin First index of the range.
+     * @param end One past the last index of the range.
+     * @param func Callable invoked as func(size_t i).
+     * @param num_threads Maximum number of threads (0 means use all hardware threads).
+     * @param min_block Minimum number of indices handed to a single thread.
+     */
+    template <typename Func>
+    void parallel_for(size_t begin, size_t end, Func&& func, size_t num_threads = 0, size_t min_block = 1) {
+        parallel_blocks(begin, end, [&func](size_t lo, size_t hi, size_t) {
+            for (size_t i = lo; i < hi; ++i) func(i);
+        }, num_threads, min_block);
+    }
+}
+
+#endif // PARALLEL_H
@@ -1,6 +1,17 @@
 /**
  * @file Preprocessing.h
  * @brief Tools for data scaling and feature transformation.
+ * * Every scaler implements the Transformer interface (fit, partial_fit,
+ * transform, transform_inplace, inverse_transform). The scalers are all
+ * per-column affine maps, so they share one transform kernel (ColumnScaler)
+ * and differ only in the statistics they collect: moments for
+ * StandardScaler, extrema for MinMaxScaler and MaxAbsScaler, and quantile
+ * sketches for RobustScaler. Statistics are gathered in one parallel pass
+ * over blocks of rows and the per-block results are merged, which is also
+ * how partial_fit folds a new batch into the running statistics. PCA is a
+ * Transformer too, built on the blocked kernels of Linalg.h, and
+ * PolynomialFeatures expands rows into products of features, either into a
+ * pre-sized matrix or lazily, batch by batch, through a PolynomialExpansion.
  */
 
 // include/daedalus/core/Preprocessing.h
@@ -8,81 +19,1142 @@
 #ifndef PREPROCESSING_H
 #define PREPROCESSING_H
 
+#include "Linalg.h"
 #include "Matrix.h"
+#include "Parallel.h"
+#include "Sketches.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+/**
+ * @class Transformer
+ * @brief Interface for feature transformations that are fitted on data and then applied to it.
+ */
+class Transformer {
+protected:
+    /** @brief Minimum number of rows handed to one thread. */
+    static constexpr size_t MIN_ROWS_PER_THREAD = 4096;
+
+    /** @brief Count, mean and sum of squared deviations of a set of rows. */
+    struct Moments {
+        size_t n = 0;
+        std::vector<double> mean;
+        std::vector<double> m2;
+    };
+
+    /**
+     * @brief Folds every block of rows of X into its own state, in parallel.
+     * @param X The data.
+     * @param initial The state each block starts from.
+     * @param accumulate Called as accumulate(state, row, cols) for every row of the block.
+     * @return The states of the non-empty blocks, in row order.
+     */
+    template <typename State, typename Accumulate>
+    static std::vector<State> reduce_row_blocks(const Matrix<double>& X, const State& initial, Accumulate accumulate) {
+        size_t cols = X.cols();
+        const double* data = X.data_ptr();
+        std::vector<State> states(Parallel::resolve_threads(0), initial);
+        std::vector<char> used(states.size(), 0);
+        Parallel::parallel_blocks(0, X.rows(), [&](size_t lo, size_t hi, size_t b) {
+            for (size_t r = lo; r < hi; ++r) accumulate(states[b], data + r * cols, cols);
+            used[b] = 1;
+        }, 0, MIN_ROWS_PER_THREAD);
+        std::vector<State> result;
+        for (size_t b = 0; b < states.size(); ++b) {
+            if (used[b]) result.push_back(std::move(states[b]));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Throws if a batch's column count differs from earlier batches.
+     * @param expected The column count of earlier batches (0 if there were none).
+     */
+    static void check_batch(const Matrix<double>& X, size_t expected) {
+        if (expected != 0 && X.cols() != expected) {
+            throw std::invalid_argument("partial_fit expects " + std::to_string(expected) + " columns.");
+        }
+    }
+
+    /** @brief Merges the moments of a disjoint set of rows into @p a. */
+    static void merge_moments(Moments& a, const Moments& b) {
+        if (b.n == 0) return;
+        if (a.n == 0) {
+            a = b;
+            return;
+        }
+        double n = static_cast<double>(a.n + b.n);
+        double weight_b = static_cast<double>(b.n) / n;
+        double cross = static_cast<double>(a.n) * weight_b;
+        for (size_t c = 0; c < a.mean.size(); ++c) {
+            double delta = b.mean[c] - a.mean[c];
+            a.mean[c] += delta * weight_b;
+            a.m2[c] += b.m2[c] + delta * delta * cross;
+        }
+        a.n += b.n;
+    }
+
+    /**
+     * @brief Computes the moments of X in one parallel pass.
+     * * Welford's update runs over each block of rows and the blocks are combined
+     * with merge_moments().
+     */
+    static Moments moments_of(const Matrix<double>& X) {
+        size_t cols = X.cols();
+        Moments initial{0, std::vector<double>(cols, 0.0), std::vector<double>(cols, 0.0)};
+        auto blocks = reduce_row_blocks(X, initial, [](Moments& m, const double* row, size_t n_cols) {
+            double inv_n = 1.0 / static_cast<double>(++m.n);
+            for (size_t c = 0; c < n_cols; ++c) {
+                double delta = row[c] - m.mean[c];
+                m.mean[c] += delta * inv_n;
+                m.m2[c] += delta * (row[c] - m.mean[c]);
+            }
+        });
+        Moments result;
+        for (const auto& block : blocks) merge_moments(result, block);
+        return result;
+    }
+
+public:
+    /** @brief Virtual destructor to ensure proper cleanup of derived classes. */
+    virtual ~Transformer() = default;
+
+    /**
+     * @brief Computes the transformation parameters from X, discarding earlier statistics.
+     * @param X Feature matrix of shape (n_samples, n_features).
+     */
+    virtual void fit(const Matrix<double>& X) = 0;
+
+    /**
+     * @brief Updates the transformation parameters with a batch of samples.
+     * @param X A batch with the same number of columns as earlier batches.
+     */
+    virtual void partial_fit(const Matrix<double>& X) = 0;
+
+    /** @brief Returns the transformed copy of X. */
+    virtual Matrix<double> transform(const Matrix<double>& X) const = 0;
+
+    /** @brief Transforms X in place, without allocating a second matrix. */
+    virtual void transform_inplace(Matrix<double>& X) const = 0;
+
+    /** @brief Maps transformed values back to the original feature space. */
+    virtual Matrix<double> inverse_transform(const Matrix<double>& X) const = 0;
+
+    /** @brief Returns true once the transformer has been fitted. */
+    virtual bool get_is_fitted() const = 0;
+
+    /**
+     * @brief Rewrites a linear head applied after this transform as one applied before it.
+     * * If the transform is affine, z = T(x), (W, b) is replaced by (W', b') with
+     * x W' + b' == T(x) W + b for every row x. This is how a Pipeline folds
+     * scaling into a linear model. Other transforms return false and leave the
+     * head unchanged.
+     * @param W Head weights, one row per output feature of the transform.
+     * @param b Head bias, one value per column of W.
+     * @return True if the head was folded.
+     */
+    virtual bool fold_into(Matrix<double>& W, std::vector<double>& b) const {
+        (void)W;
+        (void)b;
+        return false;
+    }
+
+    /** @brief Fits the transformer to X and returns X transformed. */
+    Matrix<double> fit_transform(const Matrix<double>& X) {
+        fit(X);
+        return transform(X);
+    }
+
+    /** @brief Fits the transformer to X and transforms X in place. */
+    void fit_transform_inplace(Matrix<double>& X) {
+        fit(X);
+        transform_inplace(X);
+    }
+};
+
+/**
+ * @class ColumnScaler
+ * @brief A transformer that maps each column independently with z = (x - center) * scale + offset.
+ * * Derived classes collect statistics and call set_parameters(); the
+ * transforms themselves walk the row-major buffer in order, in parallel over
+ * blocks of rows, multiplying by the reciprocal of each column's spread so the
+ * contiguous inner loop is a vectorizable subtract, multiply and add.
+ */
+class ColumnScaler : public Transformer {
+protected:
+    std::vector<double> center;
+    std::vector<double> scale;     // 1 / spread
+    std::vector<double> unscale;   // spread
+    std::vector<double> offset;
+    bool is_fitted = false;
+
+    /**
+     * @brief Sets the per-column map; a spread of 0 is replaced by 1 so constant columns only shift.
+     * @param centers Value subtracted from each column.
+     * @param spreads Value each centered column is divided by.
+     * @param offsets Value added after scaling (empty means 0).
+     */
+    void set_parameters(std::vector<double> centers, std::vector<double> spreads, std::vector<double> offsets = {}) {
+        size_t cols = centers.size();
+        center = std::move(centers);
+        unscale = std::move(spreads);
+        offset = offsets.empty() ? std::vector<double>(cols, 0.0) : std::move(offsets);
+        scale.resize(cols);
+        for (size_t c = 0; c < cols; ++c) {
+            if (unscale[c] == 0) unscale[c] = 1.0; // Prevent division by zero
+            scale[c] = 1.0 / unscale[c];
+        }
+        is_fitted = true;
+    }
+
+    /** @brief Forgets the fitted parameters. */
+    void reset_parameters() {
+        center.clear();
+        scale.clear();
+        unscale.clear();
+        offset.clear();
+        is_fitted = false;
+    }
+
+    /** @brief Throws unless the scaler is fitted and X has the fitted number of columns. */
+    void check_columns(const Matrix<double>& X) const {
+        if (!is_fitted) throw std::runtime_error("Scaler must be fitted first.");
+        if (X.cols() != center.size()) {
+            throw std::invalid_argument("Scaler was fitted on " + std::to_string(center.size()) + " columns.");
+        }
+    }
+
+    /**
+     * @brief Runs f(in_row, out_row, cols) over every row, in parallel over blocks of rows.
+     * * @p in and @p out may alias, which is how the in-place transforms work.
+     */
+    template <typename F>
+    void for_each_row(const double* in, double* out, size_t rows, F f) const {
+        size_t cols = center.size();
+        Parallel::parallel_blocks(0, rows, [&](size_t lo, size_t hi, size_t) {
+            for (size_t r = lo; r < hi; ++r) f(in + r * cols, out + r * cols, cols);
+        }, 0, MIN_ROWS_PER_THREAD);
+    }
+
+    /** @brief Writes (x - center) * scale + offset for every element of rows [0, rows). */
+    void apply(const double* in, double* out, size_t rows) const {
+        const double* shift = center.data();
+        const double* mul = scale.data();
+        const double* add = offset.data();
+        for_each_row(in, out, rows, [shift, mul, add](const double* x, double* z, size_t cols) {
+            for (size_t c = 0; c < cols; ++c) z[c] = (x[c] - shift[c]) * mul[c] + add[c];
+        });
+    }
+
+public:
+    bool get_is_fitted() const override { return is_fitted; }
+
+    /**
+     * @brief Applies the fitted per-column map to X.
+     * @throws std::runtime_error If the scaler is not fitted.
+     * @throws std::invalid_argument If X does not have as many columns as the fitted data.
+     */
+    Matrix<double> transform(const Matrix<double>& X) const override {
+        check_columns(X);
+        Matrix<double> result(X.rows(), X.cols());
+        apply(X.data_ptr(), result.data_ptr(), X.rows());
+        return result;
+    }
+
+    /**
+     * @brief Applies the fitted per-column map to X in place.
+     * @throws std::runtime_error If the scaler is not fitted.
+     * @throws std::invalid_argument If X does not have as many columns as the fitted data.
+     */
+    void transform_inplace(Matrix<double>& X) const override {
+        check_columns(X);
+        apply(X.data_ptr(), X.data_ptr(), X.rows());
+    }
+
+    /**
+     * @brief Maps scaled values back to the original scale (x = (z - offset) * spread + center).
+     * @throws std::runtime_error If the scaler is not fitted.
+     * @throws std::invalid_argument If X does not have as many columns as the fitted data.
+     */
+    Matrix<double> inverse_transform(const Matrix<double>& X) const override {
+        check_columns(X);
+        Matrix<double> result(X.rows(), X.cols());
+        const double* shift = center.data();
+        const double* mul = unscale.data();
+        const double* add = offset.data();
+        for_each_row(X.data_ptr(), result.data_ptr(), X.rows(), [shift, mul, add](const double* z, double* x, size_t cols) {
+            for (size_t c = 0; c < cols; ++c) x[c] = (z[c] - add[c]) * mul[c] + shift[c];
+        });
+        return result;
+    }
+
+    /** @brief Folds the head through the map: w'_j = w_j * scale_j, b' = b + sum_j (offset_j - center_j * scale_j) w_j. */
+    bool fold_into(Matrix<double>& W, std::vector<double>& b) const override {
+        if (!is_fitted || W.rows() != center.size() || b.size() != W.cols()) return false;
+        for (size_t j = 0; j < W.rows(); ++j) {
+            double shift = offset[j] - center[j] * scale[j];
+            for (size_t c = 0; c < W.cols(); ++c) {
+                b[c] += shift * W(j, c);
+                W(j, c) *= scale[j];
+            }
+        }
+        return true;
+    }
+};
+
 /**
  * @class StandardScaler
  * @brief Standardizes features by removing the mean and scaling to unit variance.
  * * The standard score of a sample @f$ x @f$ is calculated as:
  * $$z = \frac{(x - u)}{s}$$
  * where @f$ u @f$ is the mean of the training samples and @f$ s @f$ is the standard deviation.
+ * * The moments are computed in a single pass over the row-major data: every
+ * thread runs Welford's update over a block of rows, and the per-block
+ * (count, mean, M2) triples are combined with Chan's parallel formula. The
+ * same merge folds each partial_fit batch into the running moments, so a
+ * scaler can be fitted on a stream of batches without holding the data.
  */
-class StandardScaler {
+class StandardScaler : public ColumnScaler {
 private:
-    std::vector<double> means;
-    std::vector<double> std_devs;
-    bool is_fitted = false;
+    Moments running;
 
 public:
-    std::vector<double> get_means() { return means; }
+    std::vector<double> get_means() const { return center; }
 
-    std::vector<double> get_std_devs() { return std_devs; }
+    std::vector<double> get_std_devs() const { return unscale; }
 
-    bool get_is_fitted() { return is_fitted; }
+    size_t get_n_samples_seen() const { return running.n; }
 
     /**
      * @brief Computes the mean and standard deviation for each column in the matrix.
-     * * @param X The input Matrix used to compute scaling parameters.
+     * * Any previously accumulated statistics are discarded.
+     * @param X The input Matrix used to compute scaling parameters.
      * @note If a column has zero variance (standard deviation of 0), it is scaled by 1.0 to avoid division by zero.
      */
-    void fit(const Matrix<double>& X) {
-        size_t rows = X.rows(); //
-        size_t cols = X.cols(); //
-        means.assign(cols, 0.0);
-        std_devs.assign(cols, 0.0);
+    void fit(const Matrix<double>& X) override {
+        running = Moments();
+        reset_parameters();
+        partial_fit(X);
+    }
+
+    /**
+     * @brief Updates the running mean and standard deviation with a batch of rows.
+     * * The batch's moments are computed in parallel and merged into the running
+     * moments, so fitting on consecutive batches gives the same result as one
+     * fit on their concatenation (up to rounding).
+     * @param X A batch of samples, with the same number of columns as earlier batches.
+     * @throws std::invalid_argument If the number of columns differs from earlier batches.
+     */
+    void partial_fit(const Matrix<double>& X) override {
+        check_batch(X, running.n > 0 ? running.mean.size() : 0);
+        size_t cols = X.cols();
+
+        merge_moments(running, moments_of(X));
+        if (running.n == 0) return;
+
+        std::vector<double> std_devs(cols);
+        for (size_t c = 0; c < cols; ++c) std_devs[c] = std::sqrt(running.m2[c] / static_cast<double>(running.n));
+        set_parameters(running.mean, std::move(std_devs));
+    }
+};
+
+/**
+ * @class MinMaxScaler
+ * @brief Scales each feature linearly so the training minimum and maximum map to a target range.
+ * * $$z = \frac{x - \min}{\max - \min} (b - a) + a$$
+ * Constant columns map to @f$ a @f$. NaN values are ignored by fit.
+ */
+class MinMaxScaler : public ColumnScaler {
+private:
+    double range_min, range_max;
+    std::vector<double> data_min, data_max;
+    size_t n_samples_seen = 0;
+
+public:
+    /**
+     * @brief Constructs the scaler.
+     * @param feature_min Lower end a of the target range.
+     * @param feature_max Upper end b of the target range.
+     * @throws std::invalid_argument If feature_min is not below feature_max.
+     */
+    explicit MinMaxScaler(double feature_min = 0.0, double feature_max = 1.0)
+        : range_min(feature_min), range_max(feature_max) {
+        if (!(feature_min < feature_max)) throw std::invalid_argument("feature_min must be less than feature_max.");
+    }
+
+    std::vector<double> get_data_min() const { return data_min; }
+
+    std::vector<double> get_data_max() const { return data_max; }
+
+    size_t get_n_samples_seen() const { return n_samples_seen; }
+
+    /** @brief Computes the minimum and maximum of each column, discarding earlier statistics. */
+    void fit(const Matrix<double>& X) override {
+        data_min.clear();
+        data_max.clear();
+        n_samples_seen = 0;
+        reset_parameters();
+        partial_fit(X);
+    }
+
+    /**
+     * @brief Widens the running minimum and maximum with a batch of rows.
+     * @throws std::invalid_argument If the number of columns differs from earlier batches.
+     */
+    void partial_fit(const Matrix<double>& X) override {
+        check_batch(X, n_samples_seen > 0 ? data_min.size() : 0);
+        size_t cols = X.cols();
+        if (X.rows() == 0) return;
+        if (n_samples_seen == 0) {
+            data_min.assign(cols, std::numeric_limits<double>::infinity());
+            data_max.assign(cols, -std::numeric_limits<double>::infinity());
+        }
+
+        using Extrema = std::pair<std::vector<double>, std::vector<double>>;
+        Extrema initial(data_min, data_max);
+        auto blocks = reduce_row_blocks(X, initial, [](Extrema& e, const double* row, size_t n_cols) {
+            for (size_t c = 0; c < n_cols; ++c) {
+                if (row[c] < e.first[c]) e.first[c] = row[c];
+                if (row[c] > e.second[c]) e.second[c] = row[c];
+            }
+        });
+        for (const auto& block : blocks) {
+            for (size_t c = 0; c < cols; ++c) {
+                data_min[c] = std::min(data_min[c], block.first[c]);
+                data_max[c] = std::max(data_max[c], block.second[c]);
+            }
+        }
+        n_samples_seen += X.rows();
 
-        // Calculate Mean
+        // z = (x - min) * (b - a) / (max - min) + a
+        std::vector<double> spreads(cols);
         for (size_t c = 0; c < cols; ++c) {
-            double sum = 0.0;
-            for (size_t r = 0; r < rows; ++r) {
-                sum += X(r, c); //
+            double range = data_max[c] - data_min[c];
+            spreads[c] = std::isfinite(range) && range > 0 ? range / (range_max - range_min) : 0.0;
+        }
+        std::vector<double> centers = data_min;
+        for (double& v : centers) {
+            if (!std::isfinite(v)) v = 0.0; // All-NaN column
+        }
+        set_parameters(std::move(centers), std::move(spreads), std::vector<double>(cols, range_min));
+    }
+};
+
+/**
+ * @class MaxAbsScaler
+ * @brief Scales each feature by its maximum absolute value, mapping it into [-1, 1].
+ * * Values are not shifted, so zeros stay zero. NaN values are ignored by fit.
+ */
+class MaxAbsScaler : public ColumnScaler {
+private:
+    std::vector<double> max_abs;
+    size_t n_samples_seen = 0;
+
+public:
+    std::vector<double> get_max_abs() const { return max_abs; }
+
+    size_t get_n_samples_seen() const { return n_samples_seen; }
+
+    /** @brief Computes the maximum absolute value of each column, discarding earlier statistics. */
+    void fit(const Matrix<double>& X) override {
+        max_abs.clear();
+        n_samples_seen = 0;
+        reset_parameters();
+        partial_fit(X);
+    }
+
+    /**
+     * @brief Updates the running maximum absolute values with a batch of rows.
+     * @throws std::invalid_argument If the number of columns differs from earlier batches.
+     */
+    void partial_fit(const Matrix<double>& X) override {
+        check_batch(X, n_samples_seen > 0 ? max_abs.size() : 0);
+        size_t cols = X.cols();
+        if (X.rows() == 0) return;
+        if (n_samples_seen == 0) max_abs.assign(cols, 0.0);
+
+        auto blocks = reduce_row_blocks(X, max_abs, [](std::vector<double>& m, const double* row, size_t n_cols) {
+            for (size_t c = 0; c < n_cols; ++c) {
+                double a = std::fabs(row[c]);
+                if (a > m[c]) m[c] = a;
             }
-            means[c] = sum / rows;
+        });
+        for (const auto& block : blocks) {
+            for (size_t c = 0; c < cols; ++c) max_abs[c] = std::max(max_abs[c], block[c]);
+        }
+        n_samples_seen += X.rows();
+        set_parameters(std::vector<double>(cols, 0.0), max_abs);
+    }
+};
+
+/**
+ * @class RobustScaler
+ * @brief Centers features on the median and scales them by an interquantile range.
+ * * $$z = \frac{x - \mathrm{median}}{q_{hi} - q_{lo}}$$
+ * which is insensitive to outliers in heavy-tailed features. Instead of
+ * sorting every column, each column is summarised by a KLLSketch: every thread
+ * sketches a block of rows, and the block sketches are merged into the running
+ * ones, so fit is one parallel pass, partial_fit just merges more sketches, and
+ * memory is O(k) per column. The quantiles are therefore approximate, with a
+ * rank error of roughly 1.65 / k. NaN values are ignored by fit.
+ */
+class RobustScaler : public ColumnScaler {
+private:
+    double q_lo, q_hi;
+    bool with_centering, with_scaling;
+    size_t k;
+    std::vector<KLLSketch> sketches;
+    size_t n_samples_seen = 0;
+
+public:
+    /**
+     * @brief Constructs the scaler.
+     * @param quantile_lo Lower quantile of the range, in percent.
+     * @param quantile_hi Upper quantile of the range, in percent.
+     * @param centering Whether to subtract the median.
+     * @param scaling Whether to divide by the interquantile range.
+     * @param sketch_k Accuracy parameter of the per-column KLL sketches.
+     * @throws std::invalid_argument If the quantile range is not within [0, 100] and increasing.
+     */
+    explicit RobustScaler(double quantile_lo = 25.0, double quantile_hi = 75.0, bool centering = true,
+                          bool scaling = true, size_t sketch_k = 200)
+        : q_lo(quantile_lo), q_hi(quantile_hi), with_centering(centering), with_scaling(scaling), k(sketch_k) {
+        if (!(0.0 <= quantile_lo && quantile_lo < quantile_hi && quantile_hi <= 100.0)) {
+            throw std::invalid_argument("Invalid quantile range.");
         }
+        KLLSketch check(sketch_k); // Validates k
+    }
+
+    /** @brief Returns the (approximate) median of each column. */
+    std::vector<double> get_centers() const { return center; }
 
-        // Calculate Standard Deviation
+    /** @brief Returns the (approximate) interquantile range of each column. */
+    std::vector<double> get_scales() const { return unscale; }
+
+    size_t get_n_samples_seen() const { return n_samples_seen; }
+
+    /** @brief Sketches each column, discarding earlier statistics. */
+    void fit(const Matrix<double>& X) override {
+        sketches.clear();
+        n_samples_seen = 0;
+        reset_parameters();
+        partial_fit(X);
+    }
+
+    /**
+     * @brief Merges the quantile sketches of a batch of rows into the running sketches.
+     * @throws std::invalid_argument If the number of columns differs from earlier batches.
+     */
+    void partial_fit(const Matrix<double>& X) override {
+        check_batch(X, sketches.size());
+        size_t cols = X.cols();
+        if (X.rows() == 0) return;
+        if (sketches.empty()) sketches.assign(cols, KLLSketch(k));
+
+        auto blocks = reduce_row_blocks(X, std::vector<KLLSketch>(cols, KLLSketch(k)),
+                                        [](std::vector<KLLSketch>& s, const double* row, size_t n_cols) {
+            for (size_t c = 0; c < n_cols; ++c) s[c].update(row[c]);
+        });
+        Parallel::parallel_for(0, cols, [&](size_t c) {
+            for (const auto& block : blocks) sketches[c].merge(block[c]);
+        });
+        n_samples_seen += X.rows();
+
+        std::vector<double> centers(cols, 0.0), spreads(cols, 1.0);
         for (size_t c = 0; c < cols; ++c) {
-            double variance_sum = 0.0;
-            for (size_t r = 0; r < rows; ++r) {
-                double diff = X(r, c) - means[c];
-                variance_sum += diff * diff;
+            if (sketches[c].empty()) continue;
+            if (with_centering) centers[c] = sketches[c].quantile(0.5);
+            if (with_scaling) spreads[c] = sketches[c].quantile(q_hi / 100.0) - sketches[c].quantile(q_lo / 100.0);
+        }
+        set_parameters(std::move(centers), std::move(spreads));
+    }
+};
+
+/**
+ * @class PCA
+ * @brief Principal component analysis: projects centered data onto its directions of largest variance.
+ * * Two solvers compute the components in one fit:
+ * - "full" accumulates the centered scatter matrix X_c^T X_c with one blocked
+ *   GEMM and takes its symmetric eigendecomposition. Exact, but O(n d^2 + d^3).
+ * - "randomized" (Halko, Martinsson and Tropp) multiplies X_c by a Gaussian
+ *   test matrix of k + oversamples columns, sharpens the captured range with
+ *   power iterations (re-orthonormalized each time) and solves a small
+ *   (k + oversamples)-sized problem. Every pass over the data is a blocked
+ *   GEMM, so the cost is O(n d k) per pass.
+ * "auto" picks randomized when the data has more than 500 rows or columns and
+ * k is below 80% of the smaller dimension. The mean is never subtracted in a
+ * copy of X: the kernels center panels of rows as they pack them.
+ * * partial_fit implements incremental PCA (Ross et al.; the same update as
+ * scikit-learn's IncrementalPCA): the current components scaled by their
+ * singular values, the centered batch and a mean-correction row are stacked
+ * and decomposed again, so memory stays O((k + batch) d).
+ * * transform is a single GEMM (X - mean) W^T with the mean folded into the
+ * kernel. Component signs are fixed so the largest-magnitude loading of each
+ * component is positive, which makes the result independent of the solver.
+ */
+class PCA : public Transformer {
+private:
+    size_t n_components;
+    std::string solver;
+    size_t n_oversamples;
+    size_t n_power_iterations;
+    uint64_t seed;
+
+    Moments running;
+    Matrix<double> components{0, 0};    // k x d, one component per row
+    Matrix<double> components_t{0, 0};  // d x k, the transform operand
+    std::vector<double> singular_values;
+    std::vector<double> explained_variance;
+    std::vector<double> explained_variance_ratio;
+    bool is_fitted = false;
+
+    /** @brief Throws unless PCA can extract n_components from X. */
+    void check_shape(const Matrix<double>& X, size_t rows) const {
+        if (n_components > X.cols() || n_components > rows) {
+            throw std::invalid_argument("n_components must be at most min(n_samples, n_features).");
+        }
+    }
+
+    /**
+     * @brief Keeps the leading n_components directions and derives the reported statistics.
+     * @param scatter Eigenvalues of the centered scatter matrix (squared singular values), decreasing.
+     * @param directions Unit directions, one per row, matching @p scatter.
+     */
+    void set_components(const std::vector<double>& scatter, const Matrix<double>& directions) {
+        size_t k = n_components, d = directions.cols();
+        double dof = running.n > 1 ? static_cast<double>(running.n - 1) : 1.0;
+        double total = 0.0;
+        for (double m2 : running.m2) total += m2;
+        total /= dof;
+
+        components = Matrix<double>(k, d);
+        components_t = Matrix<double>(d, k);
+        singular_values.assign(k, 0.0);
+        explained_variance.assign(k, 0.0);
+        explained_variance_ratio.assign(k, 0.0);
+        for (size_t i = 0; i < k; ++i) {
+            const double* v = directions.data_ptr() + i * d;
+            size_t largest = 0;
+            for (size_t j = 1; j < d; ++j) {
+                if (std::fabs(v[j]) > std::fabs(v[largest])) largest = j;
+            }
+            double sign = v[largest] < 0 ? -1.0 : 1.0;
+            for (size_t j = 0; j < d; ++j) {
+                components(i, j) = sign * v[j];
+                components_t(j, i) = sign * v[j];
             }
-            std_devs[c] = std::sqrt(variance_sum / rows);
-            if (std_devs[c] == 0) std_devs[c] = 1.0; // Prevent division by zero
+            double s2 = std::max(scatter[i], 0.0);
+            singular_values[i] = std::sqrt(s2);
+            explained_variance[i] = s2 / dof;
+            explained_variance_ratio[i] = total > 0 ? explained_variance[i] / total : 0.0;
         }
         is_fitted = true;
     }
 
     /**
-     * @brief Performs standardization by centering and scaling the input matrix.
-     * * Uses the parameters computed during the @c fit() call.
-     * @param X The Matrix to be transformed.
-     * @return Matrix<double> The transformed (scaled) matrix.
-     * @throws std::runtime_error If transform is called before the scaler is fitted.
+     * @brief Leading right singular vectors of a short, wide matrix M (r x d, r <= d).
+     * * Decomposes the r x r Gram matrix M M^T = U S^2 U^T and recovers the
+     * directions as rows of S^-1 U^T M.
+     * @return The squared singular values and the directions, one per row.
      */
-    Matrix<double> transform(const Matrix<double>& X) const {
-        if (!is_fitted) throw std::runtime_error("Scaler must be fitted first.");
-        
-        Matrix<double> result(X.rows(), X.cols()); //
-        for (size_t c = 0; c < X.cols(); ++c) {
-            for (size_t r = 0; r < X.rows(); ++r) {
-                result(r, c) = (X(r, c) - means[c]) / std_devs[c]; //
+    static std::pair<std::vector<double>, Matrix<double>> right_singular_vectors(const Matrix<double>& M, size_t k) {
+        auto [values, vectors] = Linalg::symmetric_eigen(Linalg::multiply(M, M.transpose()));
+        Matrix<double> leading(k, M.rows());
+        for (size_t i = 0; i < k; ++i) {
+            double s = std::sqrt(std::max(values[i], 0.0));
+            double inv = s > 0 ? 1.0 / s : 0.0;
+            for (size_t j = 0; j < M.rows(); ++j) leading(i, j) = vectors(i, j) * inv;
+        }
+        values.resize(k);
+        return {values, Linalg::multiply(leading, M)};
+    }
+
+    /** @brief Exact solver: eigendecomposition of the centered scatter matrix. */
+    void fit_full(const Matrix<double>& X) {
+        auto [values, vectors] = Linalg::symmetric_eigen(Linalg::multiply_tn(X, X, running.mean, running.mean));
+        set_components(values, vectors);
+    }
+
+    /** @brief Randomized range finder followed by a small exact decomposition. */
+    void fit_randomized(const Matrix<double>& X) {
+        size_t d = X.cols();
+        size_t l = std::min(n_components + n_oversamples, std::min(X.rows(), d));
+        const std::vector<double>& mean = running.mean;
+
+        Matrix<double> omega(d, l);
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        double* w = omega.data_ptr();
+        for (size_t i = 0; i < d * l; ++i) w[i] = normal(rng);
+
+        // Q spans the range of X_c Omega; each power iteration applies X_c X_c^T again
+        Matrix<double> Q = Linalg::orthonormalize(Linalg::multiply(X, omega, mean));
+        for (size_t it = 0; it < n_power_iterations; ++it) {
+            Matrix<double> Z = Linalg::orthonormalize(Linalg::multiply_tn(X, Q, mean));
+            Q = Linalg::orthonormalize(Linalg::multiply(X, Z, mean));
+        }
+
+        // B = Q^T X_c is l x d; its right singular vectors approximate those of X_c
+        Matrix<double> B = Linalg::multiply_tn(X, Q, mean).transpose();
+        auto [values, directions] = right_singular_vectors(B, n_components);
+        set_components(values, directions);
+    }
+
+public:
+    /**
+     * @brief Constructs the transformer.
+     * @param k Number of components to keep.
+     * @param svd_solver "auto", "full" or "randomized".
+     * @param oversamples Extra random directions used by the randomized solver.
+     * @param power_iterations Power iterations used by the randomized solver.
+     * @param random_state Seed of the randomized solver's test matrix.
+     * @throws std::invalid_argument If k is 0 or the solver is unknown.
+     */
+    explicit PCA(size_t k, std::string svd_solver = "auto", size_t oversamples = 10, size_t power_iterations = 4,
+                 uint64_t random_state = 42)
+        : n_components(k), solver(std::move(svd_solver)), n_oversamples(oversamples),
+          n_power_iterations(power_iterations), seed(random_state) {
+        if (k == 0) throw std::invalid_argument("n_components must be positive.");
+        if (solver != "auto" && solver != "full" && solver != "randomized") {
+            throw std::invalid_argument("Unknown svd_solver: " + solver);
+        }
+    }
+
+    bool get_is_fitted() const override { return is_fitted; }
+
+    size_t get_n_components() const { return n_components; }
+
+    size_t get_n_samples_seen() const { return running.n; }
+
+    /** @brief Returns the principal axes, one unit-length component per row (k x d). */
+    Matrix<double> get_components() const { return components; }
+
+    std::vector<double> get_mean() const { return running.mean; }
+
+    std::vector<double> get_singular_values() const { return singular_values; }
+
+    /** @brief Returns the variance of the data along each component. */
+    std::vector<double> get_explained_variance() const { return explained_variance; }
+
+    /** @brief Returns the fraction of the total variance explained by each component. */
+    std::vector<double> get_explained_variance_ratio() const { return explained_variance_ratio; }
+
+    /**
+     * @brief Computes the principal components of X, discarding earlier statistics.
+     * @throws std::invalid_argument If n_components exceeds the number of rows or columns of X.
+     */
+    void fit(const Matrix<double>& X) override {
+        check_shape(X, X.rows());
+        running = moments_of(X);
+        size_t n = X.rows(), d = X.cols();
+        bool randomized = solver == "randomized"
+            || (solver == "auto" && std::max(n, d) > 500 && n_components * 5 < std::min(n, d) * 4);
+        if (randomized) {
+            fit_randomized(X);
+        } else {
+            fit_full(X);
+        }
+    }
+
+    /**
+     * @brief Updates the components with a batch of rows (incremental PCA).
+     * * With r = k + batch + 1 stacked rows, the update decomposes the r x r
+     * Gram matrix when r <= d and the d x d scatter matrix otherwise, so a batch
+     * is never copied when it is taller than it is wide.
+     * @throws std::invalid_argument If the number of columns differs from earlier batches,
+     *         or the first batch has fewer than n_components rows or columns.
+     */
+    void partial_fit(const Matrix<double>& X) override {
+        check_batch(X, running.n > 0 ? running.mean.size() : 0);
+        if (X.rows() == 0) return;
+        if (running.n == 0) check_shape(X, X.rows());
+
+        Moments batch = moments_of(X);
+        size_t d = X.cols(), nb = X.rows();
+        bool first = running.n == 0;
+        size_t k = first ? 0 : n_components;
+        size_t r = k + nb + (first ? 0 : 1);
+
+        // Stacked rows: diag(S) W, X_b - mean_b and sqrt(n_a n_b / n) (mean_a - mean_b)
+        std::vector<double> correction(d, 0.0);
+        if (!first) {
+            double weight = std::sqrt(static_cast<double>(running.n) * static_cast<double>(nb)
+                                      / static_cast<double>(running.n + nb));
+            for (size_t j = 0; j < d; ++j) correction[j] = weight * (running.mean[j] - batch.mean[j]);
+        }
+
+        std::pair<std::vector<double>, Matrix<double>> result{{}, Matrix<double>(0, 0)};
+        if (r <= d) {
+            Matrix<double> M(r, d);
+            for (size_t i = 0; i < k; ++i) {
+                for (size_t j = 0; j < d; ++j) M(i, j) = singular_values[i] * components(i, j);
+            }
+            const double* x = X.data_ptr();
+            for (size_t i = 0; i < nb; ++i) {
+                for (size_t j = 0; j < d; ++j) M(k + i, j) = x[i * d + j] - batch.mean[j];
+            }
+            if (!first) {
+                for (size_t j = 0; j < d; ++j) M(r - 1, j) = correction[j];
+            }
+            result = right_singular_vectors(M, n_components);
+        } else {
+            Matrix<double> S = Linalg::multiply_tn(X, X, batch.mean, batch.mean);
+            for (size_t i = 0; i < k; ++i) {
+                double s2 = singular_values[i] * singular_values[i];
+                for (size_t a = 0; a < d; ++a) {
+                    double va = s2 * components(i, a);
+                    for (size_t b = 0; b < d; ++b) S(a, b) += va * components(i, b);
+                }
+            }
+            for (size_t a = 0; a < d; ++a) {
+                for (size_t b = 0; b < d; ++b) S(a, b) += correction[a] * correction[b];
+            }
+            result = Linalg::symmetric_eigen(S);
+        }
+
+        merge_moments(running, batch);
+        set_components(result.first, result.second);
+    }
+
+    /**
+     * @brief Projects X onto the components: (X - mean) W^T, as one GEMM.
+     * @throws std::runtime_error If PCA is not fitted.
+     * @throws std::invalid_argument If X does not have as many columns as the fitted data.
+     */
+    Matrix<double> transform(const Matrix<double>& X) const override {
+        if (!is_fitted) throw std::runtime_error("PCA must be fitted first.");
+        if (X.cols() != running.mean.size()) {
+            throw std::invalid_argument("PCA was fitted on " + std::to_string(running.mean.size()) + " columns.");
+        }
+        return Linalg::multiply(X, components_t, running.mean);
+    }
+
+    /**
+     * @brief Replaces X with its projection.
+     * * The projection has n_components columns rather than d, so the buffer of X
+     * is swapped for that of the result instead of being overwritten.
+     */
+    void transform_inplace(Matrix<double>& X) const override { X = transform(X); }
+
+    /** @brief Folds the head through the projection: W' = C^T W, b' = b - mean W'. */
+    bool fold_into(Matrix<double>& W, std::vector<double>& b) const override {
+        if (!is_fitted || W.rows() != n_components || b.size() != W.cols()) return false;
+        W = Linalg::multiply(components_t, W);
+        for (size_t j = 0; j < W.rows(); ++j) {
+            for (size_t c = 0; c < W.cols(); ++c) b[c] -= running.mean[j] * W(j, c);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Maps projected values back to the original space: Z W + mean.
+     * @throws std::runtime_error If PCA is not fitted.
+     * @throws std::invalid_argument If Z does not have n_components columns.
+     */
+    Matrix<double> inverse_transform(const Matrix<double>& Z) const override {
+        if (!is_fitted) throw std::runtime_error("PCA must be fitted first.");
+        if (Z.cols() != n_components) {
+            throw std::invalid_argument("Expected " + std::to_string(n_components) + " columns.");
+        }
+        Matrix<double> result = Linalg::multiply(Z, components);
+        size_t d = result.cols();
+        double* out = result.data_ptr();
+        const double* mean = running.mean.data();
+        Parallel::parallel_blocks(0, result.rows(), [&](size_t lo, size_t hi, size_t) {
+            for (size_t r = lo; r < hi; ++r) {
+                for (size_t j = 0; j < d; ++j) out[r * d + j] += mean[j];
+            }
+        }, 0, MIN_ROWS_PER_THREAD);
+        return result;
+    }
+};
+
+/**
+ * @struct PolynomialTerms
+ * @brief The monomials of a polynomial expansion, in scikit-learn's column order.
+ * * The output holds an optional bias column, the inputs themselves, and then
+ * the products of degree 2, 3, ... in lexicographic order. Each product is a
+ * lower-degree output column times one input, so a row is expanded with one
+ * multiplication per output column.
+ */
+struct PolynomialTerms {
+    size_t n_inputs = 0;
+    size_t n_outputs = 0;
+    size_t first_product = 0;       // Output column of the first degree >= 2 term
+    std::vector<size_t> parent;     // For product term t: output column it extends
+    std::vector<size_t> factor;     // For product term t: input column it multiplies by
+
+    /** @brief Upper bound on the number of output columns. */
+    static constexpr size_t MAX_OUTPUTS = size_t(1) << 31;
+
+    /**
+     * @brief Enumerates the terms for n input columns.
+     * @throws std::invalid_argument If the expansion would have more than MAX_OUTPUTS columns.
+     */
+    PolynomialTerms(size_t n, size_t degree, bool interaction_only, bool include_bias) : n_inputs(n) {
+        first_product = (include_bias ? 1 : 0) + n;
+        n_outputs = first_product;
+
+        // (output column, last input index) of every term of the previous degree
+        std::vector<std::pair<size_t, size_t>> previous(n);
+        for (size_t j = 0; j < n; ++j) previous[j] = {first_product - n + j, j};
+        for (size_t d = 2; d <= degree && !previous.empty(); ++d) {
+            std::vector<std::pair<size_t, size_t>> current;
+            for (const auto& [column, last] : previous) {
+                for (size_t j = interaction_only ? last + 1 : last; j < n; ++j) {
+                    if (n_outputs >= MAX_OUTPUTS) throw std::invalid_argument("Too many polynomial features.");
+                    parent.push_back(column);
+                    factor.push_back(j);
+                    current.push_back({n_outputs++, j});
+                }
+            }
+            previous = std::move(current);
+        }
+    }
+
+    /** @brief Writes the n_outputs expanded values of input row x to out. */
+    void expand(const double* x, double* out) const {
+        double* linear = out + first_product - n_inputs;
+        if (linear != out) out[0] = 1.0;
+        std::copy_n(x, n_inputs, linear);
+        const size_t* p = parent.data();
+        const size_t* f = factor.data();
+        for (size_t t = 0; t < parent.size(); ++t) out[first_product + t] = out[p[t]] * x[f[t]];
+    }
+};
+
+/**
+ * @class PolynomialExpansion
+ * @brief A read-only view of the polynomial expansion of a Matrix, expanded on demand.
+ * * The expanded matrix is never stored: every product expands a small batch of
+ * rows into a per-thread buffer that stays in cache, multiplies it and moves
+ * on. It provides the rows() / cols() / operator* / transpose_multiply()
+ * surface that the linear models' gradient descent uses, so they can be
+ * trained on the expansion with memory proportional to the input.
+ * The view refers to the source matrix, which must outlive it.
+ */
+class PolynomialExpansion {
+private:
+    const Matrix<double>* source;
+    PolynomialTerms terms;
+
+    /** @brief Minimum number of rows handed to one thread. */
+    static constexpr size_t MIN_ROWS_PER_THREAD = 1024;
+
+    /** @brief Rows expanded together, so a batch is roughly 256 KiB. */
+    size_t batch_rows() const { return std::max<size_t>(1, 32768 / std::max<size_t>(terms.n_outputs, 1)); }
+
+public:
+    PolynomialExpansion(const Matrix<double>& X, PolynomialTerms expansion_terms)
+        : source(&X), terms(std::move(expansion_terms)) {
+        if (X.cols() != terms.n_inputs) {
+            throw std::invalid_argument("Expansion expects " + std::to_string(terms.n_inputs) + " columns.");
+        }
+    }
+
+    size_t rows() const { return source->rows(); }
+
+    size_t cols() const { return terms.n_outputs; }
+
+    /** @brief Returns the expanded matrix (rows x cols). */
+    Matrix<double> to_dense() const {
+        size_t width = terms.n_outputs, d = terms.n_inputs;
+        Matrix<double> result(rows(), width);
+        const double* in = source->data_ptr();
+        double* out = result.data_ptr();
+        Parallel::parallel_blocks(0, rows(), [&](size_t lo, size_t hi, size_t) {
+            for (size_t r = lo; r < hi; ++r) terms.expand(in + r * d, out + r * width);
+        }, 0, MIN_ROWS_PER_THREAD);
+        return result;
+    }
+
+    /**
+     * @brief Computes expand(X) * W one batch of rows at a time.
+     * @throws std::invalid_argument If W does not have cols() rows.
+     */
+    Matrix<double> operator*(const Matrix<double>& W) const {
+        size_t width = terms.n_outputs, d = terms.n_inputs, k = W.cols();
+        if (W.rows() != width) throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        Matrix<double> result(rows(), k);
+        const double* in = source->data_ptr();
+        double* out = result.data_ptr();
+        size_t batch = batch_rows();
+        Parallel::parallel_blocks(0, rows(), [&](size_t lo, size_t hi, size_t) {
+            std::vector<double> buffer(batch * width);
+            for (size_t r0 = lo; r0 < hi; r0 += batch) {
+                size_t count = std::min(hi, r0 + batch) - r0;
+                for (size_t i = 0; i < count; ++i) terms.expand(in + (r0 + i) * d, buffer.data() + i * width);
+                Linalg::gemm_block(buffer.data(), width, W.data_ptr(), k, out + r0 * k, k, count, width, k);
+            }
+        }, 0, MIN_ROWS_PER_THREAD);
+        return result;
+    }
+
+    /**
+     * @brief Computes expand(X)^T * E one batch of rows at a time.
+     * * Each thread accumulates into a private (cols x k) buffer; the buffers
+     * are summed at the end.
+     * @throws std::invalid_argument If E does not have rows() rows.
+     */
+    Matrix<double> transpose_multiply(const Matrix<double>& E) const {
+        size_t width = terms.n_outputs, d = terms.n_inputs, k = E.cols(), n = rows();
+        if (E.rows() != n) throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        size_t blocks = std::max<size_t>(1, std::min(Parallel::resolve_threads(0), n / MIN_ROWS_PER_THREAD));
+        std::vector<std::vector<double>> partial(blocks);
+        const double* in = source->data_ptr();
+        const double* e = E.data_ptr();
+        Parallel::parallel_for(0, blocks, [&](size_t t) {
+            std::vector<double>& acc = partial[t];
+            acc.assign(width * k, 0.0);
+            std::vector<double> expanded(width);
+            for (size_t r = n * t / blocks; r < n * (t + 1) / blocks; ++r) {
+                terms.expand(in + r * d, expanded.data());
+                const double* er = e + r * k;
+                if (k == 1) {
+                    double scale = er[0];
+                    for (size_t o = 0; o < width; ++o) acc[o] += expanded[o] * scale;
+                    continue;
+                }
+                for (size_t o = 0; o < width; ++o) {
+                    double v = expanded[o];
+                    double* row = acc.data() + o * k;
+                    for (size_t j = 0; j < k; ++j) row[j] += v * er[j];
+                }
             }
+        }, blocks);
+
+        Matrix<double> result(width, k);
+        double* out = result.data_ptr();
+        Parallel::parallel_blocks(0, width * k, [&](size_t lo, size_t hi, size_t) {
+            for (const auto& acc : partial) {
+                for (size_t i = lo; i < hi; ++i) out[i] += acc[i];
+            }
+        }, 0, 1 << 16);
+        return result;
+    }
+};
+
+/**
+ * @class PolynomialFeatures
+ * @brief Generates polynomial and interaction features up to a given degree.
+ * * For inputs [a, b] and degree 2 the output is [1, a, b, a^2, ab, b^2]
+ * (or [1, a, b, ab] with interaction_only). transform writes every expanded
+ * row straight into one pre-sized matrix in a single parallel pass. For
+ * training, expand() returns a PolynomialExpansion instead, which the linear
+ * models consume batch by batch so the expanded matrix never exists in full.
+ */
+class PolynomialFeatures : public Transformer {
+private:
+    size_t degree;
+    bool interaction_only;
+    bool include_bias;
+    PolynomialTerms terms{0, 1, false, false};
+    size_t n_samples_seen = 0;
+    bool is_fitted = false;
+
+    /** @brief Throws unless fitted and X has the fitted number of columns. */
+    void check_columns(const Matrix<double>& X) const {
+        if (!is_fitted) throw std::runtime_error("PolynomialFeatures must be fitted first.");
+        if (X.cols() != terms.n_inputs) {
+            throw std::invalid_argument("PolynomialFeatures was fitted on " + std::to_string(terms.n_inputs) + " columns.");
+        }
+    }
+
+public:
+    /**
+     * @brief Constructs the transformer.
+     * @param max_degree Highest total degree of the generated products.
+     * @param interactions_only Only keep products of distinct features (no powers).
+     * @param bias Whether to include a leading column of ones.
+     * @throws std::invalid_argument If max_degree is 0.
+     */
+    explicit PolynomialFeatures(size_t max_degree = 2, bool interactions_only = false, bool bias = true)
+        : degree(max_degree), interaction_only(interactions_only), include_bias(bias) {
+        if (max_degree == 0) throw std::invalid_argument("degree must be at least 1.");
+    }
+
+    bool get_is_fitted() const override { return is_fitted; }
+
+    size_t get_n_samples_seen() const { return n_samples_seen; }
+
+    size_t get_n_input_features() const { return terms.n_inputs; }
+
+    size_t get_n_output_features() const { return terms.n_outputs; }
+
+    /** @brief Returns the exponent of each input (column) in each output feature (row). */
+    Matrix<double> get_powers() const {
+        Matrix<double> powers(terms.n_outputs, terms.n_inputs);
+        size_t linear = terms.first_product - terms.n_inputs;
+        for (size_t j = 0; j < terms.n_inputs; ++j) powers(linear + j, j) = 1.0;
+        for (size_t t = 0; t < terms.parent.size(); ++t) {
+            size_t row = terms.first_product + t;
+            for (size_t j = 0; j < terms.n_inputs; ++j) powers(row, j) = powers(terms.parent[t], j);
+            powers(row, terms.factor[t]) += 1.0;
         }
+        return powers;
+    }
+
+    /** @brief Records the number of input features, discarding earlier state. */
+    void fit(const Matrix<double>& X) override {
+        is_fitted = false;
+        n_samples_seen = 0;
+        partial_fit(X);
+    }
+
+    /**
+     * @brief Records the number of input features on the first batch.
+     * @throws std::invalid_argument If the number of columns differs from earlier batches.
+     */
+    void partial_fit(const Matrix<double>& X) override {
+        check_batch(X, is_fitted ? terms.n_inputs : 0);
+        if (!is_fitted) {
+            terms = PolynomialTerms(X.cols(), degree, interaction_only, include_bias);
+            is_fitted = true;
+        }
+        n_samples_seen += X.rows();
+    }
+
+    /**
+     * @brief Returns the expanded features, written row by row into a pre-sized matrix.
+     * @throws std::runtime_error If the transformer is not fitted.
+     * @throws std::invalid_argument If X does not have the fitted number of columns.
+     */
+    Matrix<double> transform(const Matrix<double>& X) const override { return expand(X).to_dense(); }
+
+    /** @brief Replaces X with its expansion (which has more columns, so the buffer is swapped). */
+    void transform_inplace(Matrix<double>& X) const override { X = transform(X); }
+
+    /**
+     * @brief Recovers the original features from the degree-1 columns of an expansion.
+     * @throws std::invalid_argument If Z does not have get_n_output_features() columns.
+     */
+    Matrix<double> inverse_transform(const Matrix<double>& Z) const override {
+        if (!is_fitted) throw std::runtime_error("PolynomialFeatures must be fitted first.");
+        if (Z.cols() != terms.n_outputs) {
+            throw std::invalid_argument("Expected " + std::to_string(terms.n_outputs) + " columns.");
+        }
+        size_t d = terms.n_inputs, width = terms.n_outputs;
+        const double* linear = Z.data_ptr() + terms.first_product - d;
+        Matrix<double> result(Z.rows(), d);
+        for (size_t r = 0; r < Z.rows(); ++r) std::copy_n(linear + r * width, d, result.data_ptr() + r * d);
         return result;
     }
+
+    /**
+     * @brief Returns a lazy view of the expansion of X, for training without materializing it.
+     * @throws std::runtime_error If the transformer is not fitted.
+     * @throws std::invalid_argument If X does not have the fitted number of columns.
+     */
+    PolynomialExpansion expand(const Matrix<double>& X) const {
+        check_columns(X);
+        return PolynomialExpansion(X, terms);
+    }
 };
 
-#endif // PREPROCESSING_H
\ No newline at end of file
+#endif // PREPROCESSING_H
@@ -0,0 +1,534 @@
+/**
+ * @file Sketches.h
+ * @brief Mergeable streaming sketches for approximate quantiles and distinct counts.
+ * * Sketches summarise a column in bounded memory and can be merged, so a large
+ * column can be split across threads or chunks and the partial sketches combined.
+ * Both sketches serialise to a compact byte string (host byte order).
+ */
+
+// include/daedalus/core/Sketches.h
+
+#ifndef SKETCHES_H
+#define SKETCHES_H
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include "Matrix.h"
+#include "Column.h"
+#include "Hash.h"
+#include "Parallel.h"
+
+/**
+ * @namespace SketchIO
+ * @brief Helpers that append/read plain values to/from a byte string.
+ */
+namespace SketchIO {
+    /** @brief Appends the raw bytes of a trivially copyable value. */
+    template <typename T>
+    void write(std::string& out, const T& value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /**
+     * @brief Reads a trivially copyable value and advances the offset.
+     * @throws std::invalid_argument If the buffer is too short.
+     */
+    template <typename T>
+    T read(const std::string& in, size_t& offset) {
+        if (offset + sizeof(T) > in.size()) throw std::invalid_argument("Sketch buffer is truncated.");
+        T value;
+        std::memcpy(&value, in.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+}
+
+/**
+ * @class KLLSketch
+ * @brief KLL quantile sketch (Karnin, Lang, Liberty 2016).
+ * * Items are kept in a hierarchy of compactors. When a level overflows it is
+ * sorted and every other item (random offset) is promoted to the next level
+ * with twice the weight. Level capacities shrink geometrically (factor 2/3)
+ * from the top, so memory is O(k) and the rank error is roughly 1.65 / k.
+ */
+class KLLSketch {
+    size_t k;
+    uint64_t n = 0;
+    double min_value = std::numeric_limits<double>::infinity();
+    double max_value = -std::numeric_limits<double>::infinity();
+    uint64_t rng_state = 0x853c49e6748fea9bULL;
+    std::vector<std::vector<double>> levels;
+    size_t num_retained = 0;
+    size_t max_retained = 0;
+
+    /** @brief Returns the capacity of a level given the current number of levels. */
+    size_t level_capacity(size_t level) const {
+        size_t depth = levels.size() - level - 1;
+        double cap = std::ceil(static_cast<double>(k) * std::pow(2.0 / 3.0, static_cast<double>(depth)));
+        return std::max<size_t>(2, static_cast<size_t>(cap));
+    }
+
+    /** @brief Returns one pseudo-random bit (xorshift64). */
+    size_t random_bit() {
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 7;
+        rng_state ^= rng_state << 17;
+        return static_cast<size_t>(rng_state & 1);
+    }
+
+    /** @brief Recomputes the cached item counts after the levels changed shape. */
+    void refresh_counts() {
+        num_retained = 0;
+        for (const auto& level : levels) num_retained += level.size();
+        max_retained = 0;
+        for (size_t h = 0; h < levels.size(); ++h) max_retained += level_capacity(h);
+    }
+
+    /** @brief Compacts levels until the sketch is back under its total capacity. */
+    void compress_to_capacity() {
+        while (num_retained >= max_retained) {
+            compress();
+            refresh_counts();
+        }
+    }
+
+    /** @brief Compacts the lowest level that is at or above its capacity. */
+    void compress() {
+        for (size_t h = 0; h < levels.size(); ++h) {
+            if (levels[h].size() < level_capacity(h)) continue;
+            if (h + 1 == levels.size()) levels.emplace_back();
+
+            std::vector<double>& level = levels[h];
+            std::vector<double>& next = levels[h + 1];
+            std::sort(level.begin(), level.end());
+
+            // An odd item out stays behind so that total weight is preserved
+            bool odd = (level.size() % 2) == 1;
+            double leftover = odd ? level.back() : 0.0;
+            if (odd) level.pop_back();
+
+            for (size_t i = random_bit(); i < level.size(); i += 2) next.push_back(level[i]);
+            level.clear();
+            if (odd) level.push_back(leftover);
+            return;
+        }
+    }
+
+public:
+    /**
+     * @brief Constructs an empty sketch.
+     * @param k Accuracy parameter; larger values use more memory and are more accurate.
+     * @throws std::invalid_argument If k is smaller than 8.
+     */
+    explicit KLLSketch(size_t k = 200) : k(k), levels(1) {
+        if (k < 8) throw std::invalid_argument("KLLSketch k must be at least 8.");
+        refresh_counts();
+    }
+
+    /** @brief Returns the accuracy parameter k. */
+    size_t get_k() const { return k; }
+
+    /** @brief Returns the number of values added to the sketch. */
+    uint64_t count() const { return n; }
+
+    /** @brief Returns true if no value has been added. */
+    bool empty() const { return n == 0; }
+
+    /** @brief Returns the exact minimum of the added values. */
+    double min() const { return n == 0 ? std::nan("") : min_value; }
+
+    /** @brief Returns the exact maximum of the added values. */
+    double max() const { return n == 0 ? std::nan("") : max_value; }
+
+    /**
+     * @brief Adds a value to the sketch. NaN values are ignored.
+     * @param value The value to add.
+     */
+    void update(double value) {
+        if (std::isnan(value)) return;
+        levels[0].push_back(value);
+        ++n;
+        if (value < min_value) min_value = value;
+        if (value > max_value) max_value = value;
+        if (++num_retained >= max_retained) compress_to_capacity();
+    }
+
+    /**
+     * @brief Merges another sketch into this one.
+     * @param other A sketch built with the same k.
+     * @throws std::invalid_argument If the sketches use a different k.
+     */
+    void merge(const KLLSketch& other) {
+        if (other.k != k) throw std::invalid_argument("Cannot merge KLL sketches with different k.");
+        if (other.n == 0) return;
+
+        if (other.levels.size() > levels.size()) levels.resize(other.levels.size());
+        for (size_t h = 0; h < other.levels.size(); ++h) {
+            levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+        }
+        n += other.n;
+        min_value = std::min(min_value, other.min_value);
+        max_value = std::max(max_value, other.max_value);
+
+        refresh_counts();
+        compress_to_capacity();
+    }
+
+    /**
+     * @brief Returns the approximate value at quantile q.
+     * @param q The quantile in [0, 1] (0.5 is the median).
+     * @return The estimated quantile, or NaN if the sketch is empty.
+     * @throws std::invalid_argument If q is outside [0, 1].
+     */
+    double quantile(double q) const {
+        if (q < 0.0 || q > 1.0) throw std::invalid_argument("Quantile must be between 0 and 1.");
+        if (n == 0) return std::nan("");
+        if (q == 0.0) return min_value;
+        if (q == 1.0) return max_value;
+
+        std::vector<std::pair<double, uint64_t>> weighted;
+        weighted.reserve(num_retained);
+        for (size_t h = 0; h < levels.size(); ++h) {
+            uint64_t weight = uint64_t(1) << h;
+            for (double v : levels[h]) weighted.emplace_back(v, weight);
+        }
+        std::sort(weighted.begin(), weighted.end());
+
+        double target = q * static_cast<double>(n);
+        uint64_t cumulative = 0;
+        for (const auto& item : weighted) {
+            cumulative += item.second;
+            if (static_cast<double>(cumulative) >= target) return item.first;
+        }
+        return max_value;
+    }
+
+    /**
+     * @brief Returns the approximate values at several quantiles.
+     * @param qs Quantiles in [0, 1].
+     */
+    std::vector<double> quantiles(const std::vector<double>& qs) const {
+        std::vector<double> result;
+        result.reserve(qs.size());
+        for (double q : qs) result.push_back(quantile(q));
+        return result;
+    }
+
+    /**
+     * @brief Returns the approximate fraction of values less than or equal to value.
+     * @param value The value to rank.
+     */
+    double rank(double value) const {
+        if (n == 0) return std::nan("");
+        uint64_t below = 0;
+        for (size_t h = 0; h < levels.size(); ++h) {
+            for (double v : levels[h]) {
+                if (v <= value) below += uint64_t(1) << h;
+            }
+        }
+        return static_cast<double>(below) / static_cast<double>(n);
+    }
+
+    /** @brief Serialises the sketch to a byte string. */
+    std::string serialize() const {
+        std::string out;
+        out.append("KLL1", 4);
+        SketchIO::write(out, static_cast<uint64_t>(k));
+        SketchIO::write(out, n);
+        SketchIO::write(out, min_value);
+        SketchIO::write(out, max_value);
+        SketchIO::write(out, rng_state);
+        SketchIO::write(out, static_cast<uint64_t>(levels.size()));
+        for (const auto& level : levels) {
+            SketchIO::write(out, static_cast<uint64_t>(level.size()));
+            out.append(reinterpret_cast<const char*>(level.data()), level.size() * sizeof(double));
+        }
+        return out;
+    }
+
+    /**
+     * @brief Restores a sketch from a byte string produced by serialize().
+     * @throws std::invalid_argument If the buffer is not a valid KLL sketch.
+     */
+    static KLLSketch deserialize(const std::string& bytes) {
+        if (bytes.compare(0, 4, "KLL1") != 0) throw std::invalid_argument("Not a serialized KLL sketch.");
+        size_t offset = 4;
+        KLLSketch sketch(static_cast<size_t>(SketchIO::read<uint64_t>(bytes, offset)));
+        sketch.n = SketchIO::read<uint64_t>(bytes, offset);
+        sketch.min_value = SketchIO::read<double>(bytes, offset);
+        sketch.max_value = SketchIO::read<double>(bytes, offset);
+        sketch.rng_state = SketchIO::read<uint64_t>(bytes, offset);
+        uint64_t n_levels = SketchIO::read<uint64_t>(bytes, offset);
+        if (n_levels == 0 || n_levels > 64) throw std::invalid_argument("Corrupt KLL sketch.");
+        sketch.levels.assign(n_levels, {});
+        for (auto& level : sketch.levels) {
+            uint64_t size = SketchIO::read<uint64_t>(bytes, offset);
+            if (offset + size * sizeof(double) > bytes.size()) throw std::invalid_argument("Sketch buffer is truncated.");
+            level.resize(size);
+            std::memcpy(level.data(), bytes.data() + offset, size * sizeof(double));
+            offset += size * sizeof(double);
+        }
+        sketch.refresh_counts();
+        return sketch;
+    }
+};
+
+/**
+ * @class HyperLogLog
+ * @brief HyperLogLog distinct-count sketch (Flajolet et al. 2007) on 64-bit hashes.
+ * * Uses 2^p one-byte registers; the relative standard error is about 1.04 / sqrt(2^p).
+ * Linear counting is used for small cardinalities. Merging takes the register-wise maximum.
+ */
+class HyperLogLog {
+    int p;
+    std::vector<uint8_t> registers;
+
+    /** @brief Counts leading zero bits of a non-zero 64-bit value. */
+    static int leading_zeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(x);
+#else
+        int count = 0;
+        while (!(x & (uint64_t(1) << 63))) { x <<= 1; ++count; }
+        return count;
+#endif
+    }
+
+public:
+    /**
+     * @brief Constructs an empty sketch.
+     * @param precision Number of index bits p (4 to 18); uses 2^p bytes.
+     * @throws std::invalid_argument If precision is out of range.
+     */
+    explicit HyperLogLog(int precision = 14) : p(precision) {
+        if (precision < 4 || precision > 18) throw std::invalid_argument("HyperLogLog precision must be between 4 and 18.");
+        registers.assign(size_t(1) << p, 0);
+    }
+
+    /** @brief Returns the precision p. */
+    int get_precision() const { return p; }
+
+    /**
+     * @brief Adds an already hashed 64-bit value.
+     * @param hash A well mixed 64-bit hash of the item.
+     */
+    void add_hash(uint64_t hash) {
+        size_t index = static_cast<size_t>(hash >> (64 - p));
+        uint64_t w = (hash << p) | (uint64_t(1) << (p - 1));
+        uint8_t rank = static_cast<uint8_t>(leading_zeros(w) + 1);
+        if (rank > registers[index]) registers[index] = rank;
+    }
+
+    /** @brief Adds a number (ints and doubles with equal value count once). */
+    void update(double value) { add_hash(Hash::number(value)); }
+
+    /** @brief Adds a string. */
+    void update(const std::string& value) { add_hash(Hash::text(value)); }
+
+    /**
+     * @brief Merges another sketch into this one.
+     * @param other A sketch with the same precision.
+     * @throws std::invalid_argument If the precisions differ.
+     */
+    void merge(const HyperLogLog& other) {
+        if (other.p != p) throw std::invalid_argument("Cannot merge HyperLogLog sketches with different precision.");
+        for (size_t i = 0; i < registers.size(); ++i) {
+            registers[i] = std::max(registers[i], other.registers[i]);
+        }
+    }
+
+    /** @brief Returns the estimated number of distinct values. */
+    double estimate() const {
+        double m = static_cast<double>(registers.size());
+        double alpha;
+        if (registers.size() == 16) alpha = 0.673;
+        else if (registers.size() == 32) alpha = 0.697;
+        else if (registers.size() == 64) alpha = 0.709;
+        else alpha = 0.7213 / (1.0 + 1.079 / m);
+
+        double sum = 0.0;
+        size_t zeros = 0;
+        for (uint8_t r : registers) {
+            sum += std::ldexp(1.0, -static_cast<int>(r));
+            if (r == 0) ++zeros;
+        }
+
+        double raw = alpha * m * m / sum;
+        if (raw <= 2.5 * m && zeros > 0) {
+            return m * std::log(m / static_cast<double>(zeros)); // Linear counting
+        }
+        return raw;
+    }
+
+    /** @brief Serialises the sketch to a byte string. */
+    std::string serialize() const {
+        std::string out;
+        out.append("HLL1", 4);
+        SketchIO::write(out, static_cast<uint32_t>(p));
+        out.append(reinterpret_cast<const char*>(registers.data()), registers.size());
+        return out;
+    }
+
+    /**
+     * @brief Restores a sketch from a byte string produced by serialize().
+     * @throws std::invalid_argument If the buffer is not a valid HyperLogLog sketch.
+     */
+    static HyperLogLog deserialize(const std::string& bytes) {
+        if (bytes.compare(0, 4, "HLL1") != 0) throw std::invalid_argument("Not a serialized HyperLogLog sketch.");
+        size_t offset = 4;
+        HyperLogLog sketch(static_cast<int>(SketchIO::read<uint32_t>(bytes, offset)));
+        if (bytes.size() - offset != sketch.registers.size()) throw std::invalid_argument("Sketch buffer is truncated.");
+        std::memcpy(sketch.registers.data(), bytes.data() + offset, sketch.registers.size());
+        return sketch;
+    }
+};
+
+/**
+ * @namespace Sketches
+ * @brief Builds sketches over DataFrame columns and Matrix columns in one parallel pass.
+ * * Each thread sketches a contiguous block of rows and the per-thread sketches
+ * are merged at the end.
+ */
+namespace Sketches {
+    /**
+     * @brief Builds a quantile sketch of a numeric Column.
+     * * Strings in a mixed column and nulls are skipped.
+     * @param col The column to sketch.
+     * @param k The KLL accuracy parameter.
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     * @throws std::invalid_argument If the column holds only strings.
+     */
+    inline KLLSketch quantile_sketch(const Column& col, size_t k = 200, size_t num_threads = 0) {
+        if (col.type() == DType::STRING || col.type() == DType::CATEGORY) {
+            throw std::invalid_argument("Quantiles require a numeric column.");
+        }
+
+        std::vector<KLLSketch> partial(Parallel::resolve_threads(num_threads), KLLSketch(k));
+        Parallel::parallel_blocks(0, col.size(), [&](size_t lo, size_t hi, size_t block) {
+            KLLSketch& sketch = partial[block];
+            switch (col.type()) {
+                case DType::FLOAT64: for (size_t i = lo; i < hi; ++i) sketch.update(col.doubles()[i]); break;
+                case DType::MIXED:
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (col.is_null(i)) continue;
+                        const Cell& cell = col.cells()[i];
+                        if (!std::holds_alternative<std::string>(cell)) sketch.update(col.as_double(i));
+                    }
+                    break;
+                default:
+                    // as_double reports nulls as NaN, which update() ignores
+                    for (size_t i = lo; i < hi; ++i) sketch.update(col.as_double(i));
+                    break;
+            }
+        }, num_threads, 4096);
+
+        for (size_t b = 1; b < partial.size(); ++b) partial[0].merge(partial[b]);
+        return partial[0];
+    }
+
+    /**
+     * @brief Builds a distinct-count sketch of a Column of any type.
+     * @param col The column to sketch.
+     * @param precision The HyperLogLog precision p.
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     */
+    inline HyperLogLog distinct_sketch(const Column& col, int precision = 14, size_t num_threads = 0) {
+        std::vector<HyperLogLog> partial(Parallel::resolve_threads(num_threads), HyperLogLog(precision));
+        Parallel::parallel_blocks(0, col.size(), [&](size_t lo, size_t hi, size_t block) {
+            HyperLogLog& sketch = partial[block];
+            switch (col.type()) {
+                case DType::FLOAT64:
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (!col.is_null(i)) sketch.update(col.doubles()[i]);
+                    }
+                    break;
+                case DType::STRING:
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (!col.is_null(i)) sketch.update(col.strings()[i]);
+                    }
+                    break;
+                case DType::CATEGORY:
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (!col.is_null(i)) sketch.update(col.categories()[col.ints()[i]]);
+                    }
+                    break;
+                case DType::MIXED:
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (col.is_null(i)) continue;
+                        const Cell& cell = col.cells()[i];
+                        if (const auto* s = std::get_if<std::string>(&cell)) sketch.update(*s);
+                        else sketch.update(col.as_double(i));
+                    }
+                    break;
+                default:
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (!col.is_null(i)) sketch.update(col.as_double(i));
+                    }
+                    break;
+            }
+        }, num_threads, 4096);
+
+        for (size_t b = 1; b < partial.size(); ++b) partial[0].merge(partial[b]);
+        return partial[0];
+    }
+
+    /**
+     * @brief Builds one quantile sketch per Matrix column in a single row-major pass.
+     * @param X The input Matrix.
+     * @param k The KLL accuracy parameter.
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     * @return A vector with one sketch per column.
+     */
+    inline std::vector<KLLSketch> quantile_sketches(const Matrix<double>& X, size_t k = 200, size_t num_threads = 0) {
+        size_t cols = X.cols();
+        std::vector<std::vector<KLLSketch>> partial(Parallel::resolve_threads(num_threads),
+                                                    std::vector<KLLSketch>(cols, KLLSketch(k)));
+        const double* data = X.data_ptr();
+        Parallel::parallel_blocks(0, X.rows(), [&](size_t lo, size_t hi, size_t block) {
+            std::vector<KLLSketch>& sketches = partial[block];
+            for (size_t r = lo; r < hi; ++r) {
+                const double* row = data + r * cols;
+                for (size_t c = 0; c < cols; ++c) sketches[c].update(row[c]);
+            }
+        }, num_threads, 4096);
+
+        for (size_t b = 1; b < partial.size(); ++b) {
+            for (size_t c = 0; c < cols; ++c) partial[0][c].merge(partial[b][c]);
+        }
+        return partial[0];
+    }
+
+    /**
+     * @brief Builds one distinct-count sketch per Matrix column in a single row-major pass.
+     * @param X The input Matrix.
+     * @param precision The HyperLogLog precision p.
+     * @param num_threads Number of threads (0 means use all hardware threads).
+     * @return A vector with one sketch per column.
+     */
+    inline std::vector<HyperLogLog> distinct_sketches(const Matrix<double>& X, int precision = 14, size_t num_threads = 0) {
+        size_t cols = X.cols();
+        std::vector<std::vector<HyperLogLog>> partial(Parallel::resolve_threads(num_threads),
+                                                      std::vector<HyperLogLog>(cols, HyperLogLog(precision)));
+        const double* data = X.data_ptr();
+        Parallel::parallel_blocks(0, X.rows(), [&](size_t lo, size_t hi, size_t block) {
+            std::vector<HyperLogLog>& sketches = partial[block];
+            for (size_t r = lo; r < hi; ++r) {
+                const double* row = data + r * cols;
+                for (size_t c = 0; c < cols; ++c) sketches[c].update(row[c]);
+            }
+        }, num_threads, 4096);
+
+        for (size_t b = 1; b < partial.size(); ++b) {
+            for (size_t c = 0; c < cols; ++c) partial[0][c].merge(partial[b][c]);
+        }
+        return partial[0];
+    }
+}
+
+#endif // SKETCHES_H
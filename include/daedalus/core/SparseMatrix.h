@@ -0,0 +1,198 @@
+/**
+ * @file SparseMatrix.h
+ * @brief Compressed Sparse Row (CSR) matrix for high-dimensional sparse features.
+ * * Only the non-zero entries are stored: for row r, the column indices and
+ * values of its entries are indices[indptr[r] .. indptr[r + 1]) and
+ * values[indptr[r] .. indptr[r + 1]). The products needed by linear models
+ * (X * w and X^T * e) run in parallel without ever densifying X.
+ */
+
+// include/daedalus/core/SparseMatrix.h
+
+#ifndef SPARSEMATRIX_H
+#define SPARSEMATRIX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "Matrix.h"
+#include "Parallel.h"
+
+/**
+ * @class SparseMatrix
+ * @brief A matrix stored in Compressed Sparse Row format.
+ * @tparam T The numeric type of the stored values.
+ */
+template <typename T>
+class SparseMatrix {
+    size_t num_rows = 0, num_cols = 0;
+    std::vector<size_t> row_ptr;
+    std::vector<uint32_t> col_idx;
+    std::vector<T> vals;
+
+    /** @brief Minimum number of rows handed to one thread by the parallel products. */
+    static constexpr size_t MIN_ROWS_PER_THREAD = 4096;
+
+public:
+    /** @brief Constructs an empty 0 x 0 matrix. */
+    SparseMatrix() : row_ptr(1, 0) {}
+
+    /** @brief Constructs an all-zero r x c matrix. */
+    SparseMatrix(size_t r, size_t c) : num_rows(r), num_cols(c), row_ptr(r + 1, 0) {
+        if (c > std::numeric_limits<uint32_t>::max()) throw std::invalid_argument("SparseMatrix supports at most 2^32 - 1 columns.");
+    }
+
+    /**
+     * @brief Constructs a matrix from CSR arrays.
+     * @param r Number of rows.
+     * @param c Number of columns.
+     * @param indptr Row offsets (r + 1 non-decreasing values starting at 0).
+     * @param indices Column index of every stored entry.
+     * @param values Value of every stored entry.
+     * @throws std::invalid_argument If the arrays are inconsistent or an index is out of range.
+     */
+    SparseMatrix(size_t r, size_t c, std::vector<size_t> indptr, std::vector<uint32_t> indices, std::vector<T> values)
+        : num_rows(r), num_cols(c), row_ptr(std::move(indptr)), col_idx(std::move(indices)), vals(std::move(values)) {
+        if (c > std::numeric_limits<uint32_t>::max()) throw std::invalid_argument("SparseMatrix supports at most 2^32 - 1 columns.");
+        if (row_ptr.size() != r + 1 || row_ptr[0] != 0 || row_ptr[r] != col_idx.size() || col_idx.size() != vals.size()) {
+            throw std::invalid_argument("CSR arrays do not match the matrix dimensions.");
+        }
+        for (size_t i = 0; i < r; ++i) {
+            if (row_ptr[i] > row_ptr[i + 1]) throw std::invalid_argument("CSR row offsets must be non-decreasing.");
+        }
+        for (uint32_t j : col_idx) {
+            if (j >= c) throw std::invalid_argument("CSR column index out of bounds.");
+        }
+    }
+
+    /**
+     * @brief Builds a sparse matrix from the non-zero entries of a dense one.
+     */
+    static SparseMatrix from_dense(const Matrix<T>& dense) {
+        SparseMatrix result(dense.rows(), dense.cols());
+        const T* p = dense.data_ptr();
+        for (size_t r = 0; r < dense.rows(); ++r) {
+            for (size_t c = 0; c < dense.cols(); ++c) {
+                T v = p[r * dense.cols() + c];
+                if (v != T(0)) {
+                    result.col_idx.push_back(static_cast<uint32_t>(c));
+                    result.vals.push_back(v);
+                }
+            }
+            result.row_ptr[r + 1] = result.col_idx.size();
+        }
+        return result;
+    }
+
+    /** @brief Returns the dense equivalent (zeros where no entry is stored). */
+    Matrix<T> to_dense() const {
+        Matrix<T> result(num_rows, num_cols);
+        T* out = result.data_ptr();
+        for (size_t r = 0; r < num_rows; ++r) {
+            for (size_t k = row_ptr[r]; k < row_ptr[r + 1]; ++k) out[r * num_cols + col_idx[k]] += vals[k];
+        }
+        return result;
+    }
+
+    /** @brief Returns the number of rows. */
+    size_t rows() const { return num_rows; }
+
+    /** @brief Returns the number of columns. */
+    size_t cols() const { return num_cols; }
+
+    /** @brief Returns the number of stored entries. */
+    size_t nnz() const { return vals.size(); }
+
+    /** @brief Returns the row offsets (rows() + 1 values). */
+    const std::vector<size_t>& indptr() const { return row_ptr; }
+
+    /** @brief Returns the column index of every stored entry. */
+    const std::vector<uint32_t>& indices() const { return col_idx; }
+
+    /** @brief Returns the value of every stored entry. */
+    const std::vector<T>& values() const { return vals; }
+
+    /**
+     * @brief Returns the rows at the given positions, in that order (rows may repeat).
+     * @throws std::out_of_range If a position is out of bounds.
+     */
+    SparseMatrix take_rows(const std::vector<size_t>& positions) const {
+        SparseMatrix result(positions.size(), num_cols);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            if (positions[i] >= num_rows) throw std::out_of_range("Row index out of bounds.");
+            result.row_ptr[i + 1] = result.row_ptr[i] + (row_ptr[positions[i] + 1] - row_ptr[positions[i]]);
+        }
+        result.col_idx.resize(result.row_ptr.back());
+        result.vals.resize(result.row_ptr.back());
+        Parallel::parallel_for(0, positions.size(), [&](size_t i) {
+            size_t lo = row_ptr[positions[i]], n = row_ptr[positions[i] + 1] - lo;
+            std::copy_n(col_idx.begin() + static_cast<std::ptrdiff_t>(lo), n, result.col_idx.begin() + static_cast<std::ptrdiff_t>(result.row_ptr[i]));
+            std::copy_n(vals.begin() + static_cast<std::ptrdiff_t>(lo), n, result.vals.begin() + static_cast<std::ptrdiff_t>(result.row_ptr[i]));
+        }, 0, MIN_ROWS_PER_THREAD);
+        return result;
+    }
+
+    /**
+     * @brief Sparse-dense product X * B, computed in parallel over rows of X.
+     * @throws std::invalid_argument If the inner dimensions do not match.
+     */
+    Matrix<T> operator*(const Matrix<T>& dense) const {
+        if (num_cols != dense.rows()) throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        size_t k = dense.cols();
+        Matrix<T> result(num_rows, k);
+        const T* b = dense.data_ptr();
+        T* out = result.data_ptr();
+        Parallel::parallel_blocks(0, num_rows, [&](size_t lo, size_t hi, size_t) {
+            for (size_t r = lo; r < hi; ++r) {
+                T* row = out + r * k;
+                for (size_t e = row_ptr[r]; e < row_ptr[r + 1]; ++e) {
+                    const T* brow = b + static_cast<size_t>(col_idx[e]) * k;
+                    T v = vals[e];
+                    for (size_t j = 0; j < k; ++j) row[j] += v * brow[j];
+                }
+            }
+        }, 0, MIN_ROWS_PER_THREAD);
+        return result;
+    }
+
+    /**
+     * @brief Returns X^T in CSR form (equivalently, X in CSC form).
+     * * A counting sort over the column indices: O(nnz + cols) time and memory,
+     * with the entries of every output row in increasing order of X's row.
+     * @throws std::invalid_argument If X has more than 2^32 - 1 rows.
+     */
+    SparseMatrix transpose() const {
+        SparseMatrix result(num_cols, num_rows);
+        for (uint32_t j : col_idx) ++result.row_ptr[static_cast<size_t>(j) + 1];
+        for (size_t c = 0; c < num_cols; ++c) result.row_ptr[c + 1] += result.row_ptr[c];
+        result.col_idx.resize(vals.size());
+        result.vals.resize(vals.size());
+        std::vector<size_t> next(result.row_ptr.begin(), result.row_ptr.end() - 1);
+        for (size_t r = 0; r < num_rows; ++r) {
+            for (size_t e = row_ptr[r]; e < row_ptr[r + 1]; ++e) {
+                size_t pos = next[col_idx[e]]++;
+                result.col_idx[pos] = static_cast<uint32_t>(r);
+                result.vals[pos] = vals[e];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes X^T * B.
+     * * Builds the transpose and multiplies it, so each thread owns a slice of
+     * the output rows and no dense (cols x k) scratch space is allocated.
+     * Callers that multiply by X^T repeatedly (gradient descent) should build
+     * transpose() once and reuse it.
+     * @throws std::invalid_argument If X and B do not have the same number of rows.
+     */
+    Matrix<T> transpose_multiply(const Matrix<T>& dense) const {
+        if (num_rows != dense.rows()) throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        return transpose() * dense;
+    }
+};
+
+#endif // SPARSEMATRIX_H
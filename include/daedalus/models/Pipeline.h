@@ -0,0 +1,88 @@
+/**
+ * @file Pipeline.h
+ * @brief A chain of transformers followed by a model, predicted in a single pass.
+ */
+
+// include/daedalus/models/Pipeline.h
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <memory>
+#include <vector>
+#include "Model.h"
+#include "linearRegression.h"
+#include "logisticRegression.h"
+#include "../core/Preprocessing.h"
+
+/**
+ * @class Pipeline
+ * @brief Applies a sequence of transformers and then a model, as one Model.
+ * * fit() fits every stage in order on the output of the previous one and
+ * then fits the model. When every transformer is affine (the scalers and
+ * PCA) and the model is a LinearRegression or LogisticRegression, the
+ * transforms are folded into the model's weights at fit time:
+ * $$T_1(\dots T_n(x)) w + b = x w' + b'$$
+ * so predict() is a single GEMM over the input with no intermediate matrices.
+ * Otherwise predict() runs the stages one block of rows at a time, so each
+ * intermediate is a small buffer that stays in cache instead of a full matrix.
+ * * The stages are shared, not copied: fitting the pipeline fits them. Call
+ * fuse() again after refitting a stage outside the pipeline.
+ */
+class Pipeline : public Model<double> {
+private:
+    std::vector<std::shared_ptr<Transformer>> steps;
+    std::shared_ptr<Model<double>> model;
+
+    bool fused = false;
+    bool logistic = false;
+    Matrix<double> fused_weights;
+    double fused_bias = 0.0;
+
+    /** @brief Rows pushed through the stages together when they are not fused. */
+    static constexpr size_t BLOCK_ROWS = 1024;
+
+    /** @brief Returns X W' + b' for the fused head (the logit for logistic models). */
+    Matrix<double> fused_scores(const Matrix<double>& X) const;
+
+    /** @brief Runs the stages over each block of rows and collects the model's output. */
+    Matrix<double> predict_blocks(const Matrix<double>& X, bool proba) const;
+
+public:
+    /**
+     * @brief Constructs a pipeline.
+     * @param transformers Stages applied in order; may be empty.
+     * @param estimator The model applied to the output of the last stage.
+     * @throws std::invalid_argument If a stage or the model is null.
+     */
+    Pipeline(std::vector<std::shared_ptr<Transformer>> transformers, std::shared_ptr<Model<double>> estimator);
+
+    /** @brief Fits every stage in order, then the model, then folds them where possible. */
+    void fit(const Matrix<double>& X, const Matrix<double>& y) override;
+
+    /** @brief Predicts through every stage; a single pass over X when the pipeline is fused. */
+    Matrix<double> predict(const Matrix<double>& X) const override;
+
+    /**
+     * @brief Returns the positive-class probability of a LogisticRegression pipeline.
+     * @throws std::logic_error If the model is not a LogisticRegression.
+     */
+    Matrix<double> predict_proba(const Matrix<double>& X) const;
+
+    /**
+     * @brief Folds the fitted stages into the model's weights, if they are all affine.
+     * @return True if predict() now runs as a single pass.
+     */
+    bool fuse();
+
+    /** @brief Returns true if the stages are folded into the model's weights. */
+    bool get_is_fused() const { return fused; }
+
+    /** @brief Returns the folded weights (one row per input feature); empty unless fused. */
+    const Matrix<double>& get_fused_weights() const { return fused_weights; }
+
+    /** @brief Returns the folded intercept; 0 unless fused. */
+    double get_fused_bias() const { return fused_bias; }
+};
+
+#endif // PIPELINE_H
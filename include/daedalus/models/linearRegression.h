@@ -11,6 +11,8 @@
 #include <string>
 #include <fstream>
 #include "Model.h"
+#include "../core/SparseMatrix.h"
+#include "../core/Preprocessing.h"
 
 /**
  * @class LinearRegression
@@ -25,6 +27,10 @@ class LinearRegression : public Model<double> {
     double reg_lambda;
     std::string penalty; // "l1", "l2", or "none"
 
+    /** @brief Runs gradient descent on dense, sparse or polynomial features (see FeatureProducts.h). */
+    template <typename Features>
+    void gradient_descent(const Features& X, const Matrix<double>& y, int epochs);
+
 public:
     /**
      * @brief Constructs a Linear Regression object.
@@ -46,9 +52,38 @@ class LinearRegression : public Model<double> {
      */
     void fit(const Matrix<double>& X, const Matrix<double>& y, int epochs);
 
+    /**
+     * @brief Fits the model on sparse (CSR) features without densifying them.
+     * @param X Training features.
+     * @param y Training targets.
+     * @param epochs Number of times to iterate over the training set.
+     */
+    void fit(const SparseMatrix<double>& X, const Matrix<double>& y, int epochs = 100);
+
+    /**
+     * @brief Fits the model on a polynomial expansion that is generated batch by batch.
+     * * The expanded matrix is never materialized; see PolynomialFeatures::expand().
+     * @param X Lazily expanded training features.
+     * @param y Training targets.
+     * @param epochs Number of times to iterate over the training set.
+     */
+    void fit(const PolynomialExpansion& X, const Matrix<double>& y, int epochs = 100);
+
     /** @brief Predicts continuous values for the input matrix X. */
     Matrix<double> predict(const Matrix<double>& x) const override;
 
+    /** @brief Predicts continuous values for sparse (CSR) features. */
+    Matrix<double> predict(const SparseMatrix<double>& X) const;
+
+    /** @brief Predicts continuous values for lazily expanded polynomial features. */
+    Matrix<double> predict(const PolynomialExpansion& X) const;
+
+    /** @brief Returns the fitted weights, one row per feature. */
+    const Matrix<double>& get_weights() const { return weights; }
+
+    /** @brief Returns the fitted intercept. */
+    double get_bias() const { return bias.rows() > 0 ? bias(0, 0) : 0.0; }
+
     /** @brief Serializes model weights and parameters to a file. */
     void saveModel(const std::string& filename) const;
 
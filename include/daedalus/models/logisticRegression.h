@@ -11,6 +11,8 @@
 #include <string>
 #include <fstream>
 #include "Model.h"
+#include "../core/SparseMatrix.h"
+#include "../core/Preprocessing.h"
 #include "cmath"
 
 /**
@@ -26,6 +28,10 @@ class LogisticRegression : public Model<double> {
     double reg_lambda;      // Regularization strength
     std::string penalty;    // "l1", "l2", or "none"
 
+    /** @brief Runs gradient descent on dense, sparse or polynomial features (see FeatureProducts.h). */
+    template <typename Features>
+    void gradient_descent(const Features& X, const Matrix<double>& y, int epochs);
+
     /** @brief Internal helper to compute the sigmoid mapping. */
     double sigmoid(double z) const {
         return 1.0 / (1.0 + std::exp(-z));
@@ -47,6 +53,12 @@ class LogisticRegression : public Model<double> {
     /** @brief Trains the classifier for a fixed number of epochs. */
     void fit(const Matrix<double>& X, const Matrix<double>& y, int epochs);
 
+    /** @brief Trains the classifier on sparse (CSR) features without densifying them. */
+    void fit(const SparseMatrix<double>& X, const Matrix<double>& y, int epochs = 100);
+
+    /** @brief Trains the classifier on a polynomial expansion that is generated batch by batch. */
+    void fit(const PolynomialExpansion& X, const Matrix<double>& y, int epochs = 100);
+
     /** @brief Predicts binary labels (0.0 or 1.0) based on a 0.5 probability threshold. */
     Matrix<double> predict(const Matrix<double>& X) const override;
     
@@ -56,6 +68,24 @@ class LogisticRegression : public Model<double> {
      */
     Matrix<double> predict_proba(const Matrix<double>& X) const;
 
+    /** @brief Predicts binary labels for sparse (CSR) features. */
+    Matrix<double> predict(const SparseMatrix<double>& X) const;
+
+    /** @brief Returns the probability of the positive class for sparse (CSR) features. */
+    Matrix<double> predict_proba(const SparseMatrix<double>& X) const;
+
+    /** @brief Predicts binary labels for lazily expanded polynomial features. */
+    Matrix<double> predict(const PolynomialExpansion& X) const;
+
+    /** @brief Returns the probability of the positive class for lazily expanded polynomial features. */
+    Matrix<double> predict_proba(const PolynomialExpansion& X) const;
+
+    /** @brief Returns the fitted weights, one row per feature. */
+    const Matrix<double>& get_weights() const { return weights; }
+
+    /** @brief Returns the fitted intercept. */
+    double get_bias() const { return bias.rows() > 0 ? bias(0, 0) : 0.0; }
+
     /** @brief Saves model parameters to a file. */
     void saveModel(const std::string& filename) const;
 
@@ -4,11 +4,15 @@
 #include <pybind11/stl.h>
 #include <pybind11/operators.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include "daedalus/core/Matrix.h"
+#include "daedalus/core/SparseMatrix.h"
 #include "daedalus/core/Metrics.h"
 #include "daedalus/core/DataFrame.h"
 #include "daedalus/core/IO.h"
 #include "daedalus/core/Preprocessing.h"
+#include "daedalus/core/FeatureHasher.h"
+#include "daedalus/core/Sketches.h"
 #include "daedalus/core/Metrics.h"
 #include "daedalus/core/ModelSelection.h"
 #include "daedalus/models/linearRegression.h"
@@ -16,11 +20,19 @@
 #include "daedalus/models/knn.h"
 #include "daedalus/models/DenseLayer.h"
 #include "daedalus/models/NeuralNetwork.h"
+#include "daedalus/models/Pipeline.h"
 #include "daedalus/optimization/Optimization.h"
 #include "daedalus/optimization/SimplexSolver.h"
 
 namespace py = pybind11;
 
+// Converts (column, op, value) tuples into .dcol predicates
+static std::vector<Dcol::Predicate> to_predicates(const std::vector<std::tuple<std::string, std::string, double>>& filters) {
+    std::vector<Dcol::Predicate> predicates;
+    for (const auto& f : filters) predicates.push_back({std::get<0>(f), std::get<1>(f), std::get<2>(f)});
+    return predicates;
+}
+
 // Trampoline class for the abstract Model interface
 template <typename T = double>
 class PyModel : public Model<T> {
@@ -118,6 +130,8 @@ PYBIND11_MODULE(daedalus_cpp, m) {
             self(r, c) = value;
         })
         .def("to_string", &Matrix<double>::to_string)
+        .def("to_csv", &Matrix<double>::to_csv, py::arg("path"), py::arg("header") = std::vector<std::string>{},
+            py::arg("delimiter") = ',', py::arg("num_threads") = 0, py::call_guard<py::gil_scoped_release>())
         .def_property_readonly("rows", &Matrix<double>::rows)
         .def_property_readonly("cols", &Matrix<double>::cols)
         .def_static("create_filled_matrix", &Matrix<double>::create_filled_matrix, 
@@ -213,7 +227,71 @@ PYBIND11_MODULE(daedalus_cpp, m) {
             auto [Q, R] = self.QR();
             return py::make_tuple(Q, R);}
         )
-        .def("eigen", &Matrix<double>::eigen, py::arg("max_iterations"), py::arg("tol"));
+        .def("eigen", &Matrix<double>::eigen, py::arg("max_iterations"), py::arg("tol"))
+        .def("quantile_sketches", [](const Matrix<double> &self, size_t k) {
+            return Sketches::quantile_sketches(self, k);
+        }, py::arg("k") = 200, py::call_guard<py::gil_scoped_release>())
+        .def("distinct_sketches", [](const Matrix<double> &self, int precision) {
+            return Sketches::distinct_sketches(self, precision);
+        }, py::arg("precision") = 14, py::call_guard<py::gil_scoped_release>());
+
+    // --- Sketch Bindings ---
+    py::class_<KLLSketch>(m, "KLLSketch")
+        .def(py::init<size_t>(), py::arg("k") = 200)
+        .def_property_readonly("k", &KLLSketch::get_k)
+        .def("count", &KLLSketch::count)
+        .def("min", &KLLSketch::min)
+        .def("max", &KLLSketch::max)
+        .def("update", &KLLSketch::update, py::arg("value"))
+        .def("update_many", [](KLLSketch &self, const std::vector<double> &values) {
+            for (double v : values) self.update(v);
+        }, py::arg("values"))
+        .def("merge", &KLLSketch::merge, py::arg("other"))
+        .def("quantile", &KLLSketch::quantile, py::arg("q"))
+        .def("quantiles", &KLLSketch::quantiles, py::arg("qs"))
+        .def("rank", &KLLSketch::rank, py::arg("value"))
+        .def("serialize", [](const KLLSketch &self) { return py::bytes(self.serialize()); })
+        .def_static("deserialize", &KLLSketch::deserialize, py::arg("data"))
+        .def(py::pickle(
+            [](const KLLSketch &self) { return py::bytes(self.serialize()); },
+            [](py::bytes data) { return KLLSketch::deserialize(data); }));
+
+    py::class_<HyperLogLog>(m, "HyperLogLog")
+        .def(py::init<int>(), py::arg("precision") = 14)
+        .def_property_readonly("precision", &HyperLogLog::get_precision)
+        .def("update", py::overload_cast<double>(&HyperLogLog::update), py::arg("value"))
+        .def("update", py::overload_cast<const std::string&>(&HyperLogLog::update), py::arg("value"))
+        .def("merge", &HyperLogLog::merge, py::arg("other"))
+        .def("estimate", &HyperLogLog::estimate)
+        .def("serialize", [](const HyperLogLog &self) { return py::bytes(self.serialize()); })
+        .def_static("deserialize", &HyperLogLog::deserialize, py::arg("data"))
+        .def(py::pickle(
+            [](const HyperLogLog &self) { return py::bytes(self.serialize()); },
+            [](py::bytes data) { return HyperLogLog::deserialize(data); }));
+
+    // --- SparseMatrix Bindings ---
+    py::class_<SparseMatrix<double>>(m, "SparseMatrix")
+        .def(py::init<size_t, size_t>(), py::arg("rows"), py::arg("cols"))
+        .def(py::init<size_t, size_t, std::vector<size_t>, std::vector<uint32_t>, std::vector<double>>(),
+            py::arg("rows"), py::arg("cols"), py::arg("indptr"), py::arg("indices"), py::arg("values"))
+        .def_static("from_dense", &SparseMatrix<double>::from_dense, py::arg("dense"))
+        .def("to_dense", &SparseMatrix<double>::to_dense)
+        .def_property_readonly("rows", &SparseMatrix<double>::rows)
+        .def_property_readonly("cols", &SparseMatrix<double>::cols)
+        .def_property_readonly("nnz", &SparseMatrix<double>::nnz)
+        .def_property_readonly("indptr", [](const SparseMatrix<double>& self) {
+            return py::array_t<size_t>(self.indptr().size(), self.indptr().data());
+        })
+        .def_property_readonly("indices", [](const SparseMatrix<double>& self) {
+            return py::array_t<uint32_t>(self.indices().size(), self.indices().data());
+        })
+        .def_property_readonly("values", [](const SparseMatrix<double>& self) {
+            return py::array_t<double>(self.values().size(), self.values().data());
+        })
+        .def("take_rows", &SparseMatrix<double>::take_rows, py::arg("positions"), py::call_guard<py::gil_scoped_release>())
+        .def("dot", &SparseMatrix<double>::operator*, py::arg("dense"), py::call_guard<py::gil_scoped_release>())
+        .def("transpose_multiply", &SparseMatrix<double>::transpose_multiply, py::arg("dense"),
+            py::call_guard<py::gil_scoped_release>());
 
     // --- DataFrame Bindings ---
     py::class_<DataFrame>(m, "DataFrame")
@@ -242,23 +320,210 @@ PYBIND11_MODULE(daedalus_cpp, m) {
             py::arg("column_name"), 
             py::arg("val0") = "", 
             py::arg("val1") = "")
-        .def("to_matrix", &DataFrame::to_matrix, py::arg("target_columns"));
+        .def("to_matrix", &DataFrame::to_matrix, py::arg("target_columns"))
+        .def("dtype", &DataFrame::dtype, py::arg("col_name"))
+        .def("null_count", &DataFrame::null_count, py::arg("col_name"))
+        .def("quantile_sketch", &DataFrame::quantile_sketch, py::arg("col_name"), py::arg("k") = 200,
+            py::call_guard<py::gil_scoped_release>())
+        .def("distinct_sketch", &DataFrame::distinct_sketch, py::arg("col_name"), py::arg("precision") = 14,
+            py::call_guard<py::gil_scoped_release>())
+        .def("unique", &DataFrame::unique, py::arg("col_name"), py::call_guard<py::gil_scoped_release>())
+        .def("value_counts", &DataFrame::value_counts, py::arg("col_name"), py::call_guard<py::gil_scoped_release>())
+        .def("drop_duplicates", &DataFrame::drop_duplicates, py::arg("subset") = std::vector<std::string>{},
+            py::call_guard<py::gil_scoped_release>())
+        .def("append_rows", &DataFrame::append_rows, py::arg("batch"))
+        .def("to_csv", &DataFrame::to_csv, py::arg("path"), py::arg("header") = true, py::arg("delimiter") = ',',
+            py::arg("num_threads") = 0, py::call_guard<py::gil_scoped_release>())
+        .def("save", &DataFrame::save, py::arg("path"), py::arg("compression") = "lz4", py::arg("chunk_rows") = 65536,
+            py::call_guard<py::gil_scoped_release>())
+        .def_static("concat", [](const py::list& frames, int axis) {
+            // Borrow the frames; a std::vector<DataFrame> argument would copy every one of them
+            std::vector<const DataFrame*> pointers;
+            pointers.reserve(frames.size());
+            for (const auto& frame : frames) pointers.push_back(&frame.cast<const DataFrame&>());
+            py::gil_scoped_release release;
+            return DataFrame::concat(pointers, axis);
+        }, py::arg("frames"), py::arg("axis") = 0);
 
     // --- IO Bindings ---
-    m.def("read_csv", &read_csv, py::arg("filename"), py::arg("has_header") = true);
+    m.def("read_csv", &read_csv, py::arg("filename"), py::arg("has_header") = true, py::arg("num_threads") = 0,
+        py::arg("dtype") = std::unordered_map<std::string, std::string>{}, py::arg("sample_rows") = 1000,
+        py::arg("delimiter") = ',', py::arg("quote") = '"', py::arg("comment") = '\0',
+        py::arg("usecols") = std::vector<std::string>{}, py::arg("nrows") = std::nullopt, py::arg("skiprows") = 0,
+        py::arg("chunks_range") = std::nullopt,
+        py::call_guard<py::gil_scoped_release>());
+
+    // The multi-file reader behind glob patterns, with the backend selectable so both can be tested
+    m.def("read_files", [](const std::vector<std::string>& paths, size_t queue_depth, const std::string& backend) {
+        AsyncIO::Backend mode = AsyncIO::Backend::AUTO;
+        if (backend == "threads") mode = AsyncIO::Backend::THREADS;
+        else if (backend == "io_uring") mode = AsyncIO::Backend::IO_URING;
+        else if (backend != "auto") throw std::invalid_argument("Unknown backend: " + backend);
+        std::vector<AsyncIO::Buffer> buffers;
+        {
+            py::gil_scoped_release release;
+            AsyncIO::FileReader reader(paths, queue_depth, mode);
+            while (std::optional<AsyncIO::Buffer> buffer = reader.next()) buffers.push_back(std::move(*buffer));
+        }
+        py::list result;
+        for (const auto& buffer : buffers) result.append(py::bytes(buffer.data.get(), buffer.size));
+        return result;
+    }, py::arg("paths"), py::arg("queue_depth") = AsyncIO::DEFAULT_QUEUE_DEPTH, py::arg("backend") = "auto");
+
+    m.def("read_csv_matrix", &read_csv_matrix, py::arg("filename"), py::arg("columns") = std::vector<std::string>{},
+        py::arg("target_column") = "", py::arg("has_header") = true, py::arg("num_threads") = 0,
+        py::arg("delimiter") = ',', py::arg("quote") = '"', py::arg("comment") = '\0',
+        py::call_guard<py::gil_scoped_release>());
+
+    m.def("read_libsvm", &read_libsvm, py::arg("filename"), py::arg("n_features") = std::nullopt,
+        py::arg("zero_based") = std::nullopt, py::arg("num_threads") = 0, py::call_guard<py::gil_scoped_release>());
+    m.def("save_libsvm", &save_libsvm, py::arg("filename"), py::arg("X"), py::arg("y"), py::arg("zero_based") = false,
+        py::arg("num_threads") = 0, py::call_guard<py::gil_scoped_release>());
+
+    m.def("load_npy", &load_npy, py::arg("filename"), py::arg("num_threads") = 0,
+        py::call_guard<py::gil_scoped_release>());
+    m.def("save_npy", &save_npy, py::arg("filename"), py::arg("matrix"), py::call_guard<py::gil_scoped_release>());
+    m.def("load_npz", &load_npz, py::arg("filename"), py::arg("num_threads") = 0,
+        py::call_guard<py::gil_scoped_release>());
+    m.def("save_npz", &save_npz, py::arg("filename"), py::arg("arrays"), py::call_guard<py::gil_scoped_release>());
+
+    using DcolFilters = std::vector<std::tuple<std::string, std::string, double>>;
+    m.def("read_dcol", [](const std::string& filename, const std::vector<std::string>& columns,
+                          const DcolFilters& filters, size_t num_threads) {
+        std::vector<Dcol::Predicate> predicates = to_predicates(filters);
+        py::gil_scoped_release release;
+        return read_dcol(filename, columns, predicates, num_threads);
+    }, py::arg("filename"), py::arg("columns") = std::vector<std::string>{}, py::arg("filters") = DcolFilters{},
+        py::arg("num_threads") = 0);
+
+    py::class_<Dcol::File>(m, "DcolFile")
+        .def(py::init<const std::string&>(), py::arg("filename"))
+        .def_property_readonly("rows", &Dcol::File::rows)
+        .def_property_readonly("columns", &Dcol::File::column_names)
+        .def("dtype", [](const Dcol::File& self, const std::string& name) {
+            return dtype_name(self.column(name).type);
+        }, py::arg("col_name"))
+        .def("is_zero_copy", &Dcol::File::is_zero_copy, py::arg("col_name"))
+        .def("chunk_stats", [](const Dcol::File& self, const std::string& name) {
+            py::list stats;
+            for (const auto& chunk : self.column(name).chunks) {
+                py::dict entry;
+                entry["rows"] = chunk.rows;
+                entry["null_count"] = chunk.stats.null_count;
+                entry["min"] = chunk.stats.has_range ? py::cast(chunk.stats.min) : py::none();
+                entry["max"] = chunk.stats.has_range ? py::cast(chunk.stats.max) : py::none();
+                stats.append(entry);
+            }
+            return stats;
+        }, py::arg("col_name"))
+        .def("to_numpy", [](py::object self_obj, const std::string& name) {
+            // A read-only array over the mapping; the array keeps the file alive
+            const Dcol::File& self = self_obj.cast<const Dcol::File&>();
+            const void* ptr = self.values(name);
+            py::dtype dt = [&]() {
+                switch (self.column(name).type) {
+                    case DType::FLOAT64: return py::dtype::of<double>();
+                    case DType::INT64: return py::dtype::of<int64_t>();
+                    case DType::BOOL: return py::dtype::of<bool>();
+                    default: return py::dtype::of<int32_t>();
+                }
+            }();
+            py::array result(dt, {self.rows()}, {}, ptr, self_obj);
+            result.attr("setflags")(py::arg("write") = false);
+            return result;
+        }, py::arg("col_name"))
+        .def("read", [](const Dcol::File& self, const std::vector<std::string>& columns,
+                        const DcolFilters& filters, size_t num_threads) {
+            std::vector<Dcol::Predicate> predicates = to_predicates(filters);
+            py::gil_scoped_release release;
+            return read_dcol(self, columns, predicates, num_threads);
+        }, py::arg("columns") = std::vector<std::string>{}, py::arg("filters") = DcolFilters{},
+            py::arg("num_threads") = 0);
+
+    py::class_<CsvReader>(m, "CsvReader")
+        .def(py::init<const std::string&, size_t, bool, const std::unordered_map<std::string, std::string>&, size_t,
+                      char, char, char>(),
+            py::arg("filename"), py::arg("batch_rows"), py::arg("has_header") = true,
+            py::arg("dtype") = std::unordered_map<std::string, std::string>{}, py::arg("sample_rows") = 1000,
+            py::arg("delimiter") = ',', py::arg("quote") = '"', py::arg("comment") = '\0')
+        .def_property_readonly("columns", &CsvReader::columns)
+        .def("next", &CsvReader::next, py::call_guard<py::gil_scoped_release>())
+        .def("next_matrix", &CsvReader::next_matrix, py::arg("target_columns"),
+            py::call_guard<py::gil_scoped_release>());
 
     // --- Preprocessing Bindings ---
-    py::class_<StandardScaler>(m, "StandardScaler")
+    py::class_<Transformer, std::shared_ptr<Transformer>>(m, "Transformer")
+        .def("get_is_fitted", &Transformer::get_is_fitted)
+        .def("fit", &Transformer::fit, py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("partial_fit", &Transformer::partial_fit, py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("transform", &Transformer::transform, py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("transform_inplace", &Transformer::transform_inplace, py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("inverse_transform", &Transformer::inverse_transform, py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("fit_transform", &Transformer::fit_transform, py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("fit_transform_inplace", &Transformer::fit_transform_inplace, py::arg("X"),
+             py::call_guard<py::gil_scoped_release>());
+
+    py::class_<StandardScaler, Transformer, std::shared_ptr<StandardScaler>>(m, "StandardScaler")
         .def(py::init<>())
         .def("get_means", &StandardScaler::get_means)
         .def("get_std_devs", &StandardScaler::get_std_devs)
-        .def("get_is_fitted", &StandardScaler::get_is_fitted)
-        .def("fit", &StandardScaler::fit, py::arg("X"))
-        .def("transform", &StandardScaler::transform, py::arg("X"))
-        .def("fit_transform", [](StandardScaler &self, const Matrix<double> &X) {
-            self.fit(X);
-            return self.transform(X);
-        }, py::arg("X"));
+        .def("get_n_samples_seen", &StandardScaler::get_n_samples_seen);
+
+    py::class_<MinMaxScaler, Transformer, std::shared_ptr<MinMaxScaler>>(m, "MinMaxScaler")
+        .def(py::init<double, double>(), py::arg("feature_min") = 0.0, py::arg("feature_max") = 1.0)
+        .def("get_data_min", &MinMaxScaler::get_data_min)
+        .def("get_data_max", &MinMaxScaler::get_data_max)
+        .def("get_n_samples_seen", &MinMaxScaler::get_n_samples_seen);
+
+    py::class_<MaxAbsScaler, Transformer, std::shared_ptr<MaxAbsScaler>>(m, "MaxAbsScaler")
+        .def(py::init<>())
+        .def("get_max_abs", &MaxAbsScaler::get_max_abs)
+        .def("get_n_samples_seen", &MaxAbsScaler::get_n_samples_seen);
+
+    py::class_<RobustScaler, Transformer, std::shared_ptr<RobustScaler>>(m, "RobustScaler")
+        .def(py::init<double, double, bool, bool, size_t>(), py::arg("quantile_lo") = 25.0,
+             py::arg("quantile_hi") = 75.0, py::arg("with_centering") = true, py::arg("with_scaling") = true,
+             py::arg("k") = 200)
+        .def("get_centers", &RobustScaler::get_centers)
+        .def("get_scales", &RobustScaler::get_scales)
+        .def("get_n_samples_seen", &RobustScaler::get_n_samples_seen);
+
+    py::class_<PCA, Transformer, std::shared_ptr<PCA>>(m, "PCA")
+        .def(py::init<size_t, std::string, size_t, size_t, uint64_t>(), py::arg("n_components"),
+             py::arg("svd_solver") = "auto", py::arg("n_oversamples") = 10, py::arg("n_power_iterations") = 4,
+             py::arg("random_state") = 42)
+        .def("get_n_components", &PCA::get_n_components)
+        .def("get_n_samples_seen", &PCA::get_n_samples_seen)
+        .def("get_components", &PCA::get_components)
+        .def("get_mean", &PCA::get_mean)
+        .def("get_singular_values", &PCA::get_singular_values)
+        .def("get_explained_variance", &PCA::get_explained_variance)
+        .def("get_explained_variance_ratio", &PCA::get_explained_variance_ratio);
+
+    py::class_<PolynomialExpansion>(m, "PolynomialExpansion")
+        .def_property_readonly("rows", &PolynomialExpansion::rows)
+        .def_property_readonly("cols", &PolynomialExpansion::cols)
+        .def("to_dense", &PolynomialExpansion::to_dense, py::call_guard<py::gil_scoped_release>())
+        .def("dot", &PolynomialExpansion::operator*, py::arg("dense"), py::call_guard<py::gil_scoped_release>())
+        .def("transpose_multiply", &PolynomialExpansion::transpose_multiply, py::arg("dense"),
+             py::call_guard<py::gil_scoped_release>());
+
+    py::class_<PolynomialFeatures, Transformer, std::shared_ptr<PolynomialFeatures>>(m, "PolynomialFeatures")
+        .def(py::init<size_t, bool, bool>(), py::arg("degree") = 2, py::arg("interaction_only") = false,
+             py::arg("include_bias") = true)
+        .def("get_n_samples_seen", &PolynomialFeatures::get_n_samples_seen)
+        .def("get_n_input_features", &PolynomialFeatures::get_n_input_features)
+        .def("get_n_output_features", &PolynomialFeatures::get_n_output_features)
+        .def("get_powers", &PolynomialFeatures::get_powers)
+        // The view refers to X, so X must live as long as the view
+        .def("expand", &PolynomialFeatures::expand, py::arg("X"), py::keep_alive<0, 2>());
+
+    py::class_<FeatureHasher>(m, "FeatureHasher")
+        .def(py::init<size_t, bool, uint64_t>(), py::arg("n_features") = FeatureHasher::DEFAULT_FEATURES,
+             py::arg("alternate_sign") = true, py::arg("seed") = 0)
+        .def("get_n_features", &FeatureHasher::get_n_features)
+        .def("transform", &FeatureHasher::transform, py::arg("df"), py::arg("columns"),
+             py::arg("text_columns") = std::vector<std::string>{}, py::call_guard<py::gil_scoped_release>());
 
     // --- Metric Bindings ---
     m.def("mean_squared_error", &Metrics::mean_squared_error, 
@@ -273,13 +538,40 @@ PYBIND11_MODULE(daedalus_cpp, m) {
     m.def("mcc_score", &Metrics::mcc_score, py::arg("y_true"), py::arg("y_pred"));
 
     // --- Utils Bindings ---
-    m.def("train_test_split", [](const Matrix<double>& X, const Matrix<double>& y, double test_size, int seed) {
-        return train_test_split(X, y, test_size, seed);
-    }, py::arg("X"), py::arg("y"), py::arg("test_size") = 0.2, py::arg("seed") = 42,
-    "Splits features and targets into training and testing sets.");
+    m.def("train_test_split", [](const Matrix<double>& X, const Matrix<double>& y, double test_size, int seed, bool stratify) {
+        return train_test_split(X, y, test_size, seed, stratify);
+    }, py::arg("X"), py::arg("y"), py::arg("test_size") = 0.2, py::arg("seed") = 42, py::arg("stratify") = false,
+    py::call_guard<py::gil_scoped_release>(), "Splits features and targets into training and testing sets.");
+
+    py::class_<MatrixView<double>>(m, "MatrixView")
+        .def_property_readonly("rows", &MatrixView<double>::rows)
+        .def_property_readonly("cols", &MatrixView<double>::cols)
+        .def_property_readonly("indices", &MatrixView<double>::indices)
+        .def("__getitem__", [](const MatrixView<double>& self, std::pair<size_t, size_t> index) {
+            return self(index.first, index.second);
+        })
+        .def("materialize", &MatrixView<double>::materialize, py::arg("num_threads") = 0,
+             py::call_guard<py::gil_scoped_release>());
+
+    // The views refer to X and y; the Python wrappers keep them alive
+    m.def("train_test_split_views", &train_test_split_views<double>, py::arg("X"), py::arg("y"),
+          py::arg("test_size") = 0.2, py::arg("seed") = 42, py::arg("stratify") = false);
+
+    m.def("train_test_split_indices", [](size_t n, double test_size, int seed) {
+        SplitIndices split = train_test_split_indices(n, test_size, seed);
+        return std::make_pair(std::move(split.train), std::move(split.test));
+    }, py::arg("n_rows"), py::arg("test_size") = 0.2, py::arg("seed") = 42);
+
+    m.def("stratified_split_indices", [](const Matrix<double>& y, double test_size, int seed) {
+        SplitIndices split = stratified_split_indices(y, test_size, seed);
+        return std::make_pair(std::move(split.train), std::move(split.test));
+    }, py::arg("y"), py::arg("test_size") = 0.2, py::arg("seed") = 42);
+
+    m.def("take_rows", &take_rows<double>, py::arg("X"), py::arg("rows"), py::arg("num_threads") = 0,
+          py::call_guard<py::gil_scoped_release>());
 
     // --- Model Bindings ---
-    py::class_<Model<double>, PyModel<double>>(m, "Model")
+    py::class_<Model<double>, PyModel<double>, std::shared_ptr<Model<double>>>(m, "Model")
         .def(py::init<>())
         .def("fit", &Model<double>::fit, py::arg("X"), py::arg("y"),
         "Trains the model on the provided dataset.")
@@ -287,19 +579,29 @@ PYBIND11_MODULE(daedalus_cpp, m) {
          "Makes predictions using the trained model parameters.");
 
     // --- Linear Regression Bindings ---
-    py::class_<LinearRegression, Model<double>>(m, "LinearRegression")
+    py::class_<LinearRegression, Model<double>, std::shared_ptr<LinearRegression>>(m, "LinearRegression")
         .def(py::init<double, double, std::string>(), py::arg("learning_rate") = 0.01, py::arg("reg_lambda") = 0.01, 
             py::arg("penalty") = "none")
         .def("fit", py::overload_cast<const Matrix<double>&, const Matrix<double>&>(&LinearRegression::fit),
              py::arg("X"), py::arg("y"))
         .def("fit", py::overload_cast<const Matrix<double>&, const Matrix<double>&, int>(&LinearRegression::fit),
              py::arg("X"), py::arg("y"), py::arg("epochs"))
-        .def("predict", &LinearRegression::predict, py::arg("X"))
+        .def("fit", py::overload_cast<const SparseMatrix<double>&, const Matrix<double>&, int>(&LinearRegression::fit),
+             py::arg("X"), py::arg("y"), py::arg("epochs") = 100)
+        .def("fit", py::overload_cast<const PolynomialExpansion&, const Matrix<double>&, int>(&LinearRegression::fit),
+             py::arg("X"), py::arg("y"), py::arg("epochs") = 100, py::call_guard<py::gil_scoped_release>())
+        .def("predict", py::overload_cast<const Matrix<double>&>(&LinearRegression::predict, py::const_), py::arg("X"))
+        .def("predict", py::overload_cast<const SparseMatrix<double>&>(&LinearRegression::predict, py::const_),
+             py::arg("X"))
+        .def("predict", py::overload_cast<const PolynomialExpansion&>(&LinearRegression::predict, py::const_),
+             py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("get_weights", &LinearRegression::get_weights)
+        .def("get_bias", &LinearRegression::get_bias)
         .def("save_model", &LinearRegression::saveModel, py::arg("filename"))
         .def("load_model", &LinearRegression::loadModel, py::arg("filename"));
 
     // --- Logistic Regression Bindings
-    py::class_<LogisticRegression, Model<double>>(m, "LogisticRegression")
+    py::class_<LogisticRegression, Model<double>, std::shared_ptr<LogisticRegression>>(m, "LogisticRegression")
         .def(py::init<double, double, std::string>(), 
          py::arg("learning_rate") = 0.01, 
          py::arg("reg_lambda") = 0.01, 
@@ -308,19 +610,46 @@ PYBIND11_MODULE(daedalus_cpp, m) {
              py::arg("X"), py::arg("y"))
         .def("fit", py::overload_cast<const Matrix<double>&, const Matrix<double>&, int>(&LogisticRegression::fit),
              py::arg("X"), py::arg("y"), py::arg("epochs"))
-        .def("predict", &LogisticRegression::predict, py::arg("X"))
-        .def("predict_proba", &LogisticRegression::predict_proba, py::arg("X"))
+        .def("fit", py::overload_cast<const SparseMatrix<double>&, const Matrix<double>&, int>(&LogisticRegression::fit),
+             py::arg("X"), py::arg("y"), py::arg("epochs") = 100)
+        .def("fit", py::overload_cast<const PolynomialExpansion&, const Matrix<double>&, int>(&LogisticRegression::fit),
+             py::arg("X"), py::arg("y"), py::arg("epochs") = 100, py::call_guard<py::gil_scoped_release>())
+        .def("predict", py::overload_cast<const Matrix<double>&>(&LogisticRegression::predict, py::const_), py::arg("X"))
+        .def("predict", py::overload_cast<const SparseMatrix<double>&>(&LogisticRegression::predict, py::const_),
+             py::arg("X"))
+        .def("predict", py::overload_cast<const PolynomialExpansion&>(&LogisticRegression::predict, py::const_),
+             py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("predict_proba", py::overload_cast<const Matrix<double>&>(&LogisticRegression::predict_proba, py::const_),
+             py::arg("X"))
+        .def("predict_proba", py::overload_cast<const SparseMatrix<double>&>(&LogisticRegression::predict_proba, py::const_),
+             py::arg("X"))
+        .def("predict_proba", py::overload_cast<const PolynomialExpansion&>(&LogisticRegression::predict_proba, py::const_),
+             py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("get_weights", &LogisticRegression::get_weights)
+        .def("get_bias", &LogisticRegression::get_bias)
         .def("save_model", &LogisticRegression::saveModel, py::arg("filename"))
         .def("load_model", &LogisticRegression::loadModel, py::arg("filename"));
 
+    // --- Pipeline Bindings ---
+    py::class_<Pipeline, Model<double>, std::shared_ptr<Pipeline>>(m, "Pipeline")
+        .def(py::init<std::vector<std::shared_ptr<Transformer>>, std::shared_ptr<Model<double>>>(),
+             py::arg("steps"), py::arg("model"))
+        .def("fit", &Pipeline::fit, py::arg("X"), py::arg("y"), py::call_guard<py::gil_scoped_release>())
+        .def("predict", &Pipeline::predict, py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("predict_proba", &Pipeline::predict_proba, py::arg("X"), py::call_guard<py::gil_scoped_release>())
+        .def("fuse", &Pipeline::fuse)
+        .def("get_is_fused", &Pipeline::get_is_fused)
+        .def("get_fused_weights", &Pipeline::get_fused_weights)
+        .def("get_fused_bias", &Pipeline::get_fused_bias);
+
     // --- KNN Model Bindings ---
-    py::class_<KNN, Model<double>>(m, "KNN")
+    py::class_<KNN, Model<double>, std::shared_ptr<KNN>>(m, "KNN")
         .def(py::init<int>(), py::arg("k") = 3)
         .def("fit", &KNN::fit, py::arg("X"), py::arg("y"))
         .def("predict", &KNN::predict, py::arg("X"));
 
     // --- Neural Network Bindings ---
-    py::class_<NeuralNetwork, Model<double>>(m, "NeuralNetwork")
+    py::class_<NeuralNetwork, Model<double>, std::shared_ptr<NeuralNetwork>>(m, "NeuralNetwork")
         .def(py::init<double>(), py::arg("lr") = 0.01)
         .def("add", [](NeuralNetwork &nn, int in, int out) {
             nn.add(std::make_unique<DenseLayer>(in, out));
@@ -331,6 +660,38 @@ PYBIND11_MODULE(daedalus_cpp, m) {
              py::arg("X"), py::arg("y"), py::arg("epochs"))
         .def("predict", &NeuralNetwork::predict, py::arg("X"));
 
+    // --- Cross-Validation Bindings ---
+    m.def("kfold_indices", [](size_t n, size_t k, bool shuffle, int seed) {
+        std::vector<std::pair<std::vector<size_t>, std::vector<size_t>>> result;
+        for (auto& fold : kfold_indices(n, k, shuffle, seed)) result.emplace_back(std::move(fold.train), std::move(fold.test));
+        return result;
+    }, py::arg("n_rows"), py::arg("k") = 5, py::arg("shuffle") = true, py::arg("seed") = 42);
+
+    // The factory runs under the GIL, one model per fold; the folds then train concurrently without it
+    m.def("cross_validate", [](const py::function& model_factory, const Matrix<double>& X, const Matrix<double>& y,
+                               size_t k, const std::vector<std::string>& metrics, bool stratify, int seed, size_t num_threads) {
+        std::vector<SplitIndices> folds = stratify ? stratified_kfold_indices(y, k, seed) : kfold_indices(X.rows(), k, true, seed);
+        // Keep the Python objects alive for the whole call: for a Python subclass of Model the
+        // shared_ptr alone does not keep the Python half (and its fit/predict overrides) alive
+        std::vector<py::object> owners;
+        std::vector<std::shared_ptr<Model<double>>> models;
+        for (size_t f = 0; f < k; ++f) {
+            py::object model = model_factory();
+            if (py::hasattr(model, "_obj")) model = model.attr("_obj");
+            models.push_back(model.cast<std::shared_ptr<Model<double>>>());
+            owners.push_back(std::move(model));
+        }
+        std::map<std::string, std::vector<double>> result;
+        {
+            py::gil_scoped_release release;
+            result = cross_validate_models(models, X, y, folds, metrics, num_threads);
+        }
+        // models and owners are released here, with the GIL held
+        return result;
+    }, py::arg("model_factory"), py::arg("X"), py::arg("y"), py::arg("k") = 5,
+       py::arg("metrics") = std::vector<std::string>{"r2_score"}, py::arg("stratify") = false, py::arg("seed") = 42,
+       py::arg("num_threads") = 0);
+
     // --- Optimization Bindings ---
     using namespace daedalus::optimization;
 
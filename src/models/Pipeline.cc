@@ -0,0 +1,103 @@
+// src/models/Pipeline.cc
+
+#include <cmath>
+#include <stdexcept>
+#include "daedalus/core/Linalg.h"
+#include "daedalus/models/Pipeline.h"
+
+Pipeline::Pipeline(std::vector<std::shared_ptr<Transformer>> transformers, std::shared_ptr<Model<double>> estimator)
+    : steps(std::move(transformers)), model(std::move(estimator)), fused_weights(0, 0) {
+    if (!model) throw std::invalid_argument("Pipeline requires a model.");
+    for (const auto& step : steps) {
+        if (!step) throw std::invalid_argument("Pipeline stages must not be null.");
+    }
+}
+
+void Pipeline::fit(const Matrix<double>& X, const Matrix<double>& y) {
+    fused = false;
+    if (steps.empty()) {
+        model->fit(X, y);
+    } else {
+        Matrix<double> Z = X;
+        for (const auto& step : steps) step->fit_transform_inplace(Z);
+        model->fit(Z, y);
+    }
+    fuse();
+}
+
+bool Pipeline::fuse() {
+    fused = false;
+    fused_weights = Matrix<double>(0, 0);
+    fused_bias = 0.0;
+
+    Matrix<double> W(0, 0);
+    double b = 0.0;
+    if (auto* linear = dynamic_cast<const LinearRegression*>(model.get())) {
+        W = linear->get_weights();
+        b = linear->get_bias();
+        logistic = false;
+    } else if (auto* classifier = dynamic_cast<const LogisticRegression*>(model.get())) {
+        W = classifier->get_weights();
+        b = classifier->get_bias();
+        logistic = true;
+    } else {
+        return false;
+    }
+    if (W.rows() == 0) return false;
+
+    // Walk the stages backwards, rewriting the head in terms of each stage's input
+    std::vector<double> bias(1, b);
+    for (auto it = steps.rbegin(); it != steps.rend(); ++it) {
+        if (!(*it)->fold_into(W, bias)) return false;
+    }
+    fused_weights = std::move(W);
+    fused_bias = bias[0];
+    fused = true;
+    return true;
+}
+
+Matrix<double> Pipeline::fused_scores(const Matrix<double>& X) const {
+    if (X.cols() != fused_weights.rows()) {
+        throw std::invalid_argument("Pipeline was fitted on " + std::to_string(fused_weights.rows()) + " columns.");
+    }
+    Matrix<double> scores = Linalg::multiply(X, fused_weights);
+    double* out = scores.data_ptr();
+    for (size_t i = 0; i < scores.rows(); ++i) out[i] += fused_bias;
+    return scores;
+}
+
+Matrix<double> Pipeline::predict_blocks(const Matrix<double>& X, bool proba) const {
+    auto* classifier = dynamic_cast<const LogisticRegression*>(model.get());
+    if (proba && !classifier) throw std::logic_error("predict_proba requires a LogisticRegression model.");
+
+    size_t n = X.rows(), d = X.cols();
+    Matrix<double> result(n, 0);
+    for (size_t r0 = 0; r0 < n; r0 += BLOCK_ROWS) {
+        size_t rows = std::min(n, r0 + BLOCK_ROWS) - r0;
+        Matrix<double> block(rows, d);
+        std::copy_n(X.data_ptr() + r0 * d, rows * d, block.data_ptr());
+        for (const auto& step : steps) step->transform_inplace(block);
+        Matrix<double> out = proba ? classifier->predict_proba(block) : model->predict(block);
+        if (r0 == 0) result = Matrix<double>(n, out.cols());
+        std::copy_n(out.data_ptr(), out.rows() * out.cols(), result.data_ptr() + r0 * out.cols());
+    }
+    return result;
+}
+
+Matrix<double> Pipeline::predict(const Matrix<double>& X) const {
+    if (!fused) return predict_blocks(X, false);
+    Matrix<double> scores = fused_scores(X);
+    if (logistic) {
+        double* out = scores.data_ptr();
+        for (size_t i = 0; i < scores.rows(); ++i) out[i] = out[i] >= 0.0 ? 1.0 : 0.0; // sigmoid(z) >= 0.5
+    }
+    return scores;
+}
+
+Matrix<double> Pipeline::predict_proba(const Matrix<double>& X) const {
+    if (!fused || !logistic) return predict_blocks(X, true);
+    Matrix<double> scores = fused_scores(X);
+    double* out = scores.data_ptr();
+    for (size_t i = 0; i < scores.rows(); ++i) out[i] = 1.0 / (1.0 + std::exp(-out[i]));
+    return scores;
+}
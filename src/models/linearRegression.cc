@@ -3,6 +3,7 @@
 #include <iostream>
 #include <iomanip>
 #include "daedalus/models/linearRegression.h"
+#include "daedalus/core/FeatureProducts.h"
 
 Matrix<double> LinearRegression::predict(const Matrix<double>& X) const {
     Matrix<double> projection = X * weights;
@@ -16,7 +17,36 @@ void LinearRegression::fit(const Matrix<double>& X, const Matrix<double>& y) {
     this->fit(X, y, 100); 
 }
 
+Matrix<double> LinearRegression::predict(const SparseMatrix<double>& X) const {
+    Matrix<double> projection = X * weights;
+    for (size_t i = 0; i < projection.rows(); ++i) {
+        projection(i, 0) += bias(0, 0);
+    }
+    return projection;
+}
+
+Matrix<double> LinearRegression::predict(const PolynomialExpansion& X) const {
+    Matrix<double> projection = X * weights;
+    for (size_t i = 0; i < projection.rows(); ++i) {
+        projection(i, 0) += bias(0, 0);
+    }
+    return projection;
+}
+
 void LinearRegression::fit(const Matrix<double>& X, const Matrix<double>& y, int epochs) {
+    gradient_descent(X, y, epochs);
+}
+
+void LinearRegression::fit(const SparseMatrix<double>& X, const Matrix<double>& y, int epochs) {
+    gradient_descent(X, y, epochs);
+}
+
+void LinearRegression::fit(const PolynomialExpansion& X, const Matrix<double>& y, int epochs) {
+    gradient_descent(X, y, epochs);
+}
+
+template <typename Features>
+void LinearRegression::gradient_descent(const Features& X, const Matrix<double>& y, int epochs) {
     int m = X.rows();
     int n = X.cols();
 
@@ -24,12 +54,14 @@ void LinearRegression::fit(const Matrix<double>& X, const Matrix<double>& y, int
     bias = Matrix<double>(1, 1);
     bias(0, 0) = 0.0;
 
+    decltype(auto) XT = FeatureProducts::transposed(X);
+
     for (int i = 0; i < epochs; ++i) {
         Matrix<double> predictions = predict(X);
         Matrix<double> error = predictions - y;
 
         // Weight Gradient: (X^T * error) / m
-        Matrix<double> gradientW = X.transpose() * error;
+        Matrix<double> gradientW = FeatureProducts::transpose_times(XT, error);
 
         // Apply Regularization to the Gradient
         for (size_t j = 0; j < weights.rows(); ++j) {
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <iomanip>
 #include "daedalus/models/logisticRegression.h"
+#include "daedalus/core/FeatureProducts.h"
 
 Matrix<double> LogisticRegression::predict_proba(const Matrix<double>& X) const {
     Matrix<double> z = X * weights;
@@ -26,17 +27,64 @@ void LogisticRegression::fit(const Matrix<double>& X, const Matrix<double>& y) {
     this->fit(X, y, 100);
 }
 
+Matrix<double> LogisticRegression::predict_proba(const SparseMatrix<double>& X) const {
+    Matrix<double> z = X * weights;
+    for (size_t i = 0; i < z.rows(); ++i) {
+        z(i, 0) = sigmoid(z(i, 0) + bias(0, 0));
+    }
+    return z;
+}
+
+Matrix<double> LogisticRegression::predict(const SparseMatrix<double>& X) const {
+    Matrix<double> proba = predict_proba(X);
+    for (size_t i = 0; i < proba.rows(); ++i) {
+        proba(i, 0) = (proba(i, 0) >= 0.5) ? 1.0 : 0.0;
+    }
+    return proba;
+}
+
+Matrix<double> LogisticRegression::predict_proba(const PolynomialExpansion& X) const {
+    Matrix<double> z = X * weights;
+    for (size_t i = 0; i < z.rows(); ++i) {
+        z(i, 0) = sigmoid(z(i, 0) + bias(0, 0));
+    }
+    return z;
+}
+
+Matrix<double> LogisticRegression::predict(const PolynomialExpansion& X) const {
+    Matrix<double> proba = predict_proba(X);
+    for (size_t i = 0; i < proba.rows(); ++i) {
+        proba(i, 0) = (proba(i, 0) >= 0.5) ? 1.0 : 0.0;
+    }
+    return proba;
+}
+
 void LogisticRegression::fit(const Matrix<double>& X, const Matrix<double>& y, int epochs) {
+    gradient_descent(X, y, epochs);
+}
+
+void LogisticRegression::fit(const SparseMatrix<double>& X, const Matrix<double>& y, int epochs) {
+    gradient_descent(X, y, epochs);
+}
+
+void LogisticRegression::fit(const PolynomialExpansion& X, const Matrix<double>& y, int epochs) {
+    gradient_descent(X, y, epochs);
+}
+
+template <typename Features>
+void LogisticRegression::gradient_descent(const Features& X, const Matrix<double>& y, int epochs) {
     int m = X.rows();
     weights = Matrix<double>(X.cols(), 1);
     bias = Matrix<double>(1, 1);
     bias(0, 0) = 0.0;
 
+    decltype(auto) XT = FeatureProducts::transposed(X);
+
     for (int i = 0; i < epochs; ++i) {
         Matrix<double> predictions = predict_proba(X);
         Matrix<double> error = predictions - y;
 
-        Matrix<double> gradientW = X.transpose() * error;
+        Matrix<double> gradientW = FeatureProducts::transpose_times(XT, error);
 
         for (size_t j = 0; j < weights.rows(); ++j) {
             double reg_term = 0.0;
@@ -125,6 +125,55 @@ class TestProperties:
 # 3. Static Methods
 # ===========================================================================
 
+class TestStaticMethods:
+
+    def test_concat_rows(self):
+        a = make_people_df()
+        b = DataFrame()
+        b.add_column("score", [6.5])
+        b.add_column("name", ["Dana"])
+        b.add_column("age", [41])
+        result = DataFrame.concat([a, b])
+        assert result.shape == (4, 3)
+        assert result.columns == ["name", "age", "score"]
+        assert result.at(3, "name") == "Dana"
+        assert result.at(3, "age") == 41
+        assert result.at(0, "score") == pytest.approx(9.5)
+
+    def test_concat_rows_type_promotion(self):
+        a = DataFrame("x", [1, 2])
+        b = DataFrame("x", [2.5])
+        result = DataFrame.concat([a, b], axis=0)
+        assert result.dtype("x") == "float64"
+        assert result["x"] == [1.0, 2.0, 2.5]
+
+        c = DataFrame("x", ["n/a"])
+        result = DataFrame.concat([a, c])
+        assert result.dtype("x") == "mixed"
+        assert result["x"] == [1, 2, "n/a"]
+
+    def test_concat_columns(self):
+        a = make_people_df()
+        b = DataFrame("rank", [1, 2, 3])
+        result = DataFrame.concat([a, b], axis=1)
+        assert result.columns == ["name", "age", "score", "rank"]
+        assert result.at(2, "rank") == 3
+
+    def test_concat_exceptions(self):
+        with pytest.raises(ValueError):
+            DataFrame.concat([make_people_df(), DataFrame("other", [1.0, 2.0, 3.0])])
+
+        with pytest.raises(ValueError):
+            DataFrame.concat([make_people_df(), DataFrame("rank", [1, 2])], axis=1)
+
+        with pytest.raises(ValueError):
+            DataFrame.concat([make_people_df(), make_people_df()], axis=1)
+
+        with pytest.raises(ValueError):
+            DataFrame.concat([make_people_df()], axis=2)
+
+        assert DataFrame.concat([]).shape == (0, 0)
+
 
 # ===========================================================================
 # 4. Methods
@@ -306,6 +355,79 @@ class TestMethods:
         # age comes second → column 1
         assert m(0, 1) == pytest.approx(25.0)
 
+    def test_dtype(self):
+        df = make_people_df()
+        assert df.dtype("name") == "string"
+        assert df.dtype("age") == "int32"
+        assert df.dtype("score") == "float64"
+        assert DataFrame("mixed", [1.0, "hello", 42]).dtype("mixed") == "mixed"
+
+        with pytest.raises(ValueError):
+            df.dtype("ghost")
+
+    def test_append_rows(self):
+        df = make_people_df()
+        for i in range(100):
+            batch = DataFrame()
+            batch.add_column("name", [f"p{i}"])
+            batch.add_column("age", [i])
+            batch.add_column("score", [float(i)])
+            df.append_rows(batch)
+        assert df.rows == 103
+        assert df.at(102, "name") == "p99"
+        assert df.at(102, "age") == 99
+
+        df = DataFrame()
+        df.append_rows(make_people_df())
+        assert df.shape == (3, 3)
+
+        df = make_people_df()
+        batch = DataFrame()
+        batch.add_column("name", ["Eve"])
+        batch.add_column("age", [33.5])
+        batch.add_column("score", [1.0])
+        df.append_rows(batch)
+        assert df.dtype("age") == "float64"
+        assert df.at(3, "age") == pytest.approx(33.5)
+
+        df = make_people_df()
+        with pytest.raises(ValueError):
+            df.append_rows(DataFrame("name", ["Eve"]))
+
+    def test_unique_and_value_counts(self):
+        df = DataFrame()
+        df.add_column("city", ["Paris", "Lyon", "Paris", "Nice", "Paris", "Lyon"])
+        df.add_column("n", [1, 2, 1, 3, 1, 2])
+        assert df.unique("city") == ["Paris", "Lyon", "Nice"]
+        assert df.unique("n") == [1, 2, 3]
+
+        counts = df.value_counts("city")
+        assert counts.columns == ["city", "count"]
+        assert counts["city"] == ["Paris", "Lyon", "Nice"]
+        assert counts["count"] == [3, 2, 1]
+        assert counts.dtype("count") == "int64"
+
+        with pytest.raises(ValueError):
+            df.unique("ghost")
+
+    def test_drop_duplicates(self):
+        df = DataFrame()
+        df.add_column("a", ["x", "y", "x", "x"])
+        df.add_column("b", [1, 2, 1, 2])
+        df.add_column("c", [0.5, 0.5, 0.5, 0.5])
+
+        deduped = df.drop_duplicates()
+        assert deduped.rows == 3
+        assert deduped["b"] == [1, 2, 2]
+
+        deduped = df.drop_duplicates(["a"])
+        assert deduped["a"] == ["x", "y"]
+        assert deduped.rows == 2
+
+        assert df.drop_duplicates(["c"]).rows == 1
+        with pytest.raises(ValueError):
+            df.drop_duplicates(["ghost"])
+
 # ===========================================================================
 # 5. Dunder Methods - Acess Methods
 # ===========================================================================
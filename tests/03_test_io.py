@@ -12,9 +12,16 @@ Run:
 """
 
 from __future__ import annotations
+import gzip
+import importlib.util
+import math
+import numpy as np
+import pathlib
+import struct
+import zlib
 from unittest.mock import patch
 import pytest
-from daedalus import read_csv, DataFrame
+from daedalus import read_csv, read_csv_matrix, CsvReader, read_dcol, DcolFile, load_npy, save_npy, load_npz, save_npz, read_libsvm, save_libsvm, DataFrame, Matrix, SparseMatrix
 
 def test_read_csv():
     df: DataFrame = read_csv('tests/test.csv')
@@ -36,4 +43,546 @@ def test_read_csv():
         mock_cpp_read.side_effect = Exception("C++ Internal Error")
 
         with pytest.raises(RuntimeError, match="Failed to parse CSV via Daedalus engine"):
-            read_csv('tests/test.csv')
\ No newline at end of file
+            read_csv('tests/test.csv')
+
+def test_read_csv_types(tmp_path):
+    path = tmp_path / "types.csv"
+    path.write_text("num,text,sparse\r\n1.5,a,\r\n\r\n-2,b,7\r\n3e2,c")
+
+    df = read_csv(str(path))
+    assert df.rows == 3
+    assert df.dtype("num") == "float64"
+    assert df.dtype("text") == "string"
+    assert df.dtype("sparse") == "int32"
+    assert df["num"] == [1.5, -2.0, 300.0]
+    assert df["text"] == ["a", "b", "c"]
+    assert math.isnan(df.at(0, "sparse"))
+    assert df.at(1, "sparse") == 7
+    assert math.isnan(df.at(2, "sparse"))
+    assert df.null_count("sparse") == 2
+
+    df = read_csv(str(path), has_header=False)
+    assert df.get_column_names() == ["0", "1", "2"]
+    assert df.dtype("0") == "string"
+
+
+def test_read_csv_schema(tmp_path):
+    path = tmp_path / "schema.csv"
+    path.write_text(
+        "id,big,flag,city,score\n"
+        "1,5000000000,true,Paris,1\n"
+        "2,6000000000,False,Lyon,2\n"
+        "3,,TRUE,Paris,n/a\n"
+        "4,7,false,Paris,4.5\n"
+    )
+
+    df = read_csv(str(path), sample_rows=2)
+    assert df.dtype("id") == "int32"
+    assert df.dtype("big") == "int64"
+    assert df.dtype("flag") == "bool"
+    assert df.dtype("city") == "string"
+    # "n/a" first appears after the sampled rows: the inferred column widens to mixed instead of nulling it
+    assert df.dtype("score") == "mixed"
+    assert df["flag"] == [1, 0, 1, 0]
+    assert df.null_count("big") == 1
+    assert df.null_count("score") == 0
+    assert df.at(2, "score") == "n/a" and df.at(3, "score") == 4.5
+
+    df = read_csv(str(path), dtype={"city": "category", "id": "float64", "score": "int32"})
+    assert df.dtype("city") == "category"
+    assert df.dtype("id") == "float64"
+    assert df["city"] == ["Paris", "Lyon", "Paris", "Paris"]
+    assert df.value_counts("city")["count"] == [3, 1]
+    assert df.dtype("score") == "int32"
+    assert df.null_count("score") == 2
+
+    late = tmp_path / "late.csv"
+    late.write_text("blank,num\n" + ",1.5\n" * 20 + "text,oops\n" + ",2\n")
+    df = read_csv(str(late), sample_rows=10)
+    assert df.dtype("blank") == "mixed" and df.dtype("num") == "mixed"
+    assert df.at(20, "blank") == "text" and df.at(20, "num") == "oops"
+    assert df.null_count("blank") == 21
+    assert df.at(21, "num") == 2.0
+    df = read_csv(str(late), sample_rows=10, dtype={"num": "float64"})
+    assert df.dtype("num") == "float64" and df.null_count("num") == 1
+
+    with pytest.raises(RuntimeError):
+        read_csv(str(path), dtype={"ghost": "int32"})
+    with pytest.raises(RuntimeError):
+        read_csv(str(path), dtype={"id": "int8"})
+
+
+def test_read_csv_widening_threads(tmp_path):
+    # An int column ("v") and a float column ("f") meet text in the first of four
+    # parsing chunks only; the cells must not depend on which chunks widened.
+    rows = 300_000
+    pad = "p" * 45
+    path = tmp_path / "widen.csv"
+    path.write_text("v,f,pad\n" + "".join(
+        f"{'x' if i == 50_000 else i},{'y' if i == 50_000 else (i if i % 2 else i + 0.5)},{pad}\n"
+        for i in range(rows)))
+    assert path.stat().st_size >= 4 * (4 << 20)
+
+    serial = read_csv(str(path), num_threads=1)
+    parallel = read_csv(str(path), num_threads=4)
+    for name in ["v", "f"]:
+        assert serial.dtype(name) == parallel.dtype(name) == "mixed"
+        assert serial[name] == parallel[name]
+        assert [type(x) for x in serial[name]] == [type(x) for x in parallel[name]]
+    assert serial["v"][49_999:50_002] == [49_999, "x", 50_001]
+    assert type(serial["v"][50_001]) is int
+    assert type(serial["f"][50_001]) is float
+
+
+def test_read_csv_quoting(tmp_path):
+    path = tmp_path / "quoted.csv"
+    path.write_text(
+        'name,note,n\n'
+        '"Smith, J.","said ""hi""",1\n'
+        '"multi\nline",plain,2\n'
+    )
+
+    df = read_csv(str(path))
+    assert df.rows == 2
+    assert df["name"] == ["Smith, J.", "multi\nline"]
+    assert df["note"] == ['said "hi"', "plain"]
+    assert df["n"] == [1, 2]
+
+    path = tmp_path / "dialect.tsv"
+    path.write_text("# exported data\na\tb\n'x\ty'\t1\n# note\nz\t2\n")
+    df = read_csv(str(path), delimiter="\t", quote="'", comment="#")
+    assert df.get_column_names() == ["a", "b"]
+    assert df["a"] == ["x\ty", "z"]
+    assert df["b"] == [1, 2]
+
+    with pytest.raises(RuntimeError):
+        read_csv(str(path), delimiter=",", quote=",")
+
+
+def test_read_csv_projection(tmp_path):
+    path = tmp_path / "wide.csv"
+    path.write_text("a,b,c\n" + "".join(f'{i},"x,{i}",{i * 2}\n' for i in range(100)))
+
+    df = read_csv(str(path), usecols=["c", "a"])
+    assert df.get_column_names() == ["a", "c"]
+    assert df.at(5, "c") == 10
+
+    df = read_csv(str(path), usecols=["a"], skiprows=5, nrows=10)
+    assert df["a"] == list(range(5, 15))
+
+    size = path.stat().st_size
+    cuts = [0, size // 3, 2 * size // 3, size]
+    parts = [read_csv(str(path), chunks_range=(lo, hi)) for lo, hi in zip(cuts, cuts[1:])]
+    assert sum(p.rows for p in parts) == 100
+    assert [v for p in parts for v in p["a"]] == list(range(100))
+
+    with pytest.raises(RuntimeError):
+        read_csv(str(path), usecols=["ghost"])
+
+
+def test_read_csv_glob(tmp_path):
+    for part in range(3):
+        rows = "".join(f"{part * 10 + i},{i * 0.5}\n" for i in range(part * 4))
+        (tmp_path / f"part-{part}.csv").write_text("id,v\n" + rows)
+    (tmp_path / "other.csv").write_text("x\n1\n")
+    with gzip.open(tmp_path / "part-3.csv", "wt") as f:
+        f.write("id,v\n30,1.5\n")
+
+    df = read_csv(str(tmp_path / "part-*.csv"))
+    assert df.get_column_names() == ["id", "v"]
+    assert df["id"] == [10, 11, 12, 13, 20, 21, 22, 23, 24, 25, 26, 27, 30]
+    assert df.dtype("v") == "float64"
+    assert read_csv(str(tmp_path / "part-[12].csv"), nrows=6, num_threads=2).rows == 6
+    with pytest.raises(FileNotFoundError):
+        read_csv(str(tmp_path / "missing-*.csv"))
+    with pytest.raises(RuntimeError):
+        read_csv(str(tmp_path / "*.csv"))
+
+    # Empty and unreadable files complete as soon as they are opened; the reader must still wake
+    (tmp_path / "part-4.csv").write_text("")
+    assert read_csv(str(tmp_path / "part-*.csv")).rows == 13
+    from daedalus.daedalus_cpp import read_files
+    empty = [str(tmp_path / "empty-a.csv"), str(tmp_path / "empty-b.csv")]
+    for path in empty:
+        pathlib.Path(path).write_text("")
+    first = str(tmp_path / "part-1.csv")
+    missing = str(tmp_path / "missing.csv")
+    for _ in range(50):
+        assert read_files(empty, backend="threads") == [b"", b""]
+        assert read_files(empty + [first], queue_depth=1, backend="threads")[2].startswith(b"id,v")
+        with pytest.raises(RuntimeError):
+            read_files([first, missing], queue_depth=1, backend="threads")
+        with pytest.raises(RuntimeError):
+            read_files([missing] + empty, backend="threads")
+
+
+def test_read_csv_matrix(tmp_path):
+    path = tmp_path / "train.csv"
+    path.write_text("a,b,label,c\n1,2,0,x\n3,\"4\",1,5\n,true,1\n")
+
+    X, y = read_csv_matrix(str(path), ["c", "a"], target_column="label")
+    assert X.shape == (3, 2) and y.shape == (3, 1)
+    values = X.to_numpy()
+    assert math.isnan(values[0, 0]) and values[0, 1] == 1.0
+    assert list(values[1]) == [5.0, 3.0]
+    assert math.isnan(values[2, 0]) and math.isnan(values[2, 1])
+    assert list(y.to_numpy()[:, 0]) == [0.0, 1.0, 1.0]
+
+    X, y = read_csv_matrix(str(path), target_column="label")
+    assert X.shape == (3, 3) and y is not None
+    X, y = read_csv_matrix(str(path), ["b"])
+    assert list(X.to_numpy()[:, 0]) == [2.0, 4.0, 1.0] and y is None
+
+    with pytest.raises(ValueError):
+        read_csv_matrix(str(path), ["a", "label"], target_column="label")
+    with pytest.raises(ValueError):
+        read_csv_matrix(str(path), ["ghost"])
+    with pytest.raises(FileNotFoundError):
+        read_csv_matrix("fakeName.csv", ["a"])
+
+
+def test_read_csv_gzip(tmp_path):
+    text = "a,b\n" + "".join(f'{i},"x\n{i}"\n' for i in range(1000))
+    plain = tmp_path / "data.csv"
+    plain.write_text(text)
+    packed = tmp_path / "data.csv.gz"
+    packed.write_bytes(gzip.compress(text[:5000].encode()) + gzip.compress(text[5000:].encode()))
+
+    expected = read_csv(str(plain))
+    df = read_csv(str(packed))
+    assert df["a"] == expected["a"]
+    assert df["b"] == expected["b"]
+
+    batches = list(CsvReader(str(packed), batch_rows=300))
+    assert [b.rows for b in batches] == [300, 300, 300, 100]
+    assert [v for b in batches for v in b["b"]] == expected["b"]
+
+    truncated = tmp_path / "truncated.csv.gz"
+    truncated.write_bytes(packed.read_bytes()[:200])
+    with pytest.raises(RuntimeError):
+        read_csv(str(truncated))
+
+
+def _bgzf(data: bytes, block: int = 4096) -> bytes:
+    """Compresses data the way bgzip does: one gzip member per block, each with a "BC" size field."""
+    out = b""
+    for start in range(0, len(data), block):
+        raw = data[start:start + block]
+        packer = zlib.compressobj(6, zlib.DEFLATED, -15)
+        deflated = packer.compress(raw) + packer.flush()
+        header = struct.pack("<BBBBIBBHBBHH", 0x1F, 0x8B, 8, 4, 0, 0, 0xFF, 6, ord("B"), ord("C"), 2,
+                             18 + len(deflated) + 8 - 1)
+        out += header + deflated + struct.pack("<II", zlib.crc32(raw), len(raw))
+    return out
+
+
+def _zstd_raw_frames(data: bytes, frame: int = 4096) -> bytes:
+    """Wraps data in zstd frames of stored (raw) blocks, each recording its content size."""
+    out = b""
+    for start in range(0, len(data), frame):
+        raw = data[start:start + frame]
+        out += struct.pack("<IBI", 0xFD2FB528, 0xA0, len(raw))
+        out += ((len(raw) << 3) | 1).to_bytes(3, "little") + raw
+    return out
+
+
+def test_read_csv_bgzf(tmp_path):
+    text = "a,b\n" + "".join(f'{i},"x\n{i}"\n' for i in range(20_000))
+    plain = tmp_path / "data.csv"
+    plain.write_text(text)
+    packed = tmp_path / "data.csv.gz"
+    packed.write_bytes(_bgzf(text.encode()))
+    assert gzip.decompress(packed.read_bytes()) == text.encode()
+
+    # Dozens of members, decoded in parallel; block cuts fall inside records and quoted fields
+    expected = read_csv(str(plain))
+    for threads in [1, 4]:
+        df = read_csv(str(packed), num_threads=threads)
+        assert df["a"] == expected["a"]
+        assert df["b"] == expected["b"]
+    batches = list(CsvReader(str(packed), batch_rows=3000))
+    assert sum(b.rows for b in batches) == 20_000
+    assert [v for b in batches for v in b["b"]] == expected["b"]
+
+    data = packed.read_bytes()
+    truncated = tmp_path / "truncated.csv.gz"
+    truncated.write_bytes(data[:len(data) // 2])
+    with pytest.raises(RuntimeError):
+        read_csv(str(truncated))
+
+    # A damaged member in the middle of an otherwise well-formed BGZF file
+    corrupt = bytearray(data)
+    middle = len(data) // 2
+    corrupt[middle:middle + 16] = bytes(16)
+    (tmp_path / "corrupt.csv.gz").write_bytes(bytes(corrupt))
+    with pytest.raises(RuntimeError):
+        read_csv(str(tmp_path / "corrupt.csv.gz"))
+
+
+def test_read_csv_zstd(tmp_path):
+    text = "a,b\n" + "".join(f"{i},{i * 0.5}\n" for i in range(10_000))
+    packed = tmp_path / "data.csv.zst"
+    packed.write_bytes(_zstd_raw_frames(text.encode()))
+    try:
+        df = read_csv(str(packed))
+    except RuntimeError as e:
+        if "without zstd" in str(e):
+            pytest.skip("Daedalus was built without zstd support")
+        raise
+
+    expected = read_csv(str(packed), num_threads=1)
+    assert df.rows == 10_000
+    assert df["a"] == list(range(10_000))
+    assert df["b"] == expected["b"]
+
+    truncated = tmp_path / "truncated.csv.zst"
+    truncated.write_bytes(packed.read_bytes()[:-100])
+    with pytest.raises(RuntimeError):
+        read_csv(str(truncated))
+
+
+def test_npy_roundtrip(tmp_path):
+    arr = np.arange(12, dtype=np.float64).reshape(3, 4) / 3
+    np.save(tmp_path / "c.npy", arr)
+    np.save(tmp_path / "f.npy", np.asfortranarray(arr.astype(np.float32)))
+    np.save(tmp_path / "v.npy", np.arange(5, dtype=np.int32))
+
+    np.testing.assert_array_equal(load_npy(str(tmp_path / "c.npy")).to_numpy(), arr)
+    np.testing.assert_array_equal(load_npy(str(tmp_path / "f.npy")).to_numpy(), arr.astype(np.float32))
+    assert load_npy(str(tmp_path / "v.npy")).shape == (5, 1)
+
+    m = Matrix([[1.5, -2.0], [3.25, 4.0]])
+    save_npy(str(tmp_path / "m.npy"), m)
+    np.testing.assert_array_equal(np.load(tmp_path / "m.npy"), m.to_numpy())
+
+    np.savez(tmp_path / "d.npz", X=arr, y=np.ones(3))
+    loaded = load_npz(str(tmp_path / "d.npz"))
+    np.testing.assert_array_equal(loaded["X"].to_numpy(), arr)
+    assert loaded["y"].shape == (3, 1)
+
+    save_npz(str(tmp_path / "out.npz"), X=m, y=Matrix([[1.0], [0.0]]))
+    with np.load(tmp_path / "out.npz") as archive:
+        np.testing.assert_array_equal(archive["X"], m.to_numpy())
+        assert archive["y"].shape == (2, 1)
+
+    np.save(tmp_path / "cube.npy", np.zeros((2, 2, 2)))
+    with pytest.raises(RuntimeError):
+        load_npy(str(tmp_path / "cube.npy"))
+    np.savez_compressed(tmp_path / "z.npz", X=arr)
+    with pytest.raises(RuntimeError):
+        load_npz(str(tmp_path / "z.npz"))
+
+
+def test_libsvm_roundtrip(tmp_path):
+    path = tmp_path / "data.svm"
+    path.write_text("1 1:0.5 4:2\n-1 qid:3 2:1.5 # comment\n\n0\n")
+    X, y = read_libsvm(str(path))
+    assert isinstance(X, SparseMatrix)
+    assert X.shape == (3, 4)
+    assert X.nnz == 3
+    assert y.to_numpy().ravel().tolist() == [1.0, -1.0, 0.0]
+    np.testing.assert_array_equal(X.to_dense().to_numpy(),
+                                  [[0.5, 0, 0, 2], [0, 1.5, 0, 0], [0, 0, 0, 0]])
+    assert list(X.indptr) == [0, 2, 3, 3]
+    assert read_libsvm(str(path), n_features=10)[0].cols == 10
+    assert read_libsvm(str(path), zero_based=True)[0].cols == 5
+
+    out = str(tmp_path / "out.svm")
+    save_libsvm(out, X, y)
+    X2, y2 = read_libsvm(out, n_features=4)
+    np.testing.assert_array_equal(X2.to_dense().to_numpy(), X.to_dense().to_numpy())
+    assert y2 == y
+    save_libsvm(out, Matrix([[0.0, 3.0]]), Matrix([[2.0]]), zero_based=True)
+    assert pathlib.Path(out).read_text() == "2 1:3\n"
+
+    with pytest.raises(ValueError):
+        read_libsvm(str(path), n_features=2)
+    (tmp_path / "zero.svm").write_text("1 0:1 2:1\n")
+    with pytest.raises(ValueError):
+        read_libsvm(str(tmp_path / "zero.svm"), zero_based=False)
+    (tmp_path / "bad.svm").write_text("1 a:b\n")
+    with pytest.raises(RuntimeError):
+        read_libsvm(str(tmp_path / "bad.svm"))
+    with pytest.raises(FileNotFoundError):
+        read_libsvm("fakeName.svm")
+
+
+def test_to_csv_roundtrip(tmp_path):
+    df = DataFrame("text", ["plain", "a,b", 'say "hi"', "two\nlines"])
+    df["x"] = [0.1, 1e300, -2.5, 3.0]
+    path = str(tmp_path / "out.csv")
+    df.to_csv(path, num_threads=2)
+
+    back = read_csv(path)
+    assert back["text"] == df["text"]
+    assert back["x"] == df["x"]
+
+    # Three columns are estimated at 37 bytes a row, so the writer's 4 MiB blocks hold
+    # 113,359 rows: 600,000 rows make 6 blocks, i.e. 3 double-buffered waves of 2 blocks.
+    rows = 600_000
+    src = tmp_path / "big.csv"
+    texts = ["plain", '"a,b"', '"""q"""', '"l1\nl2"', ""]
+    src.write_text("text,x,n\n" + "".join(
+        f"{texts[i % 5]},{'' if i % 7 == 0 else i / 8},{i}\n" for i in range(rows)))
+    big = read_csv(str(src))
+    serial, parallel = str(tmp_path / "serial.csv"), str(tmp_path / "parallel.csv")
+    big.to_csv(serial, num_threads=1)
+    big.to_csv(parallel, num_threads=2)
+    assert pathlib.Path(parallel).read_bytes() == pathlib.Path(serial).read_bytes()
+
+    back = read_csv(parallel)
+    assert back.rows == rows
+    for name in ["text", "x", "n"]:
+        assert back.null_count(name) == big.null_count(name)
+    assert back["text"][:4] == ["plain", "a,b", '"q"', "l1\nl2"]
+    assert back["n"] == big["n"]
+
+    m = Matrix([[1.0, 2.5], [1 / 3, -4.0]])
+    m.to_csv(path, header=["a", "b"])
+    back = read_csv(path)
+    assert back["a"] == [1.0, 1 / 3]
+    assert back["b"] == [2.5, -4.0]
+    with pytest.raises(ValueError):
+        m.to_csv(path, header=["a"])
+
+
+def test_read_csv_threads(tmp_path):
+    # Large enough for four parsing chunks (CSV_MIN_CHUNK_BYTES is 4 MiB), with a
+    # quoted field spanning several lines and commas in every record.
+    pad = "abcdefghi\n" * 8
+    text = "id,note,x\n" + "".join(f'{i},"row {i}\nsecond, with ""quotes""\n{pad}",{i * 0.25}\n'
+                                    for i in range(140_002))
+    path = tmp_path / "rows.csv"
+    path.write_bytes(text.encode())
+
+    # Each nominal cut of the body into 4 pieces falls inside a quoted field, so the
+    # splitter has to move every chunk boundary past an embedded newline.
+    data = text.encode()
+    body = len("id,note,x\n")
+    total = len(data) - body
+    assert total >= 4 * (4 << 20)
+    for k in range(1, 4):
+        assert data[body:body + total * k // 4].count(b'"') % 2 == 1
+
+    serial = read_csv(str(path), num_threads=1)
+    parallel = read_csv(str(path), num_threads=4)
+    assert parallel.rows == serial.rows == 140_002
+    assert parallel.dtype("id") == serial.dtype("id")
+    assert parallel["id"] == serial["id"]
+    assert parallel["note"] == serial["note"]
+    assert parallel["x"] == serial["x"]
+    assert parallel.at(70_001, "note") == f'row 70001\nsecond, with "quotes"\n{pad}'
+
+
+def test_csv_reader(tmp_path):
+    path = tmp_path / "stream.csv"
+    path.write_text("x,y\n" + "".join(f"{i},{i * 2}\n" for i in range(25)))
+
+    reader = CsvReader(str(path), batch_rows=10)
+    assert reader.columns == ["x", "y"]
+    batches = list(reader)
+    assert [b.rows for b in batches] == [10, 10, 5]
+    assert isinstance(batches[0], DataFrame)
+    assert batches[2].at(4, "y") == 48
+
+    matrices = list(CsvReader(str(path), 10, matrix_columns=["y"]))
+    assert isinstance(matrices[0], Matrix)
+    assert matrices[1][0, 0] == 20.0
+
+    with pytest.raises(FileNotFoundError):
+        CsvReader("fakeName.csv")
+    with pytest.raises(ValueError):
+        CsvReader(str(path), batch_rows=0)
+
+
+def test_dcol_roundtrip(tmp_path):
+    csv = tmp_path / "frame.csv"
+    csv.write_text("x,n,city,flag\n" + "".join(f"{i * 0.5},{i},{'AB'[i % 2]},{'true' if i % 3 else ''}\n" for i in range(1000)))
+    df = read_csv(str(csv), dtype={"city": "category"})
+
+    for compression in ["lz4", "none"]:
+        path = str(tmp_path / f"frame_{compression}.dcol")
+        df.save(path, compression=compression, chunk_rows=128)
+        loaded = read_dcol(path)
+        assert loaded.get_column_names() == df.get_column_names()
+        for name in df.get_column_names():
+            assert loaded.dtype(name) == df.dtype(name)
+        assert loaded["x"] == df["x"]
+        assert loaded["city"] == df["city"]
+        assert loaded.null_count("flag") == df.null_count("flag")
+
+    filtered = read_dcol(path, columns=["n"], filters=[("x", ">=", 400.0), ("n", "<", 805)])
+    assert filtered["n"] == list(range(800, 805))
+
+    f = DcolFile(path)
+    assert f.rows == 1000
+    assert len(f.chunk_stats("x")) == 8
+    assert f.chunk_stats("x")[1]["min"] == 64.0
+    assert f.is_zero_copy("x")
+    assert f.to_numpy("x")[10] == 5.0
+    assert not f.is_zero_copy("flag")
+    with pytest.raises(ValueError):
+        f.to_numpy("flag")
+    with pytest.raises(ValueError):
+        read_dcol(path, filters=[("x", "~", 1.0)])
+    with pytest.raises(FileNotFoundError):
+        read_dcol("fakeName.dcol")
+
+
+def test_dcol_rejects_misaligned_chunks(tmp_path):
+    df = DataFrame("a", [float(i) for i in range(128)])
+    df["b"] = [float(-i) for i in range(128)]
+    path = tmp_path / "frame.dcol"
+    df.save(str(path), compression="none", chunk_rows=64)
+
+    # Rewrite the chunk row counts of "b" from (64, 64) to (63, 65): the total still matches
+    # the file, but chunk 0 of "b" no longer covers the same rows as chunk 0 of "a".
+    data = bytearray(path.read_bytes())
+    header = struct.pack("<I", 1) + b"b" + struct.pack("<BII", 0, 0, 2)
+    at = data.rindex(header) + len(header)
+    chunk_size = 8 + 2 * 25 + 8 + 1 + 16
+    assert struct.unpack_from("<Q", data, at)[0] == 64
+    struct.pack_into("<Q", data, at, 63)
+    struct.pack_into("<Q", data, at + chunk_size, 65)
+    path.write_bytes(bytes(data))
+
+    with pytest.raises(RuntimeError, match="chunked differently"):
+        DcolFile(str(path))
+
+
+def test_dcol_rejects_bad_category_codes(tmp_path):
+    csv = tmp_path / "frame.csv"
+    csv.write_text("c\nA\nB\nA\n")
+    df = read_csv(str(csv), dtype={"c": "category"})
+    path = tmp_path / "frame.dcol"
+    df.save(str(path), compression="none")
+    assert read_dcol(str(path))["c"][:2] == ["A", "B"]
+
+    # Point row 1 past the two-entry dictionary
+    data = bytearray(path.read_bytes())
+    header = struct.pack("<I", 1) + b"c" + struct.pack("<BII", 6, 2, 1) + b"A" + struct.pack("<I", 1) + b"B"
+    at = data.rindex(header) + len(header) + 4 + 8
+    assert data[at] == 0
+    values = struct.unpack_from("<Q", data, at + 1)[0]
+    struct.pack_into("<i", data, values + 4, 7)
+    path.write_bytes(bytes(data))
+
+    with pytest.raises(RuntimeError, match="bad category code"):
+        read_dcol(str(path))
+
+
+def test_dcol_pure_python_reader(tmp_path):
+    spec = importlib.util.spec_from_file_location(
+        "dcol_reader", pathlib.Path(__file__).parent.parent / "tools" / "dcol_reader.py")
+    dcol_reader = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(dcol_reader)
+
+    df = DataFrame("v", [1.5, 2.5, 3.5])
+    df["s"] = ["a", "bb", "a"]
+    path = str(tmp_path / "small.dcol")
+    df.save(path)
+
+    footer = dcol_reader.read_footer(path)
+    assert footer["rows"] == 3
+    assert [c["dtype"] for c in footer["columns"]] == ["float64", "string"]
+    assert dcol_reader.read_columns(path) == {"v": [1.5, 2.5, 3.5], "s": ["a", "bb", "a"]}
@@ -14,7 +14,10 @@ Run:
 
 from __future__ import annotations
 from daedalus import Matrix
-from daedalus.model_selection import train_test_split
+import pytest
+from daedalus.model_selection import (train_test_split, train_test_split_indices, take_rows, kfold_indices,
+                                      cross_validate)
+from daedalus.models import LinearRegression, LogisticRegression
 
 class TestTrainTestSplit():
     def test_return_parts_len(self):
@@ -85,4 +88,90 @@ class TestTrainTestSplit():
         
         # Different seed results
         X_tr3, _, _, _ = train_test_split(X, y, seed=456)
-        assert X_tr1 != X_tr3
\ No newline at end of file
+        assert X_tr1 != X_tr3
+
+    def test_views_and_indices(self):
+        X = Matrix([[i, -i] for i in range(10)])
+        y = Matrix([[i] for i in range(10)])
+
+        X_tr, X_ts, y_tr, y_ts = train_test_split(X, y, test_size=0.3, seed=7)
+        vX_tr, vX_ts, vy_tr, vy_ts = train_test_split(X, y, test_size=0.3, seed=7, copy=False)
+        assert vX_tr.shape == (7, 2)
+        assert vX_tr.to_matrix() == X_tr
+        assert vy_ts.to_matrix() == y_ts
+        assert vX_ts[1, 1] == X_ts[1, 1]
+        assert vX_tr.base is X
+
+        train, test = train_test_split_indices(10, test_size=0.3, seed=7)
+        assert train == vX_tr.indices
+        assert test == vy_ts.indices
+        assert take_rows(X, test) == X_ts
+
+        with pytest.raises(ValueError):
+            train_test_split(X, Matrix([[1]]))
+        with pytest.raises(ValueError):
+            train_test_split_indices(10, test_size=1.5)
+
+    def test_stratified(self):
+        X = Matrix([[i] for i in range(20)])
+        y = Matrix([[1.0 if i < 5 else 0.0] for i in range(20)])
+
+        _, _, y_tr, y_ts = train_test_split(X, y, test_size=0.4, stratify=True)
+        assert y_ts.rows == 8
+        assert sum(y_ts[i, 0] for i in range(y_ts.rows)) == 2.0
+        assert sum(y_tr[i, 0] for i in range(y_tr.rows)) == 3.0
+
+        train, test = train_test_split_indices(20, test_size=0.4, y=y)
+        assert sorted(train + test) == list(range(20))
+
+class TestCrossValidate():
+    def test_kfold_indices(self):
+        folds = kfold_indices(11, folds=3)
+        assert [len(test) for _, test in folds] == [3, 4, 4]
+        assert sorted(i for _, test in folds for i in test) == list(range(11))
+        for train, test in folds:
+            assert sorted(train + test) == list(range(11))
+
+    def test_regression_scores(self):
+        X = Matrix([[i / 10.0] for i in range(50)])
+        y = Matrix([[3.0 * i / 10.0 + 1.0] for i in range(50)])
+
+        results = cross_validate(lambda: LinearRegression(learning_rate=0.05), X, y, folds=5,
+                                 metrics=["r2_score", "mean_squared_error"])
+        assert set(results) == {"fit_time", "score_time", "test_r2_score", "test_mean_squared_error"}
+        assert all(len(values) == 5 for values in results.values())
+        assert all(t >= 0.0 for t in results["fit_time"])
+        assert all(score > 0.9 for score in results["test_r2_score"])
+
+    def test_stratified_classification(self):
+        X = Matrix([[float(i % 10)] for i in range(40)])
+        y = Matrix([[1.0 if i % 10 >= 5 else 0.0] for i in range(40)])
+
+        results = cross_validate(lambda: LogisticRegression(learning_rate=0.1), X, y, folds=4,
+                                 metrics=["accuracy_score"], stratify=True)
+        assert len(results["test_accuracy_score"]) == 4
+
+        with pytest.raises(ValueError):
+            cross_validate(LinearRegression, X, y, metrics=["unknown"])
+        with pytest.raises(ValueError):
+            cross_validate(LinearRegression, X, y, folds=1)
+
+    def test_python_model_subclass(self):
+        from daedalus.daedalus_cpp import Model as _ModelCpp, Matrix as _MatrixCpp
+
+        class MeanModel(_ModelCpp):
+            """Predicts the mean target; fit and predict are Python overrides called from the fold threads."""
+            def __init__(self):
+                super().__init__()
+                self.mean = 0.0
+
+            def fit(self, X, y):
+                self.mean = sum(y[i, 0] for i in range(y.rows)) / y.rows
+
+            def predict(self, X):
+                return _MatrixCpp(X.rows, 1, [self.mean] * X.rows)
+
+        X = Matrix([[float(i)] for i in range(20)])
+        y = Matrix([[2.0] for _ in range(20)])
+        results = cross_validate(MeanModel, X, y, folds=4, metrics=["mean_squared_error"])
+        assert results["test_mean_squared_error"] == [0.0, 0.0, 0.0, 0.0]
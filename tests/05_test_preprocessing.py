@@ -2,7 +2,9 @@
 05_test_preprocessing.py
 ==============
 Full-coverage test suite for
-    (daedalus/preprocessing/standard_scaler.py).
+    (daedalus/preprocessing/standard_scaler.py, min_max_scaler.py,
+     max_abs_scaler.py, robust_scaler.py, pca.py, polynomial_features.py,
+     feature_hasher.py).
 
 Run:
     pytest tests/05_test_preprocessing.py
@@ -14,8 +16,9 @@ Run:
 
 from __future__ import annotations
 import pytest
-from daedalus import Matrix
-from daedalus.preprocessing import StandardScaler
+from daedalus import Matrix, DataFrame
+from daedalus.preprocessing import (Transformer, StandardScaler, MinMaxScaler, MaxAbsScaler, RobustScaler, PCA,
+                                   PolynomialFeatures, FeatureHasher)
 
 class TestStandardScaler:
     def test_init(self):
@@ -86,4 +89,208 @@ class TestStandardScaler:
         results = scaler.transform(m)
         # Standardized constant column should be all zeros (val - mean)/1.0 -> (5-5)/1.0
         assert results[0, 1] == 0.0
-        assert results[1, 1] == 0.0
\ No newline at end of file
+        assert results[1, 1] == 0.0
+
+    def test_partial_fit(self):
+        rows = [[1.0, 10.0], [2.0, 20.0], [4.0, 5.0], [8.0, 0.0], [3.0, 1.0]]
+        full = StandardScaler().fit(Matrix(rows))
+
+        scaler = StandardScaler()
+        scaler.partial_fit(Matrix(rows[:2]))
+        scaler.partial_fit(Matrix(rows[2:3]))
+        scaler.partial_fit(Matrix(rows[3:]))
+        assert scaler.is_fitted
+        assert scaler.n_samples_seen == 5
+        assert scaler.means == pytest.approx(full.means)
+        assert scaler.std_devs == pytest.approx(full.std_devs)
+
+        scaler.fit(Matrix(rows[:2]))
+        assert scaler.n_samples_seen == 2
+        with pytest.raises(ValueError):
+            scaler.partial_fit(Matrix([[1.0, 2.0, 3.0]]))
+
+    def test_transform_inplace(self):
+        m = Matrix([[1, 2], [3, 4]])
+        scaler = StandardScaler().fit(m)
+        scaler.transform_inplace(m)
+        assert m == Matrix([[-1, -1], [1, 1]])
+        assert scaler.inverse_transform(m) == Matrix([[1, 2], [3, 4]])
+
+        m = Matrix([[1, 2], [3, 4]])
+        assert StandardScaler().fit_transform(m, inplace=True) is m
+        assert m == Matrix([[-1, -1], [1, 1]])
+
+        with pytest.raises(ValueError):
+            scaler.transform(Matrix([[1.0, 2.0, 3.0]]))
+        with pytest.raises(RuntimeError, match="Scaler must be fitted first"):
+            StandardScaler().transform_inplace(m)
+
+
+class TestMinMaxScaler:
+    def test_fit_transform(self):
+        m = Matrix([[1, 10], [2, 10], [3, 10]])
+        scaler = MinMaxScaler()
+        assert isinstance(scaler, Transformer)
+        results = scaler.fit_transform(m)
+        assert scaler.data_min == [1.0, 10.0]
+        assert scaler.data_max == [3.0, 10.0]
+        assert [results[i, 0] for i in range(3)] == pytest.approx([0.0, 0.5, 1.0])
+        assert [results[i, 1] for i in range(3)] == [0.0, 0.0, 0.0]
+        assert scaler.inverse_transform(results)[2, 0] == pytest.approx(3.0)
+
+        results = MinMaxScaler(feature_range=(-1.0, 1.0)).fit_transform(m)
+        assert results[0, 0] == -1.0
+        assert results[2, 0] == pytest.approx(1.0)
+        with pytest.raises(ValueError):
+            MinMaxScaler(feature_range=(1.0, 0.0))
+
+    def test_partial_fit(self):
+        scaler = MinMaxScaler()
+        scaler.partial_fit(Matrix([[0.0, 5.0]]))
+        scaler.partial_fit(Matrix([[4.0, -5.0], [2.0, 0.0]]))
+        assert scaler.n_samples_seen == 3
+        assert scaler.data_min == [0.0, -5.0]
+        assert scaler.data_max == [4.0, 5.0]
+
+        m = Matrix([[2.0, 0.0]])
+        scaler.transform_inplace(m)
+        assert m[0, 0] == pytest.approx(0.5)
+        assert m[0, 1] == pytest.approx(0.5)
+
+
+class TestMaxAbsScaler:
+    def test_fit_transform(self):
+        m = Matrix([[1, -4], [-2, 2], [0, 0]])
+        scaler = MaxAbsScaler()
+        results = scaler.fit_transform(m)
+        assert scaler.max_abs == [2.0, 4.0]
+        assert results == Matrix([[0.5, -1], [-1, 0.5], [0, 0]])
+        assert scaler.inverse_transform(results) == m
+
+        scaler.partial_fit(Matrix([[8.0, 1.0]]))
+        assert scaler.max_abs == [8.0, 4.0]
+        with pytest.raises(RuntimeError, match="Scaler must be fitted first"):
+            MaxAbsScaler().transform(m)
+
+
+class TestRobustScaler:
+    def test_fit_transform(self):
+        # An outlier in column 0 does not move the median or the IQR
+        m = Matrix([[1, 1], [2, 2], [3, 3], [4, 4], [1000, 5]])
+        scaler = RobustScaler()
+        results = scaler.fit_transform(m)
+        assert scaler.centers == [3.0, 3.0]
+        assert scaler.scales == [2.0, 2.0]
+        assert results[2, 0] == 0.0
+        assert results[0, 1] == -1.0
+        assert scaler.inverse_transform(results)[4, 0] == pytest.approx(1000.0)
+
+        scaler = RobustScaler(with_centering=False)
+        scaler.fit(m)
+        assert scaler.centers == [0.0, 0.0]
+        with pytest.raises(ValueError):
+            RobustScaler(quantile_range=(75.0, 25.0))
+
+    def test_partial_fit(self):
+        rows = [[float(i), float(i % 7)] for i in range(150)]
+        full = RobustScaler().fit(Matrix(rows))
+        scaler = RobustScaler()
+        for start in range(0, 150, 50):
+            scaler.partial_fit(Matrix(rows[start:start + 50]))
+        assert scaler.n_samples_seen == 150
+        assert scaler.centers == full.centers
+        assert scaler.scales == full.scales
+        with pytest.raises(ValueError):
+            scaler.partial_fit(Matrix([[1.0]]))
+
+
+class TestPCA:
+    # Points along (1, 1) with a small alternating offset across it and a constant third feature
+    rows = [[t + 0.1 * (-1) ** t, t - 0.1 * (-1) ** t, 3.0] for t in range(-10, 11)]
+
+    def test_fit_transform(self):
+        m = Matrix(self.rows)
+        pca = PCA(2, svd_solver="full")
+        results = pca.fit_transform(m)
+        assert (results.rows, results.cols) == (21, 2)
+        assert pca.components[0, 0] == pytest.approx(2 ** -0.5)
+        assert pca.components[0, 1] == pytest.approx(2 ** -0.5)
+        assert pca.components[0, 2] == pytest.approx(0.0, abs=1e-12)
+        assert pca.explained_variance_ratio[0] > 0.99
+        assert sum(pca.explained_variance_ratio) == pytest.approx(1.0)
+        assert results[20, 0] - results[0, 0] == pytest.approx(20 * 2 ** 0.5)
+
+        # Two components hold all the variance, so the inverse is exact
+        restored = pca.inverse_transform(results)
+        assert restored[3, 1] == pytest.approx(m[3, 1])
+        assert restored[3, 2] == pytest.approx(3.0)
+
+        randomized = PCA(2, svd_solver="randomized").fit(m)
+        assert randomized.explained_variance == pytest.approx(pca.explained_variance)
+
+        with pytest.raises(ValueError):
+            PCA(4).fit(m)
+        with pytest.raises(ValueError):
+            PCA(1, svd_solver="arpack")
+        with pytest.raises(RuntimeError, match="PCA must be fitted first"):
+            PCA(1).transform(m)
+
+    def test_partial_fit(self):
+        full = PCA(2).fit(Matrix(self.rows))
+        pca = PCA(2)
+        for start in range(0, 21, 7):
+            pca.partial_fit(Matrix(self.rows[start:start + 7]))
+        assert pca.n_samples_seen == 21
+        assert pca.mean == pytest.approx(full.mean)
+        assert pca.explained_variance == pytest.approx(full.explained_variance)
+        assert pca.components[0, 0] == pytest.approx(full.components[0, 0])
+        with pytest.raises(ValueError):
+            PCA(2).partial_fit(Matrix([[1.0, 2.0, 3.0]]))
+
+
+class TestPolynomialFeatures:
+    def test_fit_transform(self):
+        m = Matrix([[2, 3], [1, -1]])
+        poly = PolynomialFeatures(degree=2)
+        results = poly.fit_transform(m)
+        assert poly.n_output_features == 6
+        assert [results[0, c] for c in range(6)] == [1.0, 2.0, 3.0, 4.0, 6.0, 9.0]
+        assert [results[1, c] for c in range(6)] == [1.0, 1.0, -1.0, 1.0, -1.0, 1.0]
+        assert [poly.powers[4, c] for c in range(2)] == [1.0, 1.0]
+        assert poly.inverse_transform(results) == m
+
+        interactions = PolynomialFeatures(degree=3, interaction_only=True, include_bias=False)
+        results = interactions.fit_transform(Matrix([[2, 3, 5]]))
+        assert [results[0, c] for c in range(7)] == [2.0, 3.0, 5.0, 6.0, 10.0, 15.0, 30.0]
+
+        expansion = poly.expand(m)
+        assert expansion.shape == (2, 6)
+        assert expansion.to_dense() == poly.transform(m)
+        with pytest.raises(ValueError):
+            poly.transform(Matrix([[1, 2, 3]]))
+        with pytest.raises(ValueError):
+            PolynomialFeatures(degree=0)
+
+class TestFeatureHasher:
+    def test_transform(self):
+        df = DataFrame()
+        df.add_column("city", ["paris", "rome", "paris"])
+        df.add_column("count", [2.0, 0.0, 3.0])
+        df.add_column("text", ["The cat", "a dog", "the CAT the"])
+
+        hasher = FeatureHasher(n_features=64, alternate_sign=False)
+        assert hasher.n_features == 64
+        hashed = hasher.transform(df, columns=["city", "count"], text_columns=["text"])
+        assert hashed.shape == (3, 64)
+        dense = hashed.to_dense()
+        assert [sum(dense[r, c] for c in range(64)) for r in range(3)] == [5.0, 3.0, 7.0]
+
+        # Equal values hash to the same columns in any row
+        same = FeatureHasher(n_features=64, alternate_sign=False).transform(df, columns=["city"])
+        assert same.to_dense()[0] == same.to_dense()[2]
+        assert hashed.nnz <= 10
+
+        with pytest.raises(ValueError):
+            hasher.transform(df, columns=["missing"])
+        with pytest.raises(ValueError):
+            FeatureHasher(n_features=0)
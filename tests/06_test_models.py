@@ -7,6 +7,7 @@ Full-coverage test suite for:
   - daedalus/models/logistic_regression.py  (LogisticRegression wrapper)
   - daedalus/models/knn.py                  (KNN wrapper)
   - daedalus/models/neural_network.py       (NeuralNetwork wrapper)
+  - daedalus/models/pipeline.py             (Pipeline wrapper)
 
 Run:
     pytest tests/06_test_models.py
@@ -20,8 +21,9 @@ from __future__ import annotations
 import os
 import pytest
 import numpy as np
-from daedalus import Matrix
-from daedalus.models import Model, LinearRegression, LogisticRegression, KNN, NeuralNetwork
+from daedalus import Matrix, SparseMatrix
+from daedalus.models import Model, LinearRegression, LogisticRegression, KNN, NeuralNetwork, Pipeline
+from daedalus.preprocessing import StandardScaler, MinMaxScaler, PCA, PolynomialFeatures
 
 # ---------------------------------------------------------------------------
 # Helpers
@@ -308,6 +310,25 @@ class TestLinearRegression:
                 f"Row {i} prediction {preds(i, 0):.4f} too far from 7.0"
             )
 
+    def test_fit_sparse(self):
+        X, y = make_multifeature_dataset(n=80)
+        dense = LinearRegression(learning_rate=0.01)
+        dense.fit(X, y, epochs=300)
+        sparse = LinearRegression(learning_rate=0.01)
+        sparse.fit(SparseMatrix.from_dense(X), y, epochs=300)
+        np.testing.assert_allclose(sparse.predict(SparseMatrix.from_dense(X)).to_numpy(),
+                                   dense.predict(X).to_numpy(), rtol=1e-9, atol=1e-9)
+
+    def test_fit_polynomial_expansion(self):
+        X, y = make_multifeature_dataset(n=80)
+        poly = PolynomialFeatures(degree=2).fit(X)
+        dense = LinearRegression(learning_rate=0.001)
+        dense.fit(poly.transform(X), y, epochs=200)
+        streamed = LinearRegression(learning_rate=0.001)
+        streamed.fit(poly.expand(X), y, epochs=200)
+        np.testing.assert_allclose(streamed.predict(poly.expand(X)).to_numpy(),
+                                   dense.predict(poly.transform(X)).to_numpy(), rtol=1e-9, atol=1e-9)
+
     def test_save(self, tmp_path):
         X, y = make_simple_dataset()
         model = LinearRegression(learning_rate=0.05)
@@ -523,6 +544,17 @@ class TestLogisticRegression:
         for i in range(proba.rows):
             assert 0.0 <= proba(i, 0) <= 1.0
 
+    def test_fit_sparse(self):
+        X, y = make_multifeature_binary_dataset(n=100, seed=6)
+        dense = LogisticRegression(learning_rate=0.1)
+        dense.fit(X, y, epochs=200)
+        sparse = LogisticRegression(learning_rate=0.1)
+        sparse.fit(SparseMatrix.from_dense(X), y, epochs=200)
+        X_sparse = SparseMatrix.from_dense(X)
+        np.testing.assert_allclose(sparse.predict_proba(X_sparse).to_numpy(),
+                                   dense.predict_proba(X).to_numpy(), rtol=1e-9, atol=1e-9)
+        assert sparse.predict(X_sparse) == dense.predict(X)
+
     def test_save_model(self, tmp_path):
         X, y = make_binary_dataset()
         model = LogisticRegression(learning_rate=0.5)
@@ -782,3 +814,38 @@ class TestNeuralNetwork:
         assert preds.rows == X.rows
         for i in range(X.rows):
             assert abs(preds(i, 0) - X(i, 0)) < 1e-12
+
+
+class TestPipeline:
+    def test_fused_linear(self):
+        X, y = make_multifeature_dataset(n=80)
+        scaler, pca, model = StandardScaler(), PCA(2), LinearRegression(learning_rate=0.05)
+        pipe = Pipeline([scaler, pca], model)
+        pipe.fit(X, y)
+        assert pipe.is_fused
+        # The fused single pass equals running the fitted stages one after another
+        expected = model.predict(pca.transform(scaler.transform(X)))
+        np.testing.assert_allclose(pipe.predict(X).to_numpy(), expected.to_numpy(), rtol=1e-9, atol=1e-9)
+
+    def test_fused_logistic(self):
+        X, y = make_multifeature_binary_dataset(n=100, seed=6)
+        scaler, model = MinMaxScaler(), LogisticRegression(learning_rate=0.5)
+        pipe = Pipeline([scaler], model)
+        pipe.fit(X, y)
+        assert pipe.is_fused
+        Z = scaler.transform(X)
+        np.testing.assert_allclose(pipe.predict_proba(X).to_numpy(), model.predict_proba(Z).to_numpy(),
+                                   rtol=1e-9, atol=1e-12)
+        assert pipe.predict(X) == model.predict(Z)
+
+    def test_unfused_stages(self):
+        X, y = make_multifeature_dataset(n=80)
+        scaler, poly, model = StandardScaler(), PolynomialFeatures(2), LinearRegression(learning_rate=0.01)
+        pipe = Pipeline([scaler, poly], model)
+        pipe.fit(X, y)
+        assert not pipe.is_fused
+        expected = model.predict(poly.transform(scaler.transform(X)))
+        np.testing.assert_allclose(pipe.predict(X).to_numpy(), expected.to_numpy(), rtol=1e-12, atol=1e-12)
+        with pytest.raises(RuntimeError):
+            pipe.predict_proba(X)
+
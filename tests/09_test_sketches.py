@@ -0,0 +1,132 @@
+"""
+09_test_sketches.py
+=================
+Full-coverage test suite for the sketch Python wrapper classes (daedalus/_core/sketches.py).
+
+Run:
+    pytest tests/09_test_sketches.py
+
+    or run all tests by
+
+    pytest
+"""
+
+from __future__ import annotations
+import math
+import pickle
+import random
+import pytest
+from daedalus import DataFrame, Matrix, KLLSketch, HyperLogLog, read_csv
+
+class TestKLLSketch:
+    def test_empty(self):
+        s = KLLSketch()
+        assert len(s) == 0
+        assert s.k == 200
+        assert math.isnan(s.quantile(0.5))
+
+        with pytest.raises(ValueError):
+            KLLSketch(k=2)
+
+    def test_quantiles(self):
+        values = list(range(100_000))
+        random.Random(0).shuffle(values)
+        s = KLLSketch().update([float(v) for v in values])
+
+        assert len(s) == 100_000
+        assert s.min() == 0.0
+        assert s.max() == 99_999.0
+        assert s.quantile(0.0) == 0.0
+        assert s.quantile(1.0) == 99_999.0
+        for q in (0.1, 0.5, 0.9):
+            assert abs(s.quantile(q) - q * 100_000) < 2_000
+        assert len(s.quantile([0.25, 0.75])) == 2
+        assert s.rank(50_000.0) == pytest.approx(0.5, abs=0.02)
+
+        with pytest.raises(ValueError):
+            s.quantile(1.5)
+
+    def test_merge(self):
+        a = KLLSketch().update([float(v) for v in range(0, 50_000)])
+        b = KLLSketch().update([float(v) for v in range(50_000, 100_000)])
+        a.merge(b)
+        assert len(a) == 100_000
+        assert abs(a.quantile(0.5) - 50_000) < 2_000
+
+        with pytest.raises(ValueError):
+            a.merge(KLLSketch(k=100))
+
+    def test_serialize(self):
+        s = KLLSketch().update([float(v) for v in range(10_000)])
+        restored = KLLSketch.from_bytes(s.to_bytes())
+        assert len(restored) == len(s)
+        assert restored.quantile(0.5) == s.quantile(0.5)
+
+        restored = pickle.loads(pickle.dumps(s))
+        assert restored.quantile(0.9) == s.quantile(0.9)
+
+        with pytest.raises(ValueError):
+            KLLSketch.from_bytes(b"not a sketch")
+
+
+class TestHyperLogLog:
+    def test_estimate(self):
+        h = HyperLogLog()
+        assert h.precision == 14
+        assert h.estimate() == 0.0
+
+        h.update([i % 1_000 for i in range(10_000)])
+        assert h.estimate() == pytest.approx(1_000, rel=0.05)
+
+        h = HyperLogLog().update(["a", "b", "a", "c"])
+        assert round(h.estimate()) == 3
+
+        with pytest.raises(ValueError):
+            HyperLogLog(precision=30)
+
+    def test_merge_and_serialize(self):
+        a = HyperLogLog().update(list(range(0, 5_000)))
+        b = HyperLogLog().update(list(range(2_500, 7_500)))
+        a.merge(b)
+        assert a.estimate() == pytest.approx(7_500, rel=0.05)
+
+        restored = HyperLogLog.from_bytes(a.to_bytes())
+        assert restored.estimate() == a.estimate()
+        assert pickle.loads(pickle.dumps(a)).estimate() == a.estimate()
+
+        with pytest.raises(ValueError):
+            a.merge(HyperLogLog(precision=10))
+
+
+class TestColumnSketches:
+    def test_dataframe_sketches(self):
+        df = DataFrame()
+        df.add_column("x", [float(i) for i in range(20_000)])
+        df.add_column("cat", [f"c{i % 50}" for i in range(20_000)])
+
+        assert abs(df.quantile_sketch("x").quantile(0.5) - 10_000) < 500
+        assert df.distinct_sketch("cat").estimate() == pytest.approx(50, rel=0.05)
+        assert df.distinct_sketch("x").estimate() == pytest.approx(20_000, rel=0.05)
+
+        with pytest.raises(ValueError):
+            df.quantile_sketch("cat")
+        with pytest.raises(ValueError):
+            df.quantile_sketch("ghost")
+
+    def test_distinct_sketch_skips_nulls(self, tmp_path):
+        path = tmp_path / "nulls.csv"
+        path.write_text("f,i,m\n0,0,a\n1,1,1\n2,2,b\n,,\n")
+        df = read_csv(str(path), dtype={"f": "float64", "i": "int64", "m": "mixed"})
+        assert df.null_count("f") == 1 and df.null_count("m") == 1
+        assert round(df.distinct_sketch("f").estimate()) == 3
+        assert round(df.distinct_sketch("i").estimate()) == 3
+        assert round(df.distinct_sketch("m").estimate()) == 3
+
+    def test_matrix_sketches(self):
+        X = Matrix([[float(i), float(i % 10)] for i in range(10_000)])
+        quantiles = X.quantile_sketches()
+        assert len(quantiles) == 2
+        assert abs(quantiles[0].quantile(0.5) - 5_000) < 300
+
+        distinct = X.distinct_sketches()
+        assert round(distinct[1].estimate()) == 10
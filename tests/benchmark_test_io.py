@@ -0,0 +1,142 @@
+import gzip
+import os
+import random
+import numpy as np
+import pytest
+from daedalus import read_csv, read_csv_matrix, read_dcol, load_npy, Matrix
+
+pytestmark = pytest.mark.benchmark_test
+
+def write_numeric_csv(path, rows, cols=10):
+    """Helper to write a CSV file of random floats and return its size in bytes."""
+    rng = random.Random(0)
+    with open(path, "w") as f:
+        f.write(",".join(f"c{i}" for i in range(cols)) + "\n")
+        for _ in range(rows):
+            f.write(",".join(f"{rng.random() * 1000:.6f}" for _ in range(cols)) + "\n")
+    return os.path.getsize(path)
+
+def write_text_csv(path, rows, quoted):
+    """Helper to write a CSV file of short text fields, optionally quoted, and return its size in bytes."""
+    rng = random.Random(0)
+    wrap = (lambda v: f'"{v}, x"') if quoted else (lambda v: f"{v} x")
+    with open(path, "w") as f:
+        f.write("id,a,b,c\n")
+        for i in range(rows):
+            f.write(",".join([str(i)] + [wrap(f"w{rng.randrange(1000)}") for _ in range(3)]) + "\n")
+    return os.path.getsize(path)
+
+@pytest.fixture(scope="module")
+def wide_csv(tmp_path_factory):
+    path = tmp_path_factory.mktemp("csv") / "wide.csv"
+    write_numeric_csv(path, 20_000, cols=300)
+    return str(path)
+
+@pytest.fixture(scope="module")
+def numeric_csv(tmp_path_factory):
+    path = tmp_path_factory.mktemp("csv") / "numeric.csv"
+    size = write_numeric_csv(path, 1_000_000)
+    return str(path), size
+
+# --- Benchmarks ---
+
+@pytest.mark.parametrize("num_threads", [1, 2, 4, 0])
+def test_benchmark_read_csv_throughput(benchmark, numeric_csv, num_threads):
+    """Benchmarks chunked parallel CSV ingestion and reports throughput in GB/s."""
+    path, size = numeric_csv
+
+    df = benchmark(lambda: read_csv(path, num_threads=num_threads))
+
+    benchmark.extra_info["GB/s"] = size / benchmark.stats.stats.mean / 1e9
+    assert df.rows == 1_000_000
+
+
+@pytest.mark.parametrize("quoted", [False, True])
+def test_benchmark_read_csv_quoted(benchmark, tmp_path_factory, quoted):
+    """Compares throughput of quoted and unquoted text fields (quote masking cost)."""
+    path = tmp_path_factory.mktemp("csv") / "text.csv"
+    size = write_text_csv(path, 500_000, quoted)
+
+    df = benchmark(lambda: read_csv(str(path), num_threads=1))
+
+    benchmark.extra_info["GB/s"] = size / benchmark.stats.stats.mean / 1e9
+    assert df.rows == 500_000
+
+
+@pytest.mark.parametrize("n_cols", [300, 10])
+def test_benchmark_read_csv_usecols(benchmark, wide_csv, n_cols):
+    """Benchmarks reading a subset of a 300-column file (fields outside usecols are skipped)."""
+    usecols = [f"c{i}" for i in range(0, 300, 300 // n_cols)]
+
+    df = benchmark(lambda: read_csv(wide_csv, usecols=usecols))
+
+    assert df.cols == n_cols
+
+
+@pytest.mark.parametrize("fmt", ["csv", "gzip"])
+def test_benchmark_read_csv_gzip(benchmark, numeric_csv, tmp_path_factory, fmt):
+    """Compares reading a plain CSV with reading its gzip-compressed copy (decompression cost)."""
+    path, _ = numeric_csv
+    if fmt == "gzip":
+        packed = tmp_path_factory.mktemp("gz") / "numeric.csv.gz"
+        with open(path, "rb") as src, gzip.open(packed, "wb", compresslevel=6) as dst:
+            dst.write(src.read())
+        path = str(packed)
+
+    df = benchmark(lambda: read_csv(path))
+
+    assert df.rows == 1_000_000
+
+
+@pytest.mark.parametrize("loader", ["numpy", "native"])
+def test_benchmark_load_npy(benchmark, tmp_path_factory, loader):
+    """Compares np.load plus the Matrix copy with the native mmap-based .npy loader."""
+    path = str(tmp_path_factory.mktemp("npy") / "X.npy")
+    np.save(path, np.random.default_rng(0).random((2_000_000, 10)))
+
+    m = benchmark(lambda: load_npy(path) if loader == "native" else Matrix(np.load(path)))
+
+    assert m.shape == (2_000_000, 10)
+
+
+@pytest.mark.parametrize("direct", [False, True])
+def test_benchmark_read_csv_matrix(benchmark, numeric_csv, direct):
+    """Compares read_csv followed by to_matrix with parsing straight into X and y."""
+    path, _ = numeric_csv
+    features = [f"c{i}" for i in range(9)]
+
+    def load():
+        if direct:
+            return read_csv_matrix(path, features, target_column="c9")
+        df = read_csv(path)
+        return df.to_matrix(features), df.to_matrix(["c9"])
+
+    X, y = benchmark(load)
+
+    assert X.shape == (1_000_000, 9) and y.shape == (1_000_000, 1)
+
+
+@pytest.mark.parametrize("fmt", ["csv", "dcol-lz4", "dcol-none"])
+def test_benchmark_startup_load(benchmark, numeric_csv, tmp_path_factory, fmt):
+    """Compares loading the same table from CSV and from the columnar format."""
+    path, _ = numeric_csv
+    if fmt != "csv":
+        dcol = str(tmp_path_factory.mktemp("dcol") / "numeric.dcol")
+        read_csv(path).save(dcol, compression=fmt.split("-")[1])
+        path = dcol
+
+    df = benchmark(lambda: read_csv(path) if fmt == "csv" else read_dcol(path))
+
+    assert df.rows == 1_000_000
+
+
+@pytest.mark.parametrize("num_threads", [1, 0])
+def test_benchmark_matrix_to_csv(benchmark, tmp_path_factory, num_threads):
+    """Benchmarks writing a 1M x 10 prediction matrix and reports throughput in MB/s."""
+    rng = random.Random(0)
+    m = Matrix([[rng.random() * 1000 for _ in range(10)] for _ in range(1_000_000)])
+    path = str(tmp_path_factory.mktemp("out") / "predictions.csv")
+
+    benchmark(lambda: m.to_csv(path, num_threads=num_threads))
+
+    benchmark.extra_info["MB/s"] = os.path.getsize(path) / benchmark.stats.stats.mean / 1e6
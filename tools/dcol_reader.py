@@ -0,0 +1,182 @@
+"""
+Dependency-free reader for Daedalus columnar (.dcol) files, for debugging.
+
+The layout is documented in include/daedalus/core/Columnar.h. This module does
+not import the compiled extension, so it can inspect files on any machine:
+
+    python tools/dcol_reader.py data.dcol            # schema, chunk statistics and first rows
+    python tools/dcol_reader.py data.dcol --rows 20
+"""
+from __future__ import annotations
+import struct
+import sys
+
+MAGIC = b"DCOL0001"
+DTYPES = ["float64", "int32", "string", "mixed", "int64", "bool", "category"]
+FIXED = {"float64": ("d", 8), "int32": ("i", 4), "int64": ("q", 8), "bool": ("B", 1), "category": ("i", 4)}
+
+
+class _Cursor:
+    def __init__(self, data: bytes, pos: int = 0) -> None:
+        self.data = data
+        self.pos = pos
+
+    def get(self, fmt: str):
+        value = struct.unpack_from("<" + fmt, self.data, self.pos)[0]
+        self.pos += struct.calcsize("<" + fmt)
+        return value
+
+    def get_string(self) -> str:
+        n = self.get("I")
+        value = self.data[self.pos:self.pos + n].decode("utf-8")
+        self.pos += n
+        return value
+
+    def get_buffer(self) -> dict:
+        return {"codec": self.get("B"), "offset": self.get("Q"), "stored_size": self.get("Q"), "raw_size": self.get("Q")}
+
+
+def lz4_decompress(src: bytes, raw_size: int) -> bytes:
+    """Decodes one LZ4 block."""
+    out = bytearray()
+    i = 0
+    while i < len(src):
+        token = src[i]
+        i += 1
+        literals = token >> 4
+        if literals == 15:
+            while True:
+                b = src[i]
+                i += 1
+                literals += b
+                if b != 255:
+                    break
+        out += src[i:i + literals]
+        i += literals
+        if i >= len(src):
+            break
+        offset = src[i] | (src[i + 1] << 8)
+        i += 2
+        length = token & 15
+        if length == 15:
+            while True:
+                b = src[i]
+                i += 1
+                length += b
+                if b != 255:
+                    break
+        length += 4
+        start = len(out) - offset
+        for k in range(length):
+            out.append(out[start + k])
+    if len(out) != raw_size:
+        raise ValueError("Corrupt LZ4 block")
+    return bytes(out)
+
+
+def read_footer(path: str) -> dict:
+    """Returns the schema, chunk directory and statistics of a .dcol file."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < 24 or data[:8] != MAGIC or data[-8:] != MAGIC:
+        raise ValueError(f"Not a .dcol file: {path}")
+    footer_size = struct.unpack_from("<Q", data, len(data) - 16)[0]
+    c = _Cursor(data, len(data) - 16 - footer_size)
+    footer = {"version": c.get("I"), "rows": c.get("Q"), "chunk_rows": c.get("Q"), "columns": []}
+    for _ in range(c.get("I")):
+        column = {"name": c.get_string(), "dtype": DTYPES[c.get("B")]}
+        column["dictionary"] = [c.get_string() for _ in range(c.get("I"))]
+        column["chunks"] = []
+        for _ in range(c.get("I")):
+            chunk = {"rows": c.get("Q"), "values": c.get_buffer(), "nulls": c.get_buffer()}
+            chunk["null_count"] = c.get("Q")
+            has_range = c.get("B")
+            lo, hi = c.get("d"), c.get("d")
+            chunk["range"] = (lo, hi) if has_range else None
+            column["chunks"].append(chunk)
+        footer["columns"].append(column)
+    return footer
+
+
+def _decode(data: bytes, buffer: dict, width: int) -> bytes:
+    stored = data[buffer["offset"]:buffer["offset"] + buffer["stored_size"]]
+    if buffer["codec"] == 0:
+        return stored
+    raw = lz4_decompress(stored, buffer["raw_size"])
+    if buffer["codec"] == 1:
+        return raw
+    n = len(raw) // width
+    out = bytearray(len(raw))
+    for b in range(width):
+        out[b::width] = raw[b * n:(b + 1) * n]
+    return bytes(out)
+
+
+def _chunk_values(data: bytes, column: dict, chunk: dict) -> list:
+    dtype, rows = column["dtype"], chunk["rows"]
+    if dtype in FIXED:
+        fmt, width = FIXED[dtype]
+        values = list(struct.unpack(f"<{rows}{fmt}", _decode(data, chunk["values"], width)))
+        if dtype == "category":
+            values = [column["dictionary"][v] for v in values]
+    else:
+        raw = _decode(data, chunk["values"], 1)
+        offsets = struct.unpack_from(f"<{rows + 1}Q", raw)
+        payload = raw[(rows + 1) * 8:]
+        values = []
+        for i in range(rows):
+            item = payload[offsets[i]:offsets[i + 1]]
+            if dtype == "string":
+                values.append(item.decode("utf-8"))
+            elif item[0] == 0:
+                values.append(struct.unpack("<d", item[1:])[0])
+            elif item[0] == 1:
+                values.append(struct.unpack("<i", item[1:])[0])
+            else:
+                values.append(item[1:].decode("utf-8"))
+    if chunk["nulls"]["raw_size"]:
+        words = struct.unpack(f"<{chunk['nulls']['raw_size'] // 8}Q", _decode(data, chunk["nulls"], 1))
+        for i in range(rows):
+            if (words[i // 64] >> (i % 64)) & 1:
+                values[i] = None
+    return values
+
+
+def read_columns(path: str, columns: list[str] | None = None) -> dict[str, list]:
+    """Decodes whole columns into Python lists (nulls become None)."""
+    footer = read_footer(path)
+    with open(path, "rb") as f:
+        data = f.read()
+    result = {}
+    for column in footer["columns"]:
+        if columns is not None and column["name"] not in columns:
+            continue
+        values = []
+        for chunk in column["chunks"]:
+            values.extend(_chunk_values(data, column, chunk))
+        result[column["name"]] = values
+    return result
+
+
+def main(argv: list[str]) -> None:
+    if not argv or argv[0] in ("-h", "--help"):
+        print(__doc__)
+        return
+    n_rows = int(argv[argv.index("--rows") + 1]) if "--rows" in argv else 5
+    footer = read_footer(argv[0])
+    print(f"{argv[0]}: {footer['rows']} rows, {len(footer['columns'])} columns, chunk_rows={footer['chunk_rows']}")
+    for column in footer["columns"]:
+        chunks = column["chunks"]
+        stored = sum(c["values"]["stored_size"] + c["nulls"]["stored_size"] for c in chunks)
+        nulls = sum(c["null_count"] for c in chunks)
+        print(f"  {column['name']}: {column['dtype']}, {len(chunks)} chunks, {stored} bytes stored, {nulls} nulls")
+        for k, chunk in enumerate(chunks):
+            if chunk["range"] is not None:
+                print(f"    chunk {k}: rows={chunk['rows']} min={chunk['range'][0]} max={chunk['range'][1]}")
+    data = read_columns(argv[0])
+    for i in range(min(n_rows, footer["rows"])):
+        print("  " + ", ".join(f"{name}={values[i]!r}" for name, values in data.items()))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])